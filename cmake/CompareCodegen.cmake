@@ -0,0 +1,93 @@
+# Compiles SOURCE to assembly and checks that every s2d_codegen_<case>_<units> function
+# has the same instructions as s2d_codegen_<case>_float, labels aside. The order may differ,
+# as operators on class types are calls whose operands the compiler may evaluate either way
+# round, but the mix and number of instructions must match.
+# Run with cmake -DCOMPILER=<c++> -DSOURCE=<cpp> -DINCLUDE_DIR=<dir> -DOUTPUT=<asm> -P CompareCodegen.cmake
+
+cmake_minimum_required(VERSION 3.16)
+
+foreach(var COMPILER SOURCE INCLUDE_DIR OUTPUT)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "CompareCodegen.cmake needs -D${var}=...")
+    endif()
+endforeach()
+
+# identical code folding would merge the functions and leave nothing to compare
+set(FLAGS -std=c++20 -O2 -S)
+if(COMPILER_ID STREQUAL "GNU")
+    list(APPEND FLAGS -fno-ipa-icf)
+endif()
+
+execute_process(
+    COMMAND ${COMPILER} ${FLAGS} -I${INCLUDE_DIR} ${SOURCE} -o ${OUTPUT}
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Compiling ${SOURCE} with ${COMPILER} failed (${result}):\n${errors}")
+endif()
+
+file(STRINGS ${OUTPUT} lines)
+set(current "")
+set(cases "")
+set(functions "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^_?(s2d_codegen_[a-z_]+):")
+        set(current ${CMAKE_MATCH_1})
+        set(body_${current} "")
+        set(ops_${current} "")
+        list(APPEND functions ${current})
+        if(current MATCHES "^(s2d_codegen_[a-z_]+)_float$")
+            list(APPEND cases ${CMAKE_MATCH_1})
+        endif()
+    elseif(current AND line MATCHES "^[ \t]+\\.cfi_endproc")
+        set(current "")
+    elseif(current AND line MATCHES "^[ \t]+[a-z]")
+        # directives and labels differ between functions, instructions must not
+        string(STRIP "${line}" line)
+        string(REGEX REPLACE "[ \t]+" " " line "${line}")
+        string(REGEX REPLACE "\\.?L[A-Za-z]*[0-9_]+" ".L" line "${line}")
+        list(APPEND body_${current} "${line}")
+        string(REGEX REPLACE " .*" "" op "${line}")
+        list(APPEND ops_${current} ${op})
+    endif()
+endforeach()
+
+if(NOT cases)
+    message(FATAL_ERROR "No s2d_codegen_*_float functions found in ${OUTPUT}")
+endif()
+
+set(failed FALSE)
+foreach(function IN LISTS functions)
+    if(NOT function MATCHES "^(s2d_codegen_[a-z_]+)_([a-z]+)$" OR CMAKE_MATCH_2 STREQUAL "float")
+        continue()
+    endif()
+    set(case ${CMAKE_MATCH_1})
+    if(NOT case IN_LIST cases)
+        message(SEND_ERROR "${function} has no ${case}_float to compare against")
+        set(failed TRUE)
+        continue()
+    endif()
+
+    list(LENGTH body_${case}_float expected)
+    list(LENGTH body_${function} actual)
+    set(want_ops ${ops_${case}_float})
+    set(got_ops ${ops_${function}})
+    list(SORT want_ops)
+    list(SORT got_ops)
+    if("${body_${function}}" STREQUAL "${body_${case}_float}")
+        message(STATUS "${function}: ${actual} instructions, same as float")
+    elseif("${got_ops}" STREQUAL "${want_ops}")
+        message(STATUS "${function}: ${actual} instructions, same as float in another order")
+    else()
+        string(REPLACE ";" "\n    " want "${body_${case}_float}")
+        string(REPLACE ";" "\n    " got "${body_${function}}")
+        message(SEND_ERROR "${function} (${actual} instructions) differs from "
+            "${case}_float (${expected} instructions)\nfloat:\n    ${want}\n${function}:\n    ${got}")
+        set(failed TRUE)
+    endif()
+endforeach()
+
+if(failed)
+    message(FATAL_ERROR "Unit types do not compile to the same code as float")
+endif()
@@ -0,0 +1,597 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "S2DInlineVec.h"
+#include "S2DCallback.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Rect2;
+
+    /**
+     * @brief Dynamic bounding volume tree broadphase over Rect2 bounds
+     * @details Every object (proxy) is a leaf holding a fattened copy of its Rect2 bounds, and
+     * every internal node holds the union of its two children. Insertion picks the sibling with
+     * the surface area heuristic and the tree is kept balanced with AVL style rotations, so
+     * queries visit O(log n) nodes.
+     *
+     * The fattened bounds let an object move within its margin without touching the tree,
+     * moveProxy only reinserts the leaf once the object escapes them.
+     *
+     * All nodes live in a single contiguous pool and are addressed by index, freed nodes are
+     * recycled through a free list, so the tree never allocates per object once the pool has
+     * grown. Proxy ids stay valid until the proxy is destroyed
+     * @tparam T Underlying data type of the coordinates
+     * @tparam Data the user data stored with each proxy
+    */
+    template<typename T, typename Data = size_t>
+    class AABBTree2
+    {
+    public:
+
+        /**
+         * @brief index of a node in the pool, also used as the proxy id
+        */
+        using NodeId = std::uint32_t;
+
+        /**
+         * @brief the id that refers to no node
+        */
+        static constexpr NodeId nullNode = std::numeric_limits<NodeId>::max();
+
+        /**
+         * @brief Constructs an empty AABBTree2
+         * @param margin how far the stored bounds are fattened in every direction
+         * @param displacementMultiplier how far ahead the stored bounds are extended along the
+         * displacement passed to moveProxy
+        */
+        explicit AABBTree2(const T& margin = (T)0.1, const T& displacementMultiplier = (T)4.0)
+            : margin(margin), displacementMultiplier(displacementMultiplier) {}
+
+        /**
+         * @brief Inserts a new proxy into the tree
+         * @param aabb the tight bounds of the object
+         * @param data the user data to store with the proxy
+         * @return the id of the new proxy
+        */
+        NodeId createProxy(const Rect2<T>& aabb, const Data& data = Data()) {
+            NodeId proxy = allocateNode();
+            nodes[proxy].aabb = fatten(aabb);
+            nodes[proxy].data = data;
+            nodes[proxy].height = 0;
+            insertLeaf(proxy);
+            proxyCount++;
+            return proxy;
+        }
+
+        /**
+         * @brief Removes a proxy from the tree, the id may be reused by later proxies
+         * @param proxy the id of the proxy to remove
+        */
+        void destroyProxy(const NodeId proxy) {
+            if (!isProxy(proxy)) throw std::out_of_range("AABBTree2 proxy does not exist");
+            removeLeaf(proxy);
+            freeNode(proxy);
+            proxyCount--;
+        }
+
+        /**
+         * @brief Updates the bounds of a proxy
+         * @details nothing is changed while the new bounds still fit in the fattened bounds,
+         * otherwise the proxy is reinserted with new fattened bounds, extended along the
+         * displacement so that objects moving steadily are reinserted less often
+         * @param proxy the id of the proxy to move
+         * @param aabb the new tight bounds of the object
+         * @param displacement the expected movement of the object until the next update
+         * @return true if the proxy was reinserted
+        */
+        bool moveProxy(const NodeId proxy, const Rect2<T>& aabb, const Vec2<T>& displacement = Vec2<T>()) {
+            if (!isProxy(proxy)) throw std::out_of_range("AABBTree2 proxy does not exist");
+            if (nodes[proxy].aabb.contains(aabb)) {
+                return false;
+            }
+
+            removeLeaf(proxy);
+
+            Rect2<T> fat = fatten(aabb);
+            T dx = displacement.x * displacementMultiplier;
+            T dy = displacement.y * displacementMultiplier;
+            if (dx < (T)0.0) fat.min.x += dx; else fat.max.x += dx;
+            if (dy < (T)0.0) fat.min.y += dy; else fat.max.y += dy;
+
+            nodes[proxy].aabb = fat;
+            insertLeaf(proxy);
+            return true;
+        }
+
+        /**
+         * @brief Returns the fattened bounds stored for a proxy
+         * @param proxy the id of the proxy
+         * @return the fattened bounds
+        */
+        const Rect2<T>& getFatAABB(const NodeId proxy) const {
+            if (!isProxy(proxy)) throw std::out_of_range("AABBTree2 proxy does not exist");
+            return nodes[proxy].aabb;
+        }
+
+        /**
+         * @brief Access the user data of a proxy
+         * @param proxy the id of the proxy
+         * @return a read only reference to the user data
+        */
+        const Data& getData(const NodeId proxy) const {
+            if (!isProxy(proxy)) throw std::out_of_range("AABBTree2 proxy does not exist");
+            return nodes[proxy].data;
+        }
+
+        /**
+         * @brief Access the user data of a proxy
+         * @param proxy the id of the proxy
+         * @return a read and write reference to the user data
+        */
+        Data& getData(const NodeId proxy) {
+            if (!isProxy(proxy)) throw std::out_of_range("AABBTree2 proxy does not exist");
+            return nodes[proxy].data;
+        }
+
+        /**
+         * @brief Returns the number of proxies in the tree
+         * @return the number of proxies
+        */
+        size_t size() const noexcept {
+            return proxyCount;
+        }
+
+        /**
+         * @brief Checks if the tree holds no proxies
+         * @return true if there are no proxies
+        */
+        bool empty() const noexcept {
+            return proxyCount == 0;
+        }
+
+        /**
+         * @brief Returns the height of the tree, 0 for a single leaf
+         * @return the height of the root, or -1 if the tree is empty
+        */
+        int height() const noexcept {
+            return root == nullNode ? -1 : nodes[root].height;
+        }
+
+        /**
+         * @brief Removes every proxy, keeping the node pool for reuse
+        */
+        void clear() noexcept {
+            nodes.clear();
+            root = nullNode;
+            freeList = nullNode;
+            proxyCount = 0;
+        }
+
+        /**
+         * @brief Reports every proxy whose fattened bounds overlap the region
+         * @param region the region to query
+         * @param callback invoked with the id of each overlapping proxy, may return false to stop the query
+        */
+        template<typename Callback>
+        void query(const Rect2<T>& region, Callback&& callback) const {
+            if (root == nullNode) return;
+
+            InlineVec<NodeId, 64> stack;
+            stack.push_back(root);
+
+            while (!stack.empty()) {
+                NodeId id = stack.back();
+                stack.pop_back();
+
+                const Node& node = nodes[id];
+                if (!node.aabb.intersects(region)) continue;
+
+                if (node.isLeaf()) {
+                    if (!detail::invokeContinue(callback, id)) return;
+                }
+                else {
+                    stack.push_back(node.child1);
+                    stack.push_back(node.child2);
+                }
+            }
+        }
+
+        /**
+         * @brief Reports every pair of proxies whose fattened bounds overlap
+         * @details descends the tree against itself, so subtrees that don't overlap are pruned
+         * in one test instead of once per leaf; each pair is reported once, with the smaller id first
+         * @param callback invoked with the ids of each overlapping pair
+        */
+        template<typename Callback>
+        void queryPairs(Callback&& callback) const {
+            if (root == nullNode) return;
+
+            //a pair of equal ids stands for testing a subtree against itself
+            InlineVec<std::pair<NodeId, NodeId>, 64> stack;
+            stack.push_back({ root, root });
+
+            while (!stack.empty()) {
+                auto [ia, ib] = stack.back();
+                stack.pop_back();
+
+                const Node& a = nodes[ia];
+                if (ia == ib) {
+                    if (!a.isLeaf()) {
+                        stack.push_back({ a.child1, a.child2 });
+                        stack.push_back({ a.child1, a.child1 });
+                        stack.push_back({ a.child2, a.child2 });
+                    }
+                    continue;
+                }
+
+                const Node& b = nodes[ib];
+                if (!a.aabb.intersects(b.aabb)) continue;
+
+                if (a.isLeaf() && b.isLeaf()) {
+                    callback(std::min(ia, ib), std::max(ia, ib));
+                }
+                else if (b.isLeaf() || (!a.isLeaf() && a.height >= b.height)) {
+                    stack.push_back({ a.child1, ib });
+                    stack.push_back({ a.child2, ib });
+                }
+                else {
+                    stack.push_back({ ia, b.child1 });
+                    stack.push_back({ ia, b.child2 });
+                }
+            }
+        }
+
+        /**
+         * @brief Reports every proxy whose fattened bounds are hit by a ray
+         * @details the ray covers origin + direction * t for t in [0, maxFraction]
+         * @param origin the start of the ray
+         * @param direction the direction of the ray, need not be normalized
+         * @param maxFraction how far along direction the ray extends
+         * @param callback invoked with the id of each proxy hit, may return false to stop the query
+        */
+        template<typename Callback>
+        void rayQuery(const Point2<T>& origin, const Vec2<T>& direction, const T& maxFraction, Callback&& callback) const {
+            if (root == nullNode) return;
+
+            InlineVec<NodeId, 64> stack;
+            stack.push_back(root);
+
+            while (!stack.empty()) {
+                NodeId id = stack.back();
+                stack.pop_back();
+
+                const Node& node = nodes[id];
+                if (!node.aabb.intersectsSegment(origin, direction, maxFraction)) continue;
+
+                if (node.isLeaf()) {
+                    if (!detail::invokeContinue(callback, id)) return;
+                }
+                else {
+                    stack.push_back(node.child1);
+                    stack.push_back(node.child2);
+                }
+            }
+        }
+
+        /**
+         * @brief Checks the structure of the tree, parents, heights and bounds
+         * @return true if every internal node is consistent with its children
+        */
+        bool validate() const {
+            if (root == nullNode) return proxyCount == 0;
+            if (nodes[root].parent != nullNode) return false;
+            size_t leaves = 0;
+            return validateNode(root, leaves) && leaves == proxyCount;
+        }
+
+    private:
+
+        /**
+         * @brief a node of the tree, leaves hold proxies, internal nodes hold exactly two children
+        */
+        struct Node {
+            Rect2<T> aabb;
+            Data data = Data();
+
+            /**
+             * @brief the parent of the node, or the next free node while the node is in the free list
+            */
+            NodeId parent = nullNode;
+            NodeId child1 = nullNode;
+            NodeId child2 = nullNode;
+
+            /**
+             * @brief 0 for a leaf, -1 for a free node
+            */
+            int height = -1;
+
+            bool isLeaf() const noexcept {
+                return height == 0;
+            }
+        };
+
+        bool isProxy(const NodeId id) const noexcept {
+            return id < nodes.size() && nodes[id].isLeaf();
+        }
+
+        Rect2<T> fatten(const Rect2<T>& aabb) const noexcept {
+            return Rect2<T>(
+                Point2<T>(aabb.min.x - margin, aabb.min.y - margin),
+                Point2<T>(aabb.max.x + margin, aabb.max.y + margin)
+            );
+        }
+
+        NodeId allocateNode() {
+            if (freeList == nullNode) {
+                if (nodes.size() >= nullNode) throw std::length_error("AABBTree2 node pool is full");
+                nodes.emplace_back();
+                return static_cast<NodeId>(nodes.size() - 1);
+            }
+            NodeId id = freeList;
+            freeList = nodes[id].parent;
+            nodes[id] = Node();
+            return id;
+        }
+
+        void freeNode(const NodeId id) noexcept {
+            nodes[id].parent = freeList;
+            nodes[id].height = -1;
+            freeList = id;
+        }
+
+        /**
+         * @brief inserts a leaf, choosing the sibling that grows the total perimeter the least
+        */
+        void insertLeaf(const NodeId leaf) {
+            if (root == nullNode) {
+                root = leaf;
+                nodes[root].parent = nullNode;
+                return;
+            }
+
+            const Rect2<T> leafAABB = nodes[leaf].aabb;
+            NodeId index = root;
+            while (!nodes[index].isLeaf()) {
+                const Node& node = nodes[index];
+                NodeId child1 = node.child1;
+                NodeId child2 = node.child2;
+
+                T area = node.aabb.perimeter();
+                T combinedArea = node.aabb.combine(leafAABB).perimeter();
+
+                //cost of creating a new parent for this node and the new leaf
+                T cost = combinedArea * (T)2.0;
+
+                //minimum cost of pushing the leaf further down the tree
+                T inheritanceCost = (combinedArea - area) * (T)2.0;
+
+                T cost1 = descendCost(child1, leafAABB) + inheritanceCost;
+                T cost2 = descendCost(child2, leafAABB) + inheritanceCost;
+
+                if (cost < cost1 && cost < cost2) break;
+
+                index = cost1 < cost2 ? child1 : child2;
+            }
+
+            NodeId sibling = index;
+            NodeId oldParent = nodes[sibling].parent;
+            NodeId newParent = allocateNode();
+            nodes[newParent].parent = oldParent;
+            nodes[newParent].aabb = leafAABB.combine(nodes[sibling].aabb);
+            nodes[newParent].height = nodes[sibling].height + 1;
+            nodes[newParent].child1 = sibling;
+            nodes[newParent].child2 = leaf;
+            nodes[sibling].parent = newParent;
+            nodes[leaf].parent = newParent;
+
+            if (oldParent != nullNode) {
+                if (nodes[oldParent].child1 == sibling) {
+                    nodes[oldParent].child1 = newParent;
+                }
+                else {
+                    nodes[oldParent].child2 = newParent;
+                }
+            }
+            else {
+                root = newParent;
+            }
+
+            refit(nodes[leaf].parent);
+        }
+
+        T descendCost(const NodeId child, const Rect2<T>& leafAABB) const noexcept {
+            const Rect2<T> combined = leafAABB.combine(nodes[child].aabb);
+            if (nodes[child].isLeaf()) {
+                return combined.perimeter();
+            }
+            return combined.perimeter() - nodes[child].aabb.perimeter();
+        }
+
+        void removeLeaf(const NodeId leaf) noexcept {
+            if (leaf == root) {
+                root = nullNode;
+                return;
+            }
+
+            NodeId parent = nodes[leaf].parent;
+            NodeId grandParent = nodes[parent].parent;
+            NodeId sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+            if (grandParent != nullNode) {
+                if (nodes[grandParent].child1 == parent) {
+                    nodes[grandParent].child1 = sibling;
+                }
+                else {
+                    nodes[grandParent].child2 = sibling;
+                }
+                nodes[sibling].parent = grandParent;
+                freeNode(parent);
+                refit(grandParent);
+            }
+            else {
+                root = sibling;
+                nodes[sibling].parent = nullNode;
+                freeNode(parent);
+            }
+        }
+
+        /**
+         * @brief walks from index to the root, rebalancing and recomputing bounds and heights
+        */
+        void refit(NodeId index) noexcept {
+            while (index != nullNode) {
+                index = balance(index);
+
+                Node& node = nodes[index];
+                const Node& child1 = nodes[node.child1];
+                const Node& child2 = nodes[node.child2];
+                node.height = 1 + std::max(child1.height, child2.height);
+                node.aabb = child1.aabb.combine(child2.aabb);
+
+                index = node.parent;
+            }
+        }
+
+        /**
+         * @brief performs a left or right rotation if node iA is imbalanced
+         * @return the new root of the subtree
+        */
+        NodeId balance(const NodeId iA) noexcept {
+            Node& A = nodes[iA];
+            if (A.isLeaf() || A.height < 2) {
+                return iA;
+            }
+
+            NodeId iB = A.child1;
+            NodeId iC = A.child2;
+            Node& B = nodes[iB];
+            Node& C = nodes[iC];
+
+            int balanceFactor = C.height - B.height;
+
+            //rotate C up
+            if (balanceFactor > 1) {
+                NodeId iF = C.child1;
+                NodeId iG = C.child2;
+                Node& F = nodes[iF];
+                Node& G = nodes[iG];
+
+                C.child1 = iA;
+                C.parent = A.parent;
+                A.parent = iC;
+                replaceChild(C.parent, iA, iC);
+
+                if (F.height > G.height) {
+                    C.child2 = iF;
+                    A.child2 = iG;
+                    G.parent = iA;
+                    A.aabb = B.aabb.combine(G.aabb);
+                    C.aabb = A.aabb.combine(F.aabb);
+                    A.height = 1 + std::max(B.height, G.height);
+                    C.height = 1 + std::max(A.height, F.height);
+                }
+                else {
+                    C.child2 = iG;
+                    A.child2 = iF;
+                    F.parent = iA;
+                    A.aabb = B.aabb.combine(F.aabb);
+                    C.aabb = A.aabb.combine(G.aabb);
+                    A.height = 1 + std::max(B.height, F.height);
+                    C.height = 1 + std::max(A.height, G.height);
+                }
+                return iC;
+            }
+
+            //rotate B up
+            if (balanceFactor < -1) {
+                NodeId iD = B.child1;
+                NodeId iE = B.child2;
+                Node& D = nodes[iD];
+                Node& E = nodes[iE];
+
+                B.child1 = iA;
+                B.parent = A.parent;
+                A.parent = iB;
+                replaceChild(B.parent, iA, iB);
+
+                if (D.height > E.height) {
+                    B.child2 = iD;
+                    A.child1 = iE;
+                    E.parent = iA;
+                    A.aabb = C.aabb.combine(E.aabb);
+                    B.aabb = A.aabb.combine(D.aabb);
+                    A.height = 1 + std::max(C.height, E.height);
+                    B.height = 1 + std::max(A.height, D.height);
+                }
+                else {
+                    B.child2 = iE;
+                    A.child1 = iD;
+                    D.parent = iA;
+                    A.aabb = C.aabb.combine(D.aabb);
+                    B.aabb = A.aabb.combine(E.aabb);
+                    A.height = 1 + std::max(C.height, D.height);
+                    B.height = 1 + std::max(A.height, E.height);
+                }
+                return iB;
+            }
+
+            return iA;
+        }
+
+        void replaceChild(const NodeId parent, const NodeId oldChild, const NodeId newChild) noexcept {
+            if (parent == nullNode) {
+                root = newChild;
+            }
+            else if (nodes[parent].child1 == oldChild) {
+                nodes[parent].child1 = newChild;
+            }
+            else {
+                nodes[parent].child2 = newChild;
+            }
+        }
+
+        bool validateNode(const NodeId id, size_t& leaves) const {
+            const Node& node = nodes[id];
+            if (node.isLeaf()) {
+                leaves++;
+                return true;
+            }
+            if (node.height < 0) return false;
+
+            const Node& child1 = nodes[node.child1];
+            const Node& child2 = nodes[node.child2];
+            if (child1.parent != id || child2.parent != id) return false;
+            if (node.height != 1 + std::max(child1.height, child2.height)) return false;
+            if (!(node.aabb == child1.aabb.combine(child2.aabb))) return false;
+
+            return validateNode(node.child1, leaves) && validateNode(node.child2, leaves);
+        }
+
+        /**
+         * @brief the node pool, leaves, internal nodes and free nodes
+        */
+        std::vector<Node> nodes;
+
+        NodeId root = nullNode;
+
+        /**
+         * @brief the head of the free node list, linked through Node::parent
+        */
+        NodeId freeList = nullNode;
+
+        size_t proxyCount = 0;
+
+        T margin;
+        T displacementMultiplier;
+    };
+}
@@ -0,0 +1,396 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <algorithm>
+#include "S2DMath.h"
+#include "AngularType.h"
+#include "Rot2.h"
+#include "S2DTags.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class NormVec2;
+    template<typename T>
+    class Dim2;
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Rect2;
+    template<typename T>
+    class Poly2;
+    template<typename T, size_t N>
+    class FixedPoly2;
+    template<typename T>
+    class Mat3;
+
+    /**
+     * @brief Class encapsulating a 2D affine transformation stored as a packed 2x3 matrix
+     * @details Every transformation Mat3 can build has the fixed bottom row [0 0 1], so Affine2
+     * drops it and stores only the six meaningful entries, in row order:
+     *
+     *       [a b tx]
+     *       [c d ty]
+     *      ([0 0 1 ] implied)
+     *
+     *       [0 1 2]
+     *       [3 4 5]
+     *
+     * composition takes 12 multiplies instead of 27, and the inverse is computed in closed form.
+     * Converting to and from a Mat3 is lossless as long as the Mat3 is affine
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    class Affine2
+    {
+
+    private:
+        std::array<T, 6> matrix;
+
+#define _a  Affine2::matrix[0]
+#define _b  Affine2::matrix[1]
+#define _tx Affine2::matrix[2]
+
+#define _c  Affine2::matrix[3]
+#define _d  Affine2::matrix[4]
+#define _ty Affine2::matrix[5]
+
+    public:
+
+        /**
+         * @brief Constructs an identity transform
+        */
+        constexpr Affine2() noexcept : matrix{
+            (T)1.0, (T)0.0, (T)0.0,
+            (T)0.0, (T)1.0, (T)0.0
+        } {}
+
+        /**
+         * @brief Constructs a transform where each element is specified manually
+         * @param a00 value 00
+         * @param a01 value 01
+         * @param a02 value 02, the x translation
+         * @param a10 value 10
+         * @param a11 value 11
+         * @param a12 value 12, the y translation
+        */
+        constexpr explicit Affine2(
+            const T& a00, const T& a01, const T& a02,
+            const T& a10, const T& a11, const T& a12
+        ) noexcept : matrix{
+            a00, a01, a02,
+            a10, a11, a12 }
+        {}
+
+        /**
+         * @brief Constructs a transform from the top two rows of a Mat3
+         * @details the bottom row of the Mat3 is assumed to be [0 0 1], which holds for
+         * every Mat3 built from the Mat3 transformation functions
+         * @param mat the Mat3 to convert
+        */
+        constexpr explicit Affine2(const Mat3<T>& mat) noexcept : matrix{
+            mat.getMatrix()[0], mat.getMatrix()[3], mat.getMatrix()[6],
+            mat.getMatrix()[1], mat.getMatrix()[4], mat.getMatrix()[7] }
+        {}
+
+        /**
+         * @brief Converts the transform into the equivalent Mat3
+         * @return the Mat3 with bottom row [0 0 1]
+        */
+        constexpr Mat3<T> toMat3() const noexcept {
+            return Mat3<T>(
+                _a, _b, _tx,
+                _c, _d, _ty
+            );
+        }
+
+        /**
+         * @brief Explicit conversion to a Mat3
+        */
+        constexpr explicit operator Mat3<T>() const noexcept {
+            return toMat3();
+        }
+
+        /**
+         * @brief Transforms the supplied Point2
+         * @details all transformations are applied to points
+         * @param p the Point2 to transform
+         * @return the transformed Point2
+        */
+        constexpr Point2<T> transform(const Point2<T>& p) const noexcept {
+            return Point2<T>(
+                _a * p.x + _b * p.y + _tx,
+                _c * p.x + _d * p.y + _ty
+            );
+        }
+
+        /**
+         * @brief Transforms the supplied Vec2
+         * @details transformations excluding translations are applied to vectors
+         * @param v the Vec2 to transform
+         * @return the transformed Vec2
+        */
+        constexpr Vec2<T> transform(const Vec2<T>& v) const noexcept {
+            return Vec2<T>(
+                _a * v.x + _b * v.y,
+                _c * v.x + _d * v.y
+            );
+        }
+
+        /**
+         * @brief Transforms the supplied NormVec2
+         * @details transformations excluding translations are applied to normal vectors,
+         * and the result is renormalized
+         * @param v the NormVec2 to transform
+         * @return the transformed NormVec2
+        */
+        constexpr NormVec2<T> transform(const NormVec2<T>& v) const noexcept {
+            return NormVec2<T>(
+                _a * v.x + _b * v.y,
+                _c * v.x + _d * v.y
+            );
+        }
+
+        /**
+         * @brief Transforms the supplied Dim2
+         * @details all transformations excluding translations are applied to Dimensions
+         * @param d the Dim2 to transform
+         * @return the transformed Dim2
+        */
+        constexpr Dim2<T> transform(const Dim2<T>& d) const noexcept {
+            return Dim2<T>(
+                _a * d.x + _b * d.y,
+                _c * d.x + _d * d.y
+            );
+        }
+
+        /**
+         * @brief Transforms the supplied Rect2
+         * @details all transformations are applied to the min and max points,
+         * the result stays axis aligned
+         * @param r The Rect2 to transform
+         * @return the transformed Rect2
+        */
+        constexpr Rect2<T> transform(const Rect2<T>& r) const noexcept {
+            return Rect2<T>(
+                transform(r.min),
+                transform(r.max)
+            );
+        }
+
+        /**
+         * @brief Transforms the supplied Poly2
+         * @details all transformations are applied to Polygons, the
+         * result is not rechecked for convexity, see Poly2::mapAffine
+         * @param p the Poly2 to transform
+         * @return the transformed Poly2
+        */
+        constexpr Poly2<T> transform(const Poly2<T>& p) const {
+            return p.mapAffine([this](const Point2<T>& a) { return transform(a); });
+        }
+
+        /**
+         * @brief Transforms the supplied FixedPoly2
+         * @details all transformations are applied to Polygons, unrolled over the vertex count
+         * @param p the FixedPoly2 to transform
+         * @return the transformed FixedPoly2
+        */
+        template<size_t N>
+        constexpr FixedPoly2<T, N> transform(const FixedPoly2<T, N>& p) const noexcept {
+            return p.transformedBy(*this);
+        }
+
+        /**
+         * @brief Computes the determinant of the linear part of the transform
+         * @return the determinant
+        */
+        constexpr T determinant() const noexcept {
+            return _a * _d - _b * _c;
+        }
+
+        /**
+         * @brief computes the inverse transform
+         * @details closed form inverse of [A t] as [A^-1  -A^-1 t],
+         * returns the identity if the transform is singular, matching Mat3::inverse
+         * @return the inverted transform
+        */
+        constexpr Affine2 inverse() const noexcept {
+            T det = determinant();
+
+            if (det != (T)0.0) {
+                T ia =  _d / det;
+                T ib = -_b / det;
+                T ic = -_c / det;
+                T id =  _a / det;
+
+                return Affine2(
+                    ia, ib, -(ia * _tx + ib * _ty),
+                    ic, id, -(ic * _tx + id * _ty)
+                );
+            }
+            else {
+                return Affine2();
+            }
+        }
+
+        /**
+         * @brief composes two transforms, rhs is applied first
+         * @param rhs the other Affine2 to compose with
+         * @return the composed Affine2
+        */
+        constexpr Affine2 operator*(const Affine2& rhs) const noexcept {
+            return Affine2(
+                _a * rhs.matrix[0] + _b * rhs.matrix[3],
+                _a * rhs.matrix[1] + _b * rhs.matrix[4],
+                _a * rhs.matrix[2] + _b * rhs.matrix[5] + _tx,
+
+                _c * rhs.matrix[0] + _d * rhs.matrix[3],
+                _c * rhs.matrix[1] + _d * rhs.matrix[4],
+                _c * rhs.matrix[2] + _d * rhs.matrix[5] + _ty
+            );
+        }
+
+        /**
+         * @brief compose-eq's two transforms, rhs is applied first
+         * @param rhs the other Affine2 to compose with
+         * @return a reference to the Affine2 for chaining
+        */
+        constexpr Affine2& operator*=(const Affine2& rhs) noexcept {
+            (*this) = (*this) * rhs;
+            return *this;
+        }
+
+        /**
+         * @brief translate the transform
+         * @details like Mat3::translate, the translation is applied after the
+         * existing transform, in the parent coordinate space
+         * @param translationVec the Vec2 to translate by
+         * @return the transformed Affine2
+        */
+        constexpr Affine2& translate(const Vec2<T>& translationVec) noexcept {
+            _tx += translationVec.x;
+            _ty += translationVec.y;
+            return *this;
+        }
+
+        /**
+         * @brief rotate the transform
+         * @param rad the radian value of the rotation
+         * @param center optionally set the center of the transformation
+         * @return the transformed Affine2
+        */
+        constexpr Affine2& rotate(const Radians rad, const Point2<T>& center = Point2<T>()) noexcept {
+            return rotate(Rot2<T>(rad), center);
+        }
+
+        /**
+         * @brief rotate the transform by a Rot2
+         * @param rot the rotation
+         * @param center optionally set the center of the transformation
+         * @return the transformed Affine2
+        */
+        constexpr Affine2& rotate(const Rot2<T>& rot, const Point2<T>& center = Point2<T>()) noexcept {
+            const T cosval = rot.cos;
+            const T sinval = rot.sin;
+
+            return ((*this) *= Affine2(
+                cosval, -sinval, center.x * ((T)1.0 - cosval) + center.y * sinval,
+                sinval,  cosval, center.y * ((T)1.0 - cosval) - center.x * sinval
+            ));
+        }
+
+        /**
+         * @brief scale the transform
+         * @param sx the x scale factor
+         * @param sy the y scale factor
+         * @param center optionally set the center of the transformation
+         * @return the transformed Affine2
+        */
+        constexpr Affine2& scale(const T sx, const T sy, const Point2<T>& center = Point2<T>()) noexcept {
+            return ((*this) *= Affine2(
+                    sx, (T)0.0, center.x * ((T)1.0 - sx),
+                (T)0.0,     sy, center.y * ((T)1.0 - sy)
+            ));
+        }
+
+        /**
+         * @brief shear the transform
+         * @param sx the x shear factor
+         * @param sy the y shear factor
+         * @param center optionally set the center of the transformation
+         * @return the transformed Affine2
+        */
+        constexpr Affine2& shear(const T sx, const T sy, const Point2<T>& center = Point2<T>()) noexcept {
+            return ((*this) *= Affine2(
+                (T)1.0,     sx, -(center.y * sx),
+                    sy, (T)1.0, -(center.x * sy)
+            ));
+        }
+
+        /**
+         * @brief returns a const reference to the packed 2x3 array
+         * @return the refernce to the array
+        */
+        inline constexpr const std::array<T, 6>& getMatrix() const noexcept {
+            return matrix;
+        }
+
+        /**
+         * @brief returns a reference to the packed 2x3 array
+         * @return the refernce to the array
+        */
+        inline constexpr std::array<T, 6>& getMatrix() noexcept {
+            return matrix;
+        }
+
+        /**
+         * @brief Prints the Affine2
+         * @param os Input stream
+         * @param it The Affine2 to print
+         * @return a reference to the stream for << chaining
+        */
+        friend std::ostream& operator << (std::ostream& os, const Affine2& it) {
+            auto mat = it.getMatrix();
+
+            std::string typname = typeid(T).name();
+            std::string::size_type i = typname.find("struct");
+            if (i != std::string::npos) {
+                typname.erase(i, 7);
+            }
+            i = typname.find("class");
+            if (i != std::string::npos) {
+                typname.erase(i, 6);
+            }
+
+            os << "Affine2<" << typname << ">()\n";
+            os << "[ " << mat[0] << ", " << mat[1] << ", " << mat[2] << "]\n";
+            os << "[ " << mat[3] << ", " << mat[4] << ", " << mat[5] << "]\n";
+            return os;
+        }
+
+        /**
+         * @brief Equality operator for Affine2
+         * @param other The Affine2 to compare with
+         * @return true if the two Affine2's are equal
+        */
+        constexpr bool operator== (const Affine2<T>& other) const noexcept {
+            return
+                matrix[0] == other.matrix[0] &&
+                matrix[1] == other.matrix[1] &&
+                matrix[2] == other.matrix[2] &&
+                matrix[3] == other.matrix[3] &&
+                matrix[4] == other.matrix[4] &&
+                matrix[5] == other.matrix[5];
+        }
+
+#undef _a
+#undef _b
+#undef _tx
+
+#undef _c
+#undef _d
+#undef _ty
+    };
+}
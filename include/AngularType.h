@@ -41,9 +41,17 @@ namespace Space2D {
 		T& get() noexcept { return value; }
 		const T& get() const noexcept { return value; }
 
+		/**
+		 * @brief the factor a value is multiplied by to convert it to another ratio
+		 * @details folded at compile time in long double, so a conversion is a single multiply
+		*/
 		template <typename OtherRatio>
-		operator AngularType<T, Tag, OtherRatio>() const {
-			return  AngularType<T, Tag, OtherRatio>(get() * Ratio::num / Ratio::den * OtherRatio::den / OtherRatio::num);
+		static constexpr T conversionFactor = static_cast<T>(
+			static_cast<long double>(Ratio::num) / Ratio::den * OtherRatio::den / OtherRatio::num);
+
+		template <typename OtherRatio>
+		constexpr operator AngularType<T, Tag, OtherRatio>() const noexcept {
+			return AngularType<T, Tag, OtherRatio>(value * conversionFactor<OtherRatio>);
 		}
 
 		auto operator<=>(const Angular&) const noexcept = default;
@@ -51,6 +59,12 @@ namespace Space2D {
 			return std::abs(value - other.value) < epsilon;
 		}
 
+		//spelled out so that comparisons compile to a single compare, as on T, rather than through <=>
+		constexpr bool operator< (const Angular& rhs) const noexcept { return value < rhs.value; }
+		constexpr bool operator> (const Angular& rhs) const noexcept { return value > rhs.value; }
+		constexpr bool operator<= (const Angular& rhs) const noexcept { return value <= rhs.value; }
+		constexpr bool operator>= (const Angular& rhs) const noexcept { return value >= rhs.value; }
+
 		explicit operator double() const {
 			return value;
 		}
@@ -61,21 +75,21 @@ namespace Space2D {
 
 #ifndef S2D_ANGULAR_OPERATOR
 #define S2D_ANGULAR_OPERATOR(op) \
-    constexpr inline Angular& operator##op##=(const Angular& rhs) noexcept {\
+    constexpr inline Angular& operator op##=(const Angular& rhs) noexcept {\
         value op##= (T)rhs;\
         return *this;\
 	}\
-	constexpr inline Angular operator##op(const Angular& rhs) const noexcept { \
+	constexpr inline Angular operator op(const Angular& rhs) const noexcept { \
 	    return Angular(value op (T)rhs);\
 	}\
-	constexpr inline Angular& operator##op##=(const T& rhs) noexcept {\
+	constexpr inline Angular& operator op##=(const T& rhs) noexcept {\
         value op##= (T)rhs;\
         return *this;\
 	}\
-	constexpr inline Angular& operator##op(const T& rhs) const noexcept { \
+	constexpr inline Angular operator op(const T& rhs) const noexcept { \
 	    return Angular(value op (T)rhs);\
 	}\
-    constexpr inline friend Angular& operator##op(const T& lhs, const Angular& rhs) noexcept { \
+    constexpr inline friend Angular operator op(const T& lhs, const Angular& rhs) noexcept { \
 		return Angular(lhs op rhs.value);\
 	}
 #endif
@@ -0,0 +1,369 @@
+#pragma once
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include "S2DMath.h"
+#include "S2DTags.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class NormVec2;
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Rect2;
+    template<typename T>
+    class Poly2;
+
+    /**
+     * @brief Class encapsulating a 2 Dimensional convex polygon with a vertex count fixed at compile time
+     * @details FixedPoly2 is the compile time sized counterpart of Poly2, intended for the
+     * common triangles and quads. The points live in a std::array, and area, centroid, AABB,
+     * face normals and transformations are expanded over the vertex count at compile time,
+     * so none of them loop, branch on the size or bounds check. Everything except the face
+     * normals (which need a square root) can be evaluated in a constant expression.
+     * Like Poly2, convexity is checked when constructing from arbitrary points
+     * @tparam T the underlying coordinate type of the FixedPoly2
+     * @tparam N the number of vertices, at least 3
+    */
+    template<typename T, size_t N>
+    class FixedPoly2
+    {
+        static_assert(N >= 3, "FixedPoly2 needs at least 3 vertices");
+
+        using Indices = std::make_index_sequence<N>;
+
+    public:
+
+        /**
+         * @brief Constructs a FixedPoly2 from an array of points
+         * @param points the points to construct from
+        */
+        constexpr explicit FixedPoly2(const std::array<Point2<T>, N>& points) : points(points) {
+            if (!isConvex()) {
+                throw std::logic_error("FixedPoly2 is not convex");
+            }
+        }
+
+        /**
+         * @brief Constructs a FixedPoly2 from exactly N points
+         * @details example syntax:
+         *
+         *           FixedPoly2<float, 3>(Point2f(0, 0), Point2f(0, 1), Point2f(1, 1));
+         *
+         * @param ...pts the points to construct from
+        */
+        template<typename... Pts,
+            typename = std::enable_if_t<sizeof...(Pts) == N && (std::is_convertible_v<Pts, Point2<T>> && ...)>>
+        constexpr explicit FixedPoly2(const Pts&... pts) : FixedPoly2(std::array<Point2<T>, N>{ Point2<T>(pts)... }) {}
+
+        /**
+         * @brief Constructs a FixedPoly2 from a Poly2 with exactly N points
+         * @param poly the Poly2 to construct from
+        */
+        constexpr explicit FixedPoly2(const Poly2<T>& poly) : points(fromPoly(poly, Indices())) {}
+
+        /**
+         * @brief Converts the FixedPoly2 into an equivalent Poly2
+         * @return the Poly2 with the same points
+        */
+        Poly2<T> toPoly2() const {
+            typename Poly2<T>::PointStorage storage(points.begin(), points.end());
+            return Poly2<T>(trustedConvex, std::move(storage));
+        }
+
+        /**
+         * @brief Explicit conversion to a Poly2
+        */
+        explicit operator Poly2<T>() const {
+            return toPoly2();
+        }
+
+        /**
+         * @brief Returns the number of points, always N
+         * @return the number of points
+        */
+        static constexpr size_t size() noexcept {
+            return N;
+        }
+
+        /**
+         * @brief Unchecked access to the points
+         * @param i The index
+         * @return a read only reference to the point
+        */
+        constexpr const Point2<T>& operator[] (const size_t i) const noexcept {
+            return points[i];
+        }
+
+        /**
+         * @brief Bounds checked access to the points
+         * @param i The index
+         * @return a read only reference to the point
+        */
+        constexpr const Point2<T>& at(const size_t i) const {
+            if (i >= N) throw std::out_of_range("FixedPoly2 subscript out of range");
+            return points[i];
+        }
+
+        /**
+         * @brief Compile time access to the points
+         * @tparam I The index
+         * @return a read only reference to the point
+        */
+        template<size_t I>
+        constexpr const Point2<T>& get() const noexcept {
+            static_assert(I < N, "FixedPoly2 index out of range");
+            return points[I];
+        }
+
+        /**
+         * @brief Read only access to the underlying array
+         * @return a reference to the array of points
+        */
+        constexpr const std::array<Point2<T>, N>& getPoints() const noexcept {
+            return points;
+        }
+
+        /**
+         * @brief Beginning of the Iterator range
+         * @return A const iterator at the beginning of the FixedPoly2
+        */
+        constexpr auto cbegin() const noexcept {
+            return points.cbegin();
+        }
+
+        /**
+         * @brief One past the end of the Iterator range
+         * @return A const iterator one past the end of the FixedPoly2
+        */
+        constexpr auto cend() const noexcept {
+            return points.cend();
+        }
+
+        /**
+         * @brief Equality operator for FixedPoly2
+         * @param other The FixedPoly2 to compare with
+         * @return true if the two FixedPoly2's are equal
+        */
+        constexpr bool operator==(const FixedPoly2& other) const noexcept {
+            return points == other.points;
+        }
+
+        /**
+         * @brief Computes the area of the FixedPoly2
+         * @return the computed area
+        */
+        constexpr T area() const noexcept {
+            T a = doubleSignedArea(Indices()) / (T)2.0;
+            return a < (T)0.0 ? -a : a;
+        }
+
+        /**
+         * @brief Computes the centroid, or the unweighted center of mass of the FixedPoly2
+         * @return the computed Centroid Point2
+        */
+        constexpr Point2<T> centroid() const noexcept {
+            return centroidImpl(Indices());
+        }
+
+        /**
+         * @brief Computes the Axis Aligned Bounding Box (AABB) of the FixedPoly2
+         * @return the computed AABB
+        */
+        constexpr Rect2<T> getAABB() const noexcept {
+            return aabbImpl(Indices());
+        }
+
+        /**
+         * @brief Get a Vec2 of the face of the supplied index
+         * @param index the index of the first point of the face
+         * @return The Vec2 representing the requested face
+        */
+        constexpr Vec2<T> getFaceVec(const size_t index) const noexcept {
+            return Vec2<T>(points[index], points[index == N - 1 ? 0 : index + 1]);
+        }
+
+        /**
+         * @brief Computes the normal of the face of the supplied index
+         * @details uses the same unit normal rule as Poly2::getFaceNormal
+         * @param index the index of the first point of the face
+         * @return the normal of the face
+        */
+        constexpr NormVec2<T> getFaceNormal(const size_t index) const noexcept {
+            return getFaceVec(index).unitNormal();
+        }
+
+        /**
+         * @brief Computes the normals of every face at once
+         * @return the face normals, indexed like getFaceNormal
+        */
+        constexpr std::array<NormVec2<T>, N> getFaceNormals() const noexcept {
+            return faceNormalsImpl(Indices());
+        }
+
+        /**
+         * @brief Transforms every point of the FixedPoly2 by a Mat3 or Affine2
+         * @details a linear transformation can't break convexity, so the result is not rechecked
+         * @param mat the transformation to apply
+         * @return the transformed FixedPoly2
+        */
+        template<typename Transform>
+        constexpr FixedPoly2 transformedBy(const Transform& mat) const noexcept {
+            return transformImpl(mat, Indices());
+        }
+
+        /**
+         * @brief addition for FixedPoly2 with Vec2
+         * @param rhs the addition Vec2
+        */
+        constexpr FixedPoly2 operator+(const Vec2<T>& rhs) const noexcept {
+            return offsetImpl(rhs.x, rhs.y, Indices());
+        }
+
+        /**
+         * @brief subtract for FixedPoly2 with Vec2
+         * @param rhs the subtraction Vec2
+        */
+        constexpr FixedPoly2 operator-(const Vec2<T>& rhs) const noexcept {
+            return offsetImpl(-rhs.x, -rhs.y, Indices());
+        }
+
+        /**
+         * @brief addition-eq for FixedPoly2 with Vec2
+         * @param rhs the addition Vec2
+        */
+        constexpr FixedPoly2& operator+=(const Vec2<T>& rhs) noexcept {
+            return (*this) = (*this) + rhs;
+        }
+
+        /**
+         * @brief subtract-eq for FixedPoly2 with Vec2
+         * @param rhs the subtraction Vec2
+        */
+        constexpr FixedPoly2& operator-=(const Vec2<T>& rhs) noexcept {
+            return (*this) = (*this) - rhs;
+        }
+
+        /**
+         * @brief Prints the FixedPoly2
+         * @param os Input stream
+         * @param it The FixedPoly2 to print
+         * @return a reference to the stream for << chaining
+        */
+        friend std::ostream& operator << (std::ostream& os, const FixedPoly2& it) {
+
+            std::string typname = typeid(T).name();
+            std::string::size_type i = typname.find("struct");
+            if (i != std::string::npos) {
+                typname.erase(i, 7);
+            }
+            i = typname.find("class");
+            if (i != std::string::npos) {
+                typname.erase(i, 6);
+            }
+
+            os << "FixedPolygon<" << typname << ", " << N << ">{\n";
+            for (size_t i = 0; i < N; i++) {
+                os << "(" << it.points[i].x << ", " << it.points[i].y << "),\n";
+            }
+            os << "}";
+            return os;
+        }
+
+    private:
+
+        /**
+         * @brief tag selecting the constructor that skips the convexity check,
+         * only used for results that are convex by construction
+        */
+        struct Unchecked {};
+
+        constexpr explicit FixedPoly2(Unchecked, const std::array<Point2<T>, N>& points) noexcept : points(points) {}
+
+        template<size_t... I>
+        static constexpr std::array<Point2<T>, N> fromPoly(const Poly2<T>& poly, std::index_sequence<I...>) {
+            if (poly.size() != N) throw std::logic_error("FixedPoly2 size does not match the Poly2");
+            return std::array<Point2<T>, N>{ poly[I]... };
+        }
+
+        template<size_t I>
+        constexpr const Point2<T>& next() const noexcept {
+            return points[(I + 1) % N];
+        }
+
+        template<size_t I>
+        constexpr T cross() const noexcept {
+            return points[I].x * next<I>().y - next<I>().x * points[I].y;
+        }
+
+        template<size_t... I>
+        constexpr T doubleSignedArea(std::index_sequence<I...>) const noexcept {
+            return (cross<I>() + ...);
+        }
+
+        template<size_t... I>
+        constexpr Point2<T> centroidImpl(std::index_sequence<I...>) const noexcept {
+            double signedArea6 = 3.0 * (static_cast<double>(cross<I>()) + ...);
+            double cx = ((static_cast<double>(points[I].x + next<I>().x) * static_cast<double>(cross<I>())) + ...);
+            double cy = ((static_cast<double>(points[I].y + next<I>().y) * static_cast<double>(cross<I>())) + ...);
+            return Point2<T>(static_cast<T>(cx / signedArea6), static_cast<T>(cy / signedArea6));
+        }
+
+        template<size_t... I>
+        constexpr Rect2<T> aabbImpl(std::index_sequence<I...>) const noexcept {
+            return Rect2<T>(
+                Point2<T>(std::min({ points[I].x... }), std::min({ points[I].y... })),
+                Point2<T>(std::max({ points[I].x... }), std::max({ points[I].y... }))
+            );
+        }
+
+        template<size_t... I>
+        constexpr std::array<NormVec2<T>, N> faceNormalsImpl(std::index_sequence<I...>) const noexcept {
+            return std::array<NormVec2<T>, N>{ Vec2<T>(points[I], next<I>()).unitNormal()... };
+        }
+
+        template<typename Transform, size_t... I>
+        constexpr FixedPoly2 transformImpl(const Transform& mat, std::index_sequence<I...>) const noexcept {
+            return FixedPoly2(Unchecked(), std::array<Point2<T>, N>{ mat.transform(points[I])... });
+        }
+
+        template<size_t... I>
+        constexpr FixedPoly2 offsetImpl(const T& dx, const T& dy, std::index_sequence<I...>) const noexcept {
+            return FixedPoly2(Unchecked(), std::array<Point2<T>, N>{ Point2<T>(points[I].x + dx, points[I].y + dy)... });
+        }
+
+        /**
+         * @brief determines if the polygon is convex, using the same rule as Poly2
+         * @return true if the polygon is convex
+        */
+        constexpr bool isConvex() const noexcept {
+            T prev = (T)0.0;
+            for (size_t i = 0; i < N; i++) {
+                T curr = (-getFaceVec(i)).cross(getFaceVec((i + 1) % N));
+                if (curr != (T)0.0) {
+                    if (curr * prev < (T)0.0) {
+                        return false;
+                    }
+                    prev = curr;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief the points of the FixedPoly2
+        */
+        std::array<Point2<T>, N> points;
+    };
+
+    template<typename T>
+    using Tri2 = FixedPoly2<T, 3>;
+
+    template<typename T>
+    using Quad2 = FixedPoly2<T, 4>;
+}
@@ -31,8 +31,7 @@ namespace Space2D {
 
 		constexpr LinearType() noexcept : value(0) {}
 		constexpr LinearType(const T& value) noexcept : value(value) {}
-		constexpr LinearType(const Linear& other) noexcept
-			: value(other.value) {}
+		constexpr LinearType(const Linear& other) noexcept = default;
 		constexpr explicit LinearType(const long double& value) noexcept
 			: value(static_cast<T>(value)) {}
 		constexpr explicit LinearType(const double& value) noexcept
@@ -43,10 +42,17 @@ namespace Space2D {
 		T& get() noexcept { return value; }
 		const T& get() const noexcept { return value; }
 
+		/**
+		 * @brief the factor a value is multiplied by to convert it to another ratio
+		 * @details folded at compile time in long double, so a conversion is a single multiply
+		*/
 		template <typename OtherRatio>
-		operator LinearType<T, Tag, OtherRatio>() const {
+		static constexpr T conversionFactor = static_cast<T>(
+			static_cast<long double>(Ratio::num) / Ratio::den * OtherRatio::den / OtherRatio::num);
 
-			return  LinearType<T, Tag, OtherRatio>(get() * Ratio::num / Ratio::den * OtherRatio::den / OtherRatio::num);
+		template <typename OtherRatio>
+		constexpr operator LinearType<T, Tag, OtherRatio>() const noexcept {
+			return LinearType<T, Tag, OtherRatio>(value * conversionFactor<OtherRatio>);
 		}
 
 		auto operator<=>(const Linear&) const noexcept = default;
@@ -54,28 +60,34 @@ namespace Space2D {
 			return std::abs(value - other.value) < epsilon;
 		}
 
-		explicit operator double() const {
+		//spelled out so that comparisons compile to a single compare, as on T, rather than through <=>
+		constexpr bool operator< (const Linear& rhs) const noexcept { return value < rhs.value; }
+		constexpr bool operator> (const Linear& rhs) const noexcept { return value > rhs.value; }
+		constexpr bool operator<= (const Linear& rhs) const noexcept { return value <= rhs.value; }
+		constexpr bool operator>= (const Linear& rhs) const noexcept { return value >= rhs.value; }
+
+		constexpr explicit operator double() const noexcept {
 			return (double)value;
 		}
 
-		explicit operator float() const {
+		constexpr explicit operator float() const noexcept {
 			return (float)value;
 		}
 
 #ifndef S2D_LINEAR_OPERATOR
 #define S2D_LINEAR_OPERATOR(op) \
-    constexpr inline Linear& operator##op##=(const Linear& rhs) noexcept {\
+    constexpr inline Linear& operator op##=(const Linear& rhs) noexcept {\
         value op##= (T)rhs;\
         return *this;\
 	}\
-	constexpr inline Linear operator##op(const Linear& rhs) const noexcept { \
+	constexpr inline Linear operator op(const Linear& rhs) const noexcept { \
 	    return Linear(value op (T)rhs);\
 	}\
-	constexpr inline Linear& operator##op##=(const T& rhs) noexcept {\
+	constexpr inline Linear& operator op##=(const T& rhs) noexcept {\
         value op##= (T)rhs;\
         return *this;\
 	}\
-	constexpr inline Linear operator##op(const T& rhs) const noexcept { \
+	constexpr inline Linear operator op(const T& rhs) const noexcept { \
 	    return Linear(value op (T)rhs);\
 	}
 #endif
@@ -0,0 +1,376 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include "S2DInlineVec.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Rect2;
+    template<typename T>
+    class Poly2;
+
+    /**
+     * @brief Bulk built loose quadtree over mostly static Rect2 bounded geometry
+     * @details Each item is stored in the deepest node whose square, doubled in size, still
+     * contains the item. Doubling the squares lets an item sit in a single node even when it
+     * crosses a split line, so nothing is stored twice and a node's depth only depends on the
+     * size of its items. Nodes are only split when they hold more than the leaf capacity.
+     *
+     * Nodes live in a single array in depth first order and refer to their children by index.
+     * Items are reordered so that each node owns a contiguous range of them, and every node
+     * keeps the tight bounds of everything below it, which prunes queries further than the
+     * loose squares would.
+     *
+     * Item ids are the indices of the geometry passed to build(), so callers keep their own
+     * per item data. Region and point queries write into a caller provided buffer and never
+     * allocate. The tree is rebuilt with build() when the geometry changes
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    class LooseQuadtree2
+    {
+    public:
+
+        /**
+         * @brief index of an item in the geometry passed to build()
+        */
+        using ItemId = std::uint32_t;
+
+        /**
+         * @brief index of a node
+        */
+        using NodeId = std::uint32_t;
+
+        /**
+         * @brief the id returned when there is no item
+        */
+        static constexpr ItemId nullItem = std::numeric_limits<ItemId>::max();
+
+        /**
+         * @brief the id of a missing child
+        */
+        static constexpr NodeId nullNode = std::numeric_limits<NodeId>::max();
+
+        /**
+         * @brief the largest maxDepth a LooseQuadtree2 accepts
+        */
+        static constexpr size_t depthLimit = 32;
+
+        /**
+         * @brief Constructs an empty LooseQuadtree2
+         * @param leafCapacity nodes holding at most this many items are not split
+         * @param maxDepth the depth below which nodes are never split, at most depthLimit
+        */
+        explicit LooseQuadtree2(const size_t leafCapacity = 8, const size_t maxDepth = 16)
+            : leafCapacity(std::max<size_t>(leafCapacity, 1)), maxDepth(std::min<size_t>(maxDepth, depthLimit)) {}
+
+        /**
+         * @brief Rebuilds the tree over a set of bounding boxes
+         * @param bounds the bounds of each item, item ids are indices into this
+        */
+        void build(std::span<const Rect2<T>> bounds) {
+            if (bounds.size() >= nullItem) throw std::length_error("LooseQuadtree2 has too many items");
+
+            entries.clear();
+            entries.reserve(bounds.size());
+            for (size_t i = 0; i < bounds.size(); i++) {
+                entries.push_back(Entry{ bounds[i], static_cast<ItemId>(i) });
+            }
+            buildNodes();
+        }
+
+        /**
+         * @brief Rebuilds the tree over a set of polygons, using their bounding boxes
+         * @param polys the polygons, item ids are indices into this
+        */
+        void build(std::span<const Poly2<T>> polys) {
+            if (polys.size() >= nullItem) throw std::length_error("LooseQuadtree2 has too many items");
+
+            entries.clear();
+            entries.reserve(polys.size());
+            for (size_t i = 0; i < polys.size(); i++) {
+                entries.push_back(Entry{ polys[i].getAABB(), static_cast<ItemId>(i) });
+            }
+            buildNodes();
+        }
+
+        /**
+         * @brief Removes every item
+        */
+        void clear() noexcept {
+            entries.clear();
+            nodes.clear();
+        }
+
+        /**
+         * @brief Returns the number of items
+         * @return the number of items
+        */
+        size_t size() const noexcept {
+            return entries.size();
+        }
+
+        /**
+         * @brief Checks if the tree holds no items
+         * @return true if there are no items
+        */
+        bool empty() const noexcept {
+            return entries.empty();
+        }
+
+        /**
+         * @brief Returns the number of nodes
+         * @return the number of nodes
+        */
+        size_t nodeCount() const noexcept {
+            return nodes.size();
+        }
+
+        /**
+         * @brief Finds the items whose bounds intersect a region, touching faces included
+         * @details only the first out.size() results are written, the return value tells
+         * the caller how large a buffer would have held them all
+         * @param region the region to query
+         * @param out the buffer the ids of the found items are written to
+         * @return the total number of items found
+        */
+        size_t query(const Rect2<T>& region, std::span<ItemId> out) const {
+            return collect(out,
+                [&](const Rect2<T>& b) { return b.intersects(region); });
+        }
+
+        /**
+         * @brief Finds the items whose bounds contain a point
+         * @details follows Rect2::contains, so points on the faces of an item do not count.
+         * Only the first out.size() results are written
+         * @param p the point to locate
+         * @param out the buffer the ids of the found items are written to
+         * @return the total number of items found
+        */
+        size_t queryPoint(const Point2<T>& p, std::span<ItemId> out) const {
+            return collect(out,
+                [&](const Rect2<T>& b) { return b.contains(p); });
+        }
+
+        /**
+         * @brief Finds the item whose bounds are closest to a point
+         * @param p the point to search from
+         * @return the id of the closest item, or nullItem if the tree is empty
+        */
+        ItemId nearest(const Point2<T>& p) const {
+            return nearest(p, [](ItemId, const T& boundsDistanceSq) { return boundsDistanceSq; });
+        }
+
+        /**
+         * @brief Finds the closest item to a point using an exact distance
+         * @details the tree is searched by bounds distance and the exact distance is only
+         * evaluated for items whose bounds are closer than the best item found so far
+         * @param p the point to search from
+         * @param distanceSq called with an item id and the squared distance to its bounds,
+         * returns the squared distance to the item, which must not be less than the bounds distance
+         * @return the id of the closest item, or nullItem if the tree is empty
+        */
+        template<typename DistanceSq>
+        ItemId nearest(const Point2<T>& p, DistanceSq&& distanceSq) const {
+            if (nodes.empty()) return nullItem;
+
+            ItemId best = nullItem;
+            T bestDistSq = (T)0.0;
+
+            InlineVec<std::pair<NodeId, T>, 64> stack;
+            stack.push_back({ 0, boundsDistanceSq(nodes[0].bounds, p) });
+            while (!stack.empty()) {
+                auto [id, nodeDistSq] = stack.back();
+                stack.pop_back();
+                if (best != nullItem && !(nodeDistSq < bestDistSq)) continue;
+
+                const Node& node = nodes[id];
+                for (std::uint32_t i = node.first; i < node.first + node.count; i++) {
+                    T d = boundsDistanceSq(entries[i].bounds, p);
+                    if (best != nullItem && !(d < bestDistSq)) continue;
+                    d = distanceSq(entries[i].id, d);
+                    if (best == nullItem || d < bestDistSq) {
+                        best = entries[i].id;
+                        bestDistSq = d;
+                    }
+                }
+
+                //push the farthest children first so the closest is searched next
+                std::pair<NodeId, T> children[4];
+                size_t childCount = 0;
+                for (NodeId child : node.children) {
+                    if (child == nullNode) continue;
+                    T d = boundsDistanceSq(nodes[child].bounds, p);
+                    if (best != nullItem && !(d < bestDistSq)) continue;
+                    children[childCount++] = { child, d };
+                }
+                std::sort(children, children + childCount, [](const auto& a, const auto& b) { return b.second < a.second; });
+                for (size_t i = 0; i < childCount; i++) {
+                    stack.push_back(children[i]);
+                }
+            }
+
+            return best;
+        }
+
+        /**
+         * @brief Returns the bounds an item was built with
+         * @param id the id of the item
+         * @return the bounds of the item
+        */
+        const Rect2<T>& getBounds(const ItemId id) const {
+            if (id >= entries.size()) throw std::out_of_range("LooseQuadtree2 item does not exist");
+            return entries[slotOf[id]].bounds;
+        }
+
+        /**
+         * @brief Returns the bounds of all items
+         * @return the bounds of all items, or a default Rect2 if the tree is empty
+        */
+        Rect2<T> getBounds() const noexcept {
+            return nodes.empty() ? Rect2<T>() : nodes[0].bounds;
+        }
+
+    private:
+
+        struct Entry {
+            Rect2<T> bounds;
+            ItemId id = 0;
+        };
+
+        struct Node {
+            /**
+             * @brief the tight bounds of every item in this node and below it
+            */
+            Rect2<T> bounds;
+            NodeId children[4] = { nullNode, nullNode, nullNode, nullNode };
+            std::uint32_t first = 0;
+            std::uint32_t count = 0;
+        };
+
+        static T boundsDistanceSq(const Rect2<T>& b, const Point2<T>& p) noexcept {
+            T dx = p.x < b.min.x ? b.min.x - p.x : (p.x > b.max.x ? p.x - b.max.x : (T)0.0);
+            T dy = p.y < b.min.y ? b.min.y - p.y : (p.y > b.max.y ? p.y - b.max.y : (T)0.0);
+            return dx * dx + dy * dy;
+        }
+
+        template<typename Overlaps>
+        size_t collect(std::span<ItemId> out, Overlaps&& overlaps) const {
+            if (nodes.empty()) return 0;
+
+            size_t found = 0;
+            InlineVec<NodeId, traversalStack> stack;
+            stack.push_back(0);
+            while (!stack.empty()) {
+                const Node& node = nodes[stack.back()];
+                stack.pop_back();
+                if (!overlaps(node.bounds)) continue;
+
+                for (std::uint32_t i = node.first; i < node.first + node.count; i++) {
+                    if (!overlaps(entries[i].bounds)) continue;
+                    if (found < out.size()) out[found] = entries[i].id;
+                    found++;
+                }
+                for (NodeId child : node.children) {
+                    if (child != nullNode) stack.push_back(child);
+                }
+            }
+            return found;
+        }
+
+        void buildNodes() {
+            nodes.clear();
+            slotOf.clear();
+            if (entries.empty()) return;
+
+            Rect2<T> world = entries[0].bounds;
+            for (const auto& entry : entries) {
+                world = world.combine(entry.bounds);
+            }
+            Point2<T> center = world.center();
+            T half = std::max(world.max.x - world.min.x, world.max.y - world.min.y) * (T)0.5;
+
+            buildNode(0, entries.size(), center, half, 0);
+
+            slotOf.resize(entries.size());
+            for (size_t i = 0; i < entries.size(); i++) {
+                slotOf[entries[i].id] = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        /**
+         * @brief builds the node for entries [first, last), whose centers lie in the square around center
+         * @return the index of the new node
+        */
+        NodeId buildNode(const size_t first, const size_t last, const Point2<T>& center, const T& half, const size_t depth) {
+            NodeId id = static_cast<NodeId>(nodes.size());
+            nodes.emplace_back();
+
+            size_t mid = last;
+            if (last - first > leafCapacity && depth < maxDepth) {
+                //items larger than a child square stay here, the rest go to the child holding their center
+                const T childHalf = half * (T)0.5;
+                mid = static_cast<size_t>(std::partition(entries.begin() + first, entries.begin() + last, [&](const Entry& e) {
+                    return (e.bounds.max.x - e.bounds.min.x) * (T)0.5 > childHalf ||
+                        (e.bounds.max.y - e.bounds.min.y) * (T)0.5 > childHalf;
+                    }) - entries.begin());
+
+                auto below = [&](const Entry& e) { return (e.bounds.min.y + e.bounds.max.y) * (T)0.5 < center.y; };
+                auto left = [&](const Entry& e) { return (e.bounds.min.x + e.bounds.max.x) * (T)0.5 < center.x; };
+
+                size_t splitY = static_cast<size_t>(std::partition(entries.begin() + mid, entries.begin() + last, below) - entries.begin());
+                size_t splitBottom = static_cast<size_t>(std::partition(entries.begin() + mid, entries.begin() + splitY, left) - entries.begin());
+                size_t splitTop = static_cast<size_t>(std::partition(entries.begin() + splitY, entries.begin() + last, left) - entries.begin());
+
+                const size_t bounds[5] = { mid, splitBottom, splitY, splitTop, last };
+                for (size_t q = 0; q < 4; q++) {
+                    if (bounds[q] == bounds[q + 1]) continue;
+                    Point2<T> childCenter(center.x + ((q & 1) ? childHalf : -childHalf), center.y + ((q & 2) ? childHalf : -childHalf));
+                    NodeId child = buildNode(bounds[q], bounds[q + 1], childCenter, childHalf, depth + 1);
+                    nodes[id].children[q] = child;
+                }
+            }
+
+            Node& node = nodes[id];
+            node.first = static_cast<std::uint32_t>(first);
+            node.count = static_cast<std::uint32_t>(mid - first);
+
+            bool hasBounds = false;
+            for (size_t i = first; i < mid; i++) {
+                node.bounds = hasBounds ? node.bounds.combine(entries[i].bounds) : entries[i].bounds;
+                hasBounds = true;
+            }
+            for (NodeId child : node.children) {
+                if (child == nullNode) continue;
+                node.bounds = hasBounds ? node.bounds.combine(nodes[child].bounds) : nodes[child].bounds;
+                hasBounds = true;
+            }
+            return id;
+        }
+
+        /**
+         * @brief the inline capacity of the query stack
+         * @details popping a node pushes at most its 4 children, so each level above the
+         * deepest leaves at most 3 siblings waiting, and the stack never spills to the heap
+        */
+        static constexpr size_t traversalStack = 3 * depthLimit + 4;
+
+        size_t leafCapacity;
+        size_t maxDepth;
+
+        std::vector<Node> nodes;
+        std::vector<Entry> entries;
+
+        /**
+         * @brief the position of each item in entries
+        */
+        std::vector<std::uint32_t> slotOf;
+    };
+}
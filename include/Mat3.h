@@ -4,6 +4,9 @@
 #include <algorithm>
 #include "S2DMath.h"
 #include "AngularType.h"
+#include "Rot2.h"
+#include "S2DTags.h"
+#include "S2DSimd.h"
 
 namespace Space2D {
 
@@ -19,6 +22,10 @@ namespace Space2D {
     class Rect2;
     template<typename T>
     class Poly2;
+    template<typename T, size_t N>
+    class FixedPoly2;
+    template<typename T>
+    class PointBuffer2;
 
     /**
 	 * @brief Class encapsulating a 3x3 Matrix, intended to be used for Linear/Affine transformations
@@ -177,17 +184,69 @@ namespace Space2D {
 
         /**
          * @brief Transforms the supplied Poly2
-         * @details all transformations are applied to Polygons
+         * @details all transformations are applied to Polygons, the
+         * result is not rechecked for convexity, see Poly2::mapAffine
          * @param p the Poly2 to transform
          * @return the transformed Poly2
         */
-        constexpr Poly2<T> transform(const Poly2<T>& p) const noexcept {
-            std::vector<Point2<T>> points;
-            std::for_each(p.cbegin(), p.cend(), [this, &points](const auto& point) {
-                    points.push_back(transform(point));
+        constexpr Poly2<T> transform(const Poly2<T>& p) const {
+            return p.mapAffine([this](const Point2<T>& a) { return transform(a); });
+        }
+
+        /**
+         * @brief Transforms the supplied FixedPoly2
+         * @details all transformations are applied to Polygons, unrolled over the vertex count
+         * @param p the FixedPoly2 to transform
+         * @return the transformed FixedPoly2
+        */
+        template<size_t N>
+        constexpr FixedPoly2<T, N> transform(const FixedPoly2<T, N>& p) const noexcept {
+            return p.transformedBy(*this);
+        }
+
+        /**
+         * @brief Transforms every point of the supplied PointBuffer2 in place
+         * @details equivalent to calling transform on each point, but only the affine
+         * part of the matrix is applied and float buffers are processed with SSE/AVX2
+         * kernels when available
+         * @param points the PointBuffer2 to transform
+        */
+        void transformBatch(PointBuffer2<T>& points) const noexcept {
+            transformBatch(points.xData(), points.yData(), points.xData(), points.yData(), points.size());
+        }
+
+        /**
+         * @brief Transforms every point of the supplied PointBuffer2 into another PointBuffer2
+         * @details out is resized to match in, reusing its storage when possible
+         * @param in the PointBuffer2 to transform
+         * @param out the PointBuffer2 receiving the transformed points
+        */
+        void transformBatch(const PointBuffer2<T>& in, PointBuffer2<T>& out) const {
+            out.resize(in.size());
+            transformBatch(in.xData(), in.yData(), out.xData(), out.yData(), in.size());
+        }
+
+        /**
+         * @brief Transforms n points stored as separate x and y arrays
+         * @details the input and output arrays may be the same arrays, but must not partially overlap
+         * @param xin the input x coordinates
+         * @param yin the input y coordinates
+         * @param xout the output x coordinates
+         * @param yout the output y coordinates
+         * @param n the number of points
+        */
+        void transformBatch(const T* xin, const T* yin, T* xout, T* yout, const size_t n) const noexcept {
+            if constexpr (std::is_same_v<T, float>) {
+                simd::affineTransform(xin, yin, xout, yout, n, _a, _b, _tx, _c, _d, _ty);
+            }
+            else {
+                for (size_t i = 0; i < n; i++) {
+                    const T x = xin[i];
+                    const T y = yin[i];
+                    xout[i] = _a * x + _b * y + _tx;
+                    yout[i] = _c * x + _d * y + _ty;
                 }
-            );
-            return Poly2<T>(points);
+            }
         }
 
 
@@ -313,47 +372,154 @@ namespace Space2D {
 
         /**
          * @brief translate the Matrix
+         * @details the translation happens in the parent coordinate space, after the existing
+         * transformations, so this is equivalent to pretranslate
          * @param translationVec the Vec2 to translate by
          * @return the transformed Matrix
         */
         constexpr Mat3& translate(const Vec2<T>& translationVec) noexcept {
-            auto transVecInv = this->inverse().transform(translationVec);
+            return pretranslate(translationVec);
+        }
 
-            return ((*this) *= Mat3(
-                1, 0, transVecInv.x,
-                0, 1, transVecInv.y,
-                0, 0, 1
-            ));
+        /**
+         * @brief translate the Matrix in the parent coordinate space, Mat3 = T * Mat3
+         * @details applied directly to the rows of the matrix, no matrix product or inverse is computed
+         * @param translationVec the Vec2 to translate by
+         * @return the transformed Matrix
+        */
+        constexpr Mat3& pretranslate(const Vec2<T>& translationVec) noexcept {
+            return premultiplyAffine(
+                1, 0, translationVec.x,
+                0, 1, translationVec.y
+            );
+        }
+
+        /**
+         * @brief translate the Matrix in the local coordinate space, Mat3 = Mat3 * T
+         * @details applied directly to the translation column of the matrix, no matrix product is computed
+         * @param translationVec the Vec2 to translate by
+         * @return the transformed Matrix
+        */
+        constexpr Mat3& posttranslate(const Vec2<T>& translationVec) noexcept {
+            return postmultiplyAffine(
+                1, 0, translationVec.x,
+                0, 1, translationVec.y
+            );
         }
 
         /**
          * @brief rotate the Matrix
+         * @details the rotation happens in the local coordinate space, before the existing
+         * transformations, so this is equivalent to postrotate
          * @param rad the radian value of the rotation
          * @param center optionally set the center of the transformation
          * @return the transformed matrix
         */
         constexpr Mat3& rotate(const Radians rad, const Point2<T>& center = Point2<T>()) noexcept {
-            T cosval = (T)cos(rad);
-            T sinval = (T)sin(rad);
+            return postrotate(rad, center);
+        }
 
-            return ((*this) *= Mat3(
-                 cosval, -sinval, center.x * (1 - cosval) - center.y * sinval,
-                 sinval,  cosval, center.y * (1 - cosval) + center.x * sinval
-            ));
+        /**
+         * @brief rotate the Matrix by a Rot2, the same as postrotate
+         * @param rot the rotation
+         * @param center optionally set the center of the transformation
+         * @return the transformed matrix
+        */
+        constexpr Mat3& rotate(const Rot2<T>& rot, const Point2<T>& center = Point2<T>()) noexcept {
+            return postrotate(rot, center);
+        }
+
+        /**
+         * @brief rotate the Matrix in the parent coordinate space, Mat3 = R * Mat3
+         * @param rad the radian value of the rotation
+         * @param center optionally set the center of the transformation
+         * @return the transformed matrix
+        */
+        constexpr Mat3& prerotate(const Radians rad, const Point2<T>& center = Point2<T>()) noexcept {
+            return prerotate(Rot2<T>(rad), center);
+        }
+
+        /**
+         * @brief rotate the Matrix in the parent coordinate space by a Rot2, Mat3 = R * Mat3
+         * @param rot the rotation
+         * @param center optionally set the center of the transformation
+         * @return the transformed matrix
+        */
+        constexpr Mat3& prerotate(const Rot2<T>& rot, const Point2<T>& center = Point2<T>()) noexcept {
+            const T cosval = rot.cos;
+            const T sinval = rot.sin;
+
+            return premultiplyAffine(
+                cosval, -sinval, center.x * ((T)1.0 - cosval) + center.y * sinval,
+                sinval,  cosval, center.y * ((T)1.0 - cosval) - center.x * sinval
+            );
+        }
+
+        /**
+         * @brief rotate the Matrix in the local coordinate space, Mat3 = Mat3 * R
+         * @param rad the radian value of the rotation
+         * @param center optionally set the center of the transformation
+         * @return the transformed matrix
+        */
+        constexpr Mat3& postrotate(const Radians rad, const Point2<T>& center = Point2<T>()) noexcept {
+            return postrotate(Rot2<T>(rad), center);
+        }
+
+        /**
+         * @brief rotate the Matrix in the local coordinate space by a Rot2, Mat3 = Mat3 * R
+         * @param rot the rotation
+         * @param center optionally set the center of the transformation
+         * @return the transformed matrix
+        */
+        constexpr Mat3& postrotate(const Rot2<T>& rot, const Point2<T>& center = Point2<T>()) noexcept {
+            const T cosval = rot.cos;
+            const T sinval = rot.sin;
+
+            return postmultiplyAffine(
+                cosval, -sinval, center.x * ((T)1.0 - cosval) + center.y * sinval,
+                sinval,  cosval, center.y * ((T)1.0 - cosval) - center.x * sinval
+            );
         }
 
         /**
          * @brief scale the matrix
+         * @details the scale happens in the local coordinate space, before the existing
+         * transformations, so this is equivalent to postscale
          * @param sx the x scale factor
          * @param sy the y scale factor
          * @param center optionally set the center of the transformation
          * @return the transformed matrix
         */
         constexpr Mat3& scale(const T sx, const T sy, const Point2<T>& center = Point2<T>()) noexcept {
-            return ((*this) *= Mat3(
-                sx,  0, center.x * (1 - sx),
-                 0, sy, center.y * (1 - sy)
-            ));
+            return postscale(sx, sy, center);
+        }
+
+        /**
+         * @brief scale the matrix in the parent coordinate space, Mat3 = S * Mat3
+         * @param sx the x scale factor
+         * @param sy the y scale factor
+         * @param center optionally set the center of the transformation
+         * @return the transformed matrix
+        */
+        constexpr Mat3& prescale(const T sx, const T sy, const Point2<T>& center = Point2<T>()) noexcept {
+            return premultiplyAffine(
+                sx,  0, center.x * ((T)1.0 - sx),
+                 0, sy, center.y * ((T)1.0 - sy)
+            );
+        }
+
+        /**
+         * @brief scale the matrix in the local coordinate space, Mat3 = Mat3 * S
+         * @param sx the x scale factor
+         * @param sy the y scale factor
+         * @param center optionally set the center of the transformation
+         * @return the transformed matrix
+        */
+        constexpr Mat3& postscale(const T sx, const T sy, const Point2<T>& center = Point2<T>()) noexcept {
+            return postmultiplyAffine(
+                sx,  0, center.x * ((T)1.0 - sx),
+                 0, sy, center.y * ((T)1.0 - sy)
+            );
         }
 
 
@@ -367,18 +533,43 @@ namespace Space2D {
          *           |        |     ->    \         \
          *           |________|            \_________\  
          * 
+         * the shear happens in the local coordinate space, before the existing
+         * transformations, so this is equivalent to postshear
          * @param sx the x scale factor
          * @param sy the y scale factor
          * @param center optionally set the center of the transformation
          * @return the transformed matrix
         */
-        constexpr Mat3& shear(const T sx, const T sy, Point2<T> center = Point2<T>()) noexcept {
-            center *= -1;
+        constexpr Mat3& shear(const T sx, const T sy, const Point2<T>& center = Point2<T>()) noexcept {
+            return postshear(sx, sy, center);
+        }
 
-            return((*this) *= Mat3(
+        /**
+         * @brief shear the matrix in the parent coordinate space, Mat3 = Sh * Mat3
+         * @param sx the x scale factor
+         * @param sy the y scale factor
+         * @param center optionally set the center of the transformation
+         * @return the transformed matrix
+        */
+        constexpr Mat3& preshear(const T sx, const T sy, const Point2<T>& center = Point2<T>()) noexcept {
+            return premultiplyAffine(
                  1, sx, -(center.y * sx),
-                sy,  1,   center.x * sy
-            ));
+                sy,  1, -(center.x * sy)
+            );
+        }
+
+        /**
+         * @brief shear the matrix in the local coordinate space, Mat3 = Mat3 * Sh
+         * @param sx the x scale factor
+         * @param sy the y scale factor
+         * @param center optionally set the center of the transformation
+         * @return the transformed matrix
+        */
+        constexpr Mat3& postshear(const T sx, const T sy, const Point2<T>& center = Point2<T>()) noexcept {
+            return postmultiplyAffine(
+                 1, sx, -(center.y * sx),
+                sy,  1, -(center.x * sy)
+            );
         }
 
         /**
@@ -419,9 +610,9 @@ namespace Space2D {
 
 
             (*this) *= (Mat3(
-                b * b - a * a, -2 * a * b, -2 * a * c,
-                -2 * a * b, a * a - b * b, -2 * b * c
-            ) * (1 / lineSlope.magSquared()));
+                b * b - a * a, (T)-2.0 * a * b, (T)-2.0 * a * c,
+                (T)-2.0 * a * b, a * a - b * b, (T)-2.0 * b * c
+            ) * ((T)1.0 / lineSlope.magSquared()));
 
 
             return *this;
@@ -434,7 +625,7 @@ namespace Space2D {
          * @return the transformed matrix
         */
         constexpr Mat3& orthProj(const Vec2<T>& lineSlope, const Point2<T>& intercept = Point2<T>()) noexcept {
-            NormVec2<T> v = lineSlope.Normalize();
+            NormVec2<T> v = lineSlope.normalize();
 
             auto a = -lineSlope.y;
             auto b = lineSlope.x;
@@ -451,10 +642,11 @@ namespace Space2D {
 
             auto d = abs<T>(a * intercept.x + b * intercept.y + c) / sqrt<T>(a * a + b * b);
 
-            auto transVal = lineSlope.unitNormal() * d;
+            NormVec2<T> normal = lineSlope.unitNormal();
+            Vec2<T> transVal(normal.x * d, normal.y * d);
 
-            if (c > 0) {
-                transVal *= -1;
+            if (c > (T)0.0) {
+                transVal = -transVal;
             }
 
             (*this) *= (Mat3(
@@ -556,6 +748,52 @@ namespace Space2D {
 
         }
 
+    private:
+
+        /**
+         * @brief Mat3 = A * Mat3 where A is the affine matrix [a b tx; c d ty; 0 0 1]
+         * @details only the top two rows change, 18 multiplies instead of a full product
+        */
+        constexpr Mat3& premultiplyAffine(
+            const T& a, const T& b, const T& tx,
+            const T& c, const T& d, const T& ty) noexcept {
+
+            //[0 3 6]
+            //[1 4 7]
+            //[2 5 8]
+
+            for (size_t col = 0; col < 9; col += 3) {
+                T r0 = matrix[col];
+                T r1 = matrix[col + 1];
+                T r2 = matrix[col + 2];
+                matrix[col]     = a * r0 + b * r1 + tx * r2;
+                matrix[col + 1] = c * r0 + d * r1 + ty * r2;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Mat3 = Mat3 * A where A is the affine matrix [a b tx; c d ty; 0 0 1]
+         * @details each column is a combination of the existing columns, 18 multiplies instead of a full product
+        */
+        constexpr Mat3& postmultiplyAffine(
+            const T& a, const T& b, const T& tx,
+            const T& c, const T& d, const T& ty) noexcept {
+
+            //[0 3 6]
+            //[1 4 7]
+            //[2 5 8]
+
+            for (size_t row = 0; row < 3; row++) {
+                T c0 = matrix[row];
+                T c1 = matrix[row + 3];
+                matrix[row]     = c0 * a  + c1 * c;
+                matrix[row + 3] = c0 * b  + c1 * d;
+                matrix[row + 6] = c0 * tx + c1 * ty + matrix[row + 6];
+            }
+            return *this;
+        }
+
 #undef _a
 #undef _b
 #undef _tx
@@ -31,9 +31,11 @@ namespace Space2D {
          * @brief Construct a NormVec2 from a radian angle value
          * @param radians the angle to construct the NormVec2 of
         */
-        constexpr explicit NormVec2(const Radians radians) noexcept : 
-            x(std::cos(radians.get())), 
-            y(std::sin(radians.get())) {}
+        constexpr explicit NormVec2(const Radians radians) noexcept {
+            const SinCos sc = sincos(radians);
+            x = (T)sc.cos;
+            y = (T)sc.sin;
+        }
 
         /**
 		 * @brief (x, y) -> (-x, -y)
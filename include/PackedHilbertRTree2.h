@@ -0,0 +1,433 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "S2DInlineVec.h"
+#include "S2DCallback.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Rect2;
+    template<typename T>
+    class Poly2;
+
+    namespace detail {
+
+        /**
+         * @brief Computes the index of a cell along the Hilbert curve through a 65536 x 65536 grid
+         * @details branch free, each step folds the quadrant transforms of a whole level of the
+         * curve into the bits of all levels at once
+         * @param x the column of the cell, below 65536
+         * @param y the row of the cell, below 65536
+         * @return the position of the cell along the curve
+        */
+        constexpr std::uint32_t hilbertIndex(const std::uint32_t x, const std::uint32_t y) noexcept {
+            std::uint32_t a = x ^ y;
+            std::uint32_t b = 0xFFFF ^ a;
+            std::uint32_t c = 0xFFFF ^ (x | y);
+            std::uint32_t d = x & (y ^ 0xFFFF);
+
+            std::uint32_t A = a | (b >> 1);
+            std::uint32_t B = (a >> 1) ^ a;
+            std::uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+            std::uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+            a = A; b = B; c = C; d = D;
+            A = (a & (a >> 2)) ^ (b & (b >> 2));
+            B = (a & (b >> 2)) ^ (b & ((a ^ b) >> 2));
+            C ^= (a & (c >> 2)) ^ (b & (d >> 2));
+            D ^= (b & (c >> 2)) ^ ((a ^ b) & (d >> 2));
+
+            a = A; b = B; c = C; d = D;
+            A = (a & (a >> 4)) ^ (b & (b >> 4));
+            B = (a & (b >> 4)) ^ (b & ((a ^ b) >> 4));
+            C ^= (a & (c >> 4)) ^ (b & (d >> 4));
+            D ^= (b & (c >> 4)) ^ ((a ^ b) & (d >> 4));
+
+            a = A; b = B; c = C; d = D;
+            C ^= (a & (c >> 8)) ^ (b & (d >> 8));
+            D ^= (b & (c >> 8)) ^ ((a ^ b) & (d >> 8));
+
+            a = C ^ (C >> 1);
+            b = D ^ (D >> 1);
+
+            std::uint32_t i0 = x ^ y;
+            std::uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+            i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+            i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+            i0 = (i0 | (i0 << 2)) & 0x33333333;
+            i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+            i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+            i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+            i1 = (i1 | (i1 << 2)) & 0x33333333;
+            i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+            return (i1 << 1) | i0;
+        }
+    }
+
+    /**
+     * @brief Immutable R-tree bulk loaded in Hilbert order and packed into flat arrays
+     * @details The items are sorted by the Hilbert index of their bounding box centers, which
+     * keeps neighbouring items together, then grouped nodeSize at a time into the level above,
+     * until a single root remains. Every level is stored one after the other in one array of
+     * boxes and one array of indices, leaves first, so a node is just a run of nodeSize entries
+     * and the tree holds no pointers at all.
+     *
+     * Since the tree is nothing but those arrays, serialize() writes it to a single buffer and
+     * deserialize() restores it with a couple of copies, without rebuilding anything.
+     * Item ids are the indices of the geometry passed to the constructor
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    class PackedHilbertRTree2
+    {
+    public:
+
+        /**
+         * @brief index of an item in the geometry the tree was built from
+        */
+        using ItemId = std::uint32_t;
+
+        /**
+         * @brief the number of children per node used when none is given
+        */
+        static constexpr size_t defaultNodeSize = 16;
+
+        /**
+         * @brief Constructs an empty PackedHilbertRTree2
+        */
+        PackedHilbertRTree2() noexcept = default;
+
+        /**
+         * @brief Bulk loads a PackedHilbertRTree2 from a set of bounding boxes
+         * @param bounds the bounds of each item, item ids are indices into this
+         * @param nodeSize the number of children per node, at least 2
+        */
+        explicit PackedHilbertRTree2(std::span<const Rect2<T>> bounds, const size_t nodeSize = defaultNodeSize) {
+            build(std::vector<Rect2<T>>(bounds.begin(), bounds.end()), nodeSize);
+        }
+
+        /**
+         * @brief Bulk loads a PackedHilbertRTree2 from a set of polygons, using their bounding boxes
+         * @param polys the polygons, item ids are indices into this
+         * @param nodeSize the number of children per node, at least 2
+        */
+        explicit PackedHilbertRTree2(std::span<const Poly2<T>> polys, const size_t nodeSize = defaultNodeSize) {
+            std::vector<Rect2<T>> bounds;
+            bounds.reserve(polys.size());
+            for (const auto& poly : polys) {
+                bounds.push_back(poly.getAABB());
+            }
+            build(std::move(bounds), nodeSize);
+        }
+
+        /**
+         * @brief Returns the number of items
+         * @return the number of items
+        */
+        size_t size() const noexcept {
+            return itemCount;
+        }
+
+        /**
+         * @brief Checks if the tree holds no items
+         * @return true if there are no items
+        */
+        bool empty() const noexcept {
+            return itemCount == 0;
+        }
+
+        /**
+         * @brief Returns the number of children per node
+         * @return the node size
+        */
+        size_t getNodeSize() const noexcept {
+            return nodeSize;
+        }
+
+        /**
+         * @brief Returns the bounds of all items
+         * @return the bounds of the root, or a default Rect2 if the tree is empty
+        */
+        Rect2<T> getBounds() const noexcept {
+            return boxes.empty() ? Rect2<T>() : boxes.back();
+        }
+
+        /**
+         * @brief Reports every item whose bounds intersect a region, touching faces included
+         * @param region the region to query
+         * @param callback invoked with the id of each item found, may return false to stop the query
+        */
+        template<typename Callback>
+        void query(const Rect2<T>& region, Callback&& callback) const {
+            search([&](const Rect2<T>& b) { return b.intersects(region); }, callback);
+        }
+
+        /**
+         * @brief Reports every item whose bounds contain a point
+         * @details follows Rect2::contains, so points on the faces of an item do not count
+         * @param p the point to locate
+         * @param callback invoked with the id of each item found, may return false to stop the query
+        */
+        template<typename Callback>
+        void queryPoint(const Point2<T>& p, Callback&& callback) const {
+            search([&](const Rect2<T>& b) { return b.contains(p); }, callback);
+        }
+
+        /**
+         * @brief Reports every item whose bounds are hit by a ray
+         * @details the ray covers origin + direction * t for t in [0, maxFraction]
+         * @param origin the start of the ray
+         * @param direction the direction of the ray, need not be normalized
+         * @param maxFraction how far along direction the ray extends
+         * @param callback invoked with the id of each item hit, may return false to stop the query
+        */
+        template<typename Callback>
+        void rayQuery(const Point2<T>& origin, const Vec2<T>& direction, const T& maxFraction, Callback&& callback) const {
+            search([&](const Rect2<T>& b) { return b.intersectsSegment(origin, direction, maxFraction); }, callback);
+        }
+
+        /**
+         * @brief Writes the tree to a buffer
+         * @details the buffer uses the native byte order and layout of T, so it can only be
+         * read back by a build with the same coordinate type on the same kind of platform
+         * @return the buffer holding the tree
+        */
+        std::vector<std::byte> serialize() const {
+            static_assert(std::is_trivially_copyable_v<Rect2<T>>, "PackedHilbertRTree2 can only serialize trivially copyable coordinates");
+
+            Header header;
+            header.nodeSize = static_cast<std::uint32_t>(nodeSize);
+            header.itemCount = static_cast<std::uint32_t>(itemCount);
+            header.levelCount = static_cast<std::uint32_t>(levelEnds.size());
+
+            std::vector<std::byte> buffer(sizeof(Header) + levelEnds.size() * sizeof(std::uint32_t) +
+                boxes.size() * (sizeof(Rect2<T>) + sizeof(ItemId)));
+
+            std::byte* out = buffer.data();
+            out = write(out, &header, sizeof(Header));
+            out = write(out, levelEnds.data(), levelEnds.size() * sizeof(std::uint32_t));
+            out = write(out, boxes.data(), boxes.size() * sizeof(Rect2<T>));
+            write(out, indices.data(), indices.size() * sizeof(ItemId));
+            return buffer;
+        }
+
+        /**
+         * @brief Restores a tree written by serialize()
+         * @details the buffer is checked to describe a well formed tree, so a truncated or
+         * corrupted file is rejected rather than queried
+         * @param buffer the buffer holding the tree
+         * @return the restored tree
+        */
+        static PackedHilbertRTree2 deserialize(std::span<const std::byte> buffer) {
+            static_assert(std::is_trivially_copyable_v<Rect2<T>>, "PackedHilbertRTree2 can only serialize trivially copyable coordinates");
+
+            Header header;
+            if (buffer.size() < sizeof(Header)) throw std::logic_error("PackedHilbertRTree2 buffer is truncated");
+            std::memcpy(&header, buffer.data(), sizeof(Header));
+
+            Header expected;
+            if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version) {
+                throw std::logic_error("PackedHilbertRTree2 buffer is not a packed Hilbert R-tree");
+            }
+            if (header.coordSize != expected.coordSize) throw std::logic_error("PackedHilbertRTree2 buffer was written with another coordinate type");
+            if (header.nodeSize < 2) throw std::logic_error("PackedHilbertRTree2 buffer is corrupted");
+
+            PackedHilbertRTree2 tree;
+            tree.nodeSize = header.nodeSize;
+            tree.itemCount = header.itemCount;
+
+            size_t offset = sizeof(Header);
+            size_t levelBytes = static_cast<size_t>(header.levelCount) * sizeof(std::uint32_t);
+            if (buffer.size() - offset < levelBytes) throw std::logic_error("PackedHilbertRTree2 buffer is truncated");
+            tree.levelEnds.resize(header.levelCount);
+            std::memcpy(tree.levelEnds.data(), buffer.data() + offset, levelBytes);
+            offset += levelBytes;
+
+            if (!tree.validLevels()) throw std::logic_error("PackedHilbertRTree2 buffer is corrupted");
+
+            size_t total = tree.levelEnds.empty() ? 0 : tree.levelEnds.back();
+            if (buffer.size() - offset != total * (sizeof(Rect2<T>) + sizeof(ItemId))) {
+                throw std::logic_error("PackedHilbertRTree2 buffer size does not match its header");
+            }
+            tree.boxes.resize(total);
+            std::memcpy(tree.boxes.data(), buffer.data() + offset, total * sizeof(Rect2<T>));
+            offset += total * sizeof(Rect2<T>);
+            tree.indices.resize(total);
+            std::memcpy(tree.indices.data(), buffer.data() + offset, total * sizeof(ItemId));
+
+            if (!tree.validIndices()) throw std::logic_error("PackedHilbertRTree2 buffer is corrupted");
+            return tree;
+        }
+
+    private:
+
+        struct Header {
+            char magic[4] = { 'S', '2', 'H', 'R' };
+            std::uint32_t version = 1;
+            std::uint32_t coordSize = sizeof(T);
+            std::uint32_t nodeSize = 0;
+            std::uint32_t itemCount = 0;
+            std::uint32_t levelCount = 0;
+        };
+
+        static std::byte* write(std::byte* out, const void* data, const size_t bytes) noexcept {
+            if (bytes != 0) std::memcpy(out, data, bytes);
+            return out + bytes;
+        }
+
+        void build(std::vector<Rect2<T>> bounds, const size_t nodeSize) {
+            if (nodeSize < 2) throw std::logic_error("PackedHilbertRTree2 nodes need at least 2 children");
+            if (bounds.size() >= std::numeric_limits<ItemId>::max() / 2) throw std::length_error("PackedHilbertRTree2 has too many items");
+
+            this->nodeSize = nodeSize;
+            itemCount = bounds.size();
+            if (bounds.empty()) return;
+
+            Rect2<T> world = bounds[0];
+            for (const auto& b : bounds) {
+                world = world.combine(b);
+            }
+            double width = static_cast<double>(world.max.x - world.min.x);
+            double height = static_cast<double>(world.max.y - world.min.y);
+            double scaleX = width > 0.0 ? 65535.0 / width : 0.0;
+            double scaleY = height > 0.0 ? 65535.0 / height : 0.0;
+
+            //sort by (hilbert index, item) packed into one integer
+            std::vector<std::uint64_t> keys(bounds.size());
+            for (size_t i = 0; i < bounds.size(); i++) {
+                Point2<T> c = bounds[i].center();
+                auto hx = static_cast<std::uint32_t>(static_cast<double>(c.x - world.min.x) * scaleX);
+                auto hy = static_cast<std::uint32_t>(static_cast<double>(c.y - world.min.y) * scaleY);
+                keys[i] = (static_cast<std::uint64_t>(detail::hilbertIndex(hx, hy)) << 32) | i;
+            }
+            std::sort(keys.begin(), keys.end());
+
+            size_t total = bounds.size();
+            for (size_t count = bounds.size(); count > 1; ) {
+                count = (count + nodeSize - 1) / nodeSize;
+                total += count;
+            }
+            boxes.reserve(total);
+            indices.reserve(total);
+
+            for (std::uint64_t key : keys) {
+                auto id = static_cast<ItemId>(key & 0xFFFFFFFFu);
+                boxes.push_back(bounds[id]);
+                indices.push_back(id);
+            }
+            levelEnds.push_back(static_cast<std::uint32_t>(boxes.size()));
+
+            //each level groups nodeSize entries of the level below, pointing at the first of them
+            size_t levelStart = 0;
+            while (levelEnds.back() - levelStart > 1) {
+                size_t levelEnd = levelEnds.back();
+                for (size_t node = levelStart; node < levelEnd; node += nodeSize) {
+                    Rect2<T> box = boxes[node];
+                    for (size_t i = node + 1; i < std::min(node + nodeSize, levelEnd); i++) {
+                        box = box.combine(boxes[i]);
+                    }
+                    boxes.push_back(box);
+                    indices.push_back(static_cast<std::uint32_t>(node));
+                }
+                levelStart = levelEnd;
+                levelEnds.push_back(static_cast<std::uint32_t>(boxes.size()));
+            }
+        }
+
+        template<typename Overlaps, typename Callback>
+        void search(Overlaps&& overlaps, Callback& callback) const {
+            if (boxes.empty()) return;
+
+            //each entry is the first slot of a node and the level the node is on
+            InlineVec<std::pair<std::uint32_t, std::uint32_t>, 128> stack;
+            stack.push_back({ static_cast<std::uint32_t>(boxes.size() - 1), static_cast<std::uint32_t>(levelEnds.size() - 1) });
+
+            while (!stack.empty()) {
+                auto [node, level] = stack.back();
+                stack.pop_back();
+
+                size_t end = std::min<size_t>(node + nodeSize, levelEnds[level]);
+                for (size_t i = node; i < end; i++) {
+                    if (!overlaps(boxes[i])) continue;
+                    if (level == 0) {
+                        if (!detail::invokeContinue(callback, indices[i])) return;
+                    }
+                    else {
+                        stack.push_back({ indices[i], level - 1 });
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief checks the level ends describe the levels build() would have made
+        */
+        bool validLevels() const noexcept {
+            if (itemCount == 0) return levelEnds.empty();
+            if (levelEnds.empty() || levelEnds[0] != itemCount) return false;
+
+            size_t start = 0;
+            for (size_t level = 1; level < levelEnds.size(); level++) {
+                size_t count = levelEnds[level - 1] - start;
+                if (count <= 1 || levelEnds[level] <= levelEnds[level - 1]) return false;
+                if (levelEnds[level] - levelEnds[level - 1] != (count + nodeSize - 1) / nodeSize) return false;
+                start = levelEnds[level - 1];
+            }
+            return levelEnds.back() - start == 1;
+        }
+
+        /**
+         * @brief checks every leaf names an item and every node points at the start of a node below it
+        */
+        bool validIndices() const noexcept {
+            if (itemCount == 0) return true;
+            for (size_t i = 0; i < itemCount; i++) {
+                if (indices[i] >= itemCount) return false;
+            }
+
+            size_t start = itemCount;
+            size_t below = 0;
+            for (size_t level = 1; level < levelEnds.size(); level++) {
+                for (size_t i = start; i < levelEnds[level]; i++) {
+                    if (indices[i] != below + (i - start) * nodeSize) return false;
+                }
+                below = start;
+                start = levelEnds[level];
+            }
+            return true;
+        }
+
+        size_t nodeSize = defaultNodeSize;
+        size_t itemCount = 0;
+
+        /**
+         * @brief the end of each level in boxes and indices, leaves first
+        */
+        std::vector<std::uint32_t> levelEnds;
+
+        /**
+         * @brief the bounds of every entry on every level
+        */
+        std::vector<Rect2<T>> boxes;
+
+        /**
+         * @brief the item of a leaf entry, or the first child of a node entry
+        */
+        std::vector<ItemId> indices;
+    };
+}
@@ -4,14 +4,14 @@
 #ifndef S2D_POINT_2D_OPERATOR
 #define S2D_POINT_2D_OPERATOR
 #define S2D_POINT_2D_OP_EQ(op, typ2d) \
-    constexpr inline Point2& operator##op(const typ2d<T>& rhs) noexcept {\
+    constexpr inline Point2& operator op(const typ2d<T>& rhs) noexcept {\
     x op rhs.x;\
     y op rhs.y;\
     return (*this);\
 	}
 
 #define S2D_POINT_2D_OP(op, typ2d) \
-	constexpr inline Point2 operator##op(const typ2d<T>& rhs) const noexcept { \
+	constexpr inline Point2 operator op(const typ2d<T>& rhs) const noexcept { \
     return Point2(x op rhs.x, y op rhs.y);\
 	}
 #endif
@@ -19,14 +19,14 @@
 #ifndef S2D_POINT_1D_OPERATOR
 #define S2D_POINT_1D_OPERATOR
 #define S2D_POINT_1D_OP_EQ(op) \
-    constexpr inline Point2& operator##op(const T& rhs) noexcept {\
+    constexpr inline Point2& operator op(const T& rhs) noexcept {\
     x op rhs;\
     y op rhs;\
     return (*this);\
 	}
 
 #define S2D_POINT_1D_OP(op) \
-	constexpr inline Point2 operator##op(const T& rhs) const noexcept { \
+	constexpr inline Point2 operator op(const T& rhs) const noexcept { \
     return Point2(x op rhs, y op rhs);\
 	}
 #endif
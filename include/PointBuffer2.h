@@ -0,0 +1,235 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <ostream>
+#include <typeinfo>
+#include <stdexcept>
+#include <initializer_list>
+#include "S2DSimd.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Mat3;
+
+    /**
+     * @brief Structure of arrays container for large sets of 2 Dimensional points
+     * @details Stores the x and y coordinates of every point in two separate, contiguous
+     * and SIMD aligned arrays instead of an array of Point2's, so that batch operations
+     * such as Mat3::transformBatch can process many points per instruction. Points are
+     * read and written by value, since no Point2 actually exists inside the buffer
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    class PointBuffer2
+    {
+    public:
+
+        /**
+         * @brief The aligned array type used for each coordinate
+        */
+        using CoordArray = std::vector<T, AlignedAllocator<T>>;
+
+        /**
+         * @brief Constructs an empty PointBuffer2
+        */
+        PointBuffer2() noexcept = default;
+
+        /**
+         * @brief Constructs a PointBuffer2 of count points, all at (0,0)
+         * @param count the number of points
+        */
+        explicit PointBuffer2(const size_t count) : xs(count), ys(count) {}
+
+        /**
+         * @brief Constructs a PointBuffer2 from a vector of points
+         * @param points the points to construct from
+        */
+        explicit PointBuffer2(const std::vector<Point2<T>>& points) {
+            reserve(points.size());
+            for (const auto& p : points) {
+                push_back(p);
+            }
+        }
+
+        /**
+         * @brief Constructs a PointBuffer2 from an initializer list of points
+         * @param list the points to construct from
+        */
+        explicit PointBuffer2(const std::initializer_list<Point2<T>>& list) {
+            reserve(list.size());
+            for (const auto& p : list) {
+                push_back(p);
+            }
+        }
+
+        /**
+         * @brief Returns the number of points in the PointBuffer2
+         * @return the number of points
+        */
+        size_t size() const noexcept {
+            return xs.size();
+        }
+
+        /**
+         * @brief Checks if the PointBuffer2 holds no points
+         * @return true if there are no points
+        */
+        bool empty() const noexcept {
+            return xs.empty();
+        }
+
+        /**
+         * @brief Reserves storage for at least count points
+         * @param count the number of points to reserve for
+        */
+        void reserve(const size_t count) {
+            xs.reserve(count);
+            ys.reserve(count);
+        }
+
+        /**
+         * @brief Resizes the PointBuffer2, new points are placed at (0,0)
+         * @param count the new number of points
+        */
+        void resize(const size_t count) {
+            xs.resize(count);
+            ys.resize(count);
+        }
+
+        /**
+         * @brief Removes all points, keeping the allocated storage
+        */
+        void clear() noexcept {
+            xs.clear();
+            ys.clear();
+        }
+
+        /**
+         * @brief Appends a point to the end of the PointBuffer2
+         * @param p the point to append
+        */
+        void push_back(const Point2<T>& p) {
+            xs.push_back(p.x);
+            ys.push_back(p.y);
+        }
+
+        /**
+         * @brief Reads the point at the supplied index
+         * @param i The index
+         * @return a copy of the point
+        */
+        Point2<T> operator[] (const size_t i) const {
+            if (i >= size()) throw std::out_of_range("PointBuffer2 subscript out of range");
+            return Point2<T>(xs[i], ys[i]);
+        }
+
+        /**
+         * @brief Overwrites the point at the supplied index
+         * @param i The index
+         * @param p The new point
+        */
+        void set(const size_t i, const Point2<T>& p) {
+            if (i >= size()) throw std::out_of_range("PointBuffer2 subscript out of range");
+            xs[i] = p.x;
+            ys[i] = p.y;
+        }
+
+        /**
+         * @brief Raw access to the x coordinate array
+         * @return a pointer to the first x coordinate, aligned to simdAlignment
+        */
+        T* xData() noexcept {
+            return xs.data();
+        }
+
+        /**
+         * @brief Raw access to the x coordinate array
+         * @return a read only pointer to the first x coordinate, aligned to simdAlignment
+        */
+        const T* xData() const noexcept {
+            return xs.data();
+        }
+
+        /**
+         * @brief Raw access to the y coordinate array
+         * @return a pointer to the first y coordinate, aligned to simdAlignment
+        */
+        T* yData() noexcept {
+            return ys.data();
+        }
+
+        /**
+         * @brief Raw access to the y coordinate array
+         * @return a read only pointer to the first y coordinate, aligned to simdAlignment
+        */
+        const T* yData() const noexcept {
+            return ys.data();
+        }
+
+        /**
+         * @brief Copies the points back out into an array of Point2's
+         * @return the points of the PointBuffer2
+        */
+        std::vector<Point2<T>> toPoints() const {
+            std::vector<Point2<T>> points;
+            points.reserve(size());
+            for (size_t i = 0; i < size(); i++) {
+                points.push_back(Point2<T>(xs[i], ys[i]));
+            }
+            return points;
+        }
+
+        /**
+         * @brief Equality operator for PointBuffer2
+         * @param other The PointBuffer2 to compare with
+         * @return true if both buffers hold the same points in the same order
+        */
+        bool operator==(const PointBuffer2& other) const noexcept {
+            if (size() != other.size()) return false;
+            for (size_t i = 0; i < size(); i++) {
+                if (Point2<T>(xs[i], ys[i]) != Point2<T>(other.xs[i], other.ys[i])) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Prints the PointBuffer2
+         * @param os Input stream
+         * @param it The PointBuffer2 to print
+         * @return a reference to the stream for << chaining
+        */
+        friend std::ostream& operator << (std::ostream& os, const PointBuffer2& it) {
+            std::string typname = typeid(T).name();
+            std::string::size_type i = typname.find("struct");
+            if (i != std::string::npos) {
+                typname.erase(i, 7);
+            }
+            i = typname.find("class");
+            if (i != std::string::npos) {
+                typname.erase(i, 6);
+            }
+
+            os << "PointBuffer2<" << typname << ">[size = " << it.size() << "]{\n";
+            for (size_t i = 0; i < it.size(); i++) {
+                os << "(" << it.xs[i] << ", " << it.ys[i] << "),\n";
+            }
+            os << "}";
+            return os;
+        }
+
+    private:
+
+        /**
+         * @brief the x coordinates of the points
+        */
+        CoordArray xs;
+
+        /**
+         * @brief the y coordinates of the points
+        */
+        CoordArray ys;
+    };
+}
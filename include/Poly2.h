@@ -2,30 +2,38 @@
 #include <initializer_list>
 #include "Space2D.h"
 #include <vector>
+#include <array>
 #include <algorithm>
+#include <span>
+#include <cstdint>
 #include "S2DMath.h"
+#include "Rot2.h"
 #include "S2DIterator.h"
+#include "S2DInlineVec.h"
+#include "S2DTags.h"
+#include "S2DSimd.h"
+
+#ifndef S2D_POLY_INLINE_POINTS
+#define S2D_POLY_INLINE_POINTS 8
+#endif
 
 #ifndef S2D_POLY_2D_OPERATOR
 #define S2D_POLY_2D_OPERATOR
 #define S2D_POLY_2D_OP_EQ(op, typ2d) \
-    constexpr inline Poly2& operator##op(const typ2d<T>& rhs) noexcept {\
-	std::for_each(begin(), end(), [&rhs](auto& a) {\
+    constexpr inline Poly2& operator op(const typ2d<T>& rhs) noexcept {\
+	std::for_each(points.begin(), points.end(), [&rhs](auto& a) {\
 		    a op rhs;\
 		}\
 	);\
+    offsetCache([&rhs](Point2<T>& a) { a op rhs; });\
     return (*this);\
 	}
 
 #define S2D_POLY_2D_OP(op, typ2d) \
-	constexpr inline Poly2 operator##op(const typ2d<T>& rhs) const noexcept { \
-        std::vector<Point2<T>> points;\
-        points.reserve(size());\
-	    std::for_each(cbegin(), cend(), [&rhs, &points](auto& a) {\
-                 points.push_back(a op rhs);\
-		    }\
-	    );\
-        return Poly2(points);\
+	constexpr inline Poly2 operator op(const typ2d<T>& rhs) const { \
+        Poly2 result = mapAffine([&rhs](const Point2<T>& a) { return a op rhs; });\
+        result.adoptOffsetCache(*this, [&rhs](Point2<T>& a) { a = a op rhs; });\
+        return result;\
 	}
 #endif
 
@@ -43,6 +51,29 @@ namespace Space2D {
     class Rect2;
     template<typename T>
     class Mat3;
+    template<typename T>
+    class Rot2;
+
+    namespace detail {
+
+        /**
+         * @brief determines the winding of a convex polygon from its first non degenerate corner
+         * @return 1 for counter clockwise points, -1 for clockwise points
+        */
+        template<typename T>
+        constexpr T windingSign(const Point2<T>* points, const size_t count) noexcept {
+            for (size_t i = 0; i < count; i++) {
+                const Point2<T>& a = points[i];
+                const Point2<T>& b = points[(i + 1) % count];
+                const Point2<T>& c = points[(i + 2) % count];
+                T turn = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+                if (turn != (T)0.0) {
+                    return turn > (T)0.0 ? (T)1.0 : (T)-1.0;
+                }
+            }
+            return (T)1.0;
+        }
+    }
 
     /**
      * @brief Class encapsulating a 2 Dimensional convex polygon representation
@@ -51,6 +82,9 @@ namespace Space2D {
      * concavity is also checked when attempting to compute the centroid or the area, as
      * these functions require the polygon to be concave to work properly, they will throw if
      * the polygon is unexpectedly concave
+     *
+     * The area, centroid, AABB and face normals are computed lazily on first use and cached
+     * until the points really change. Translating the Poly2 updates the cache in place
      * @tparam T the underlying coordinate type of the Poly2
     */
     template<typename T>
@@ -59,6 +93,17 @@ namespace Space2D {
 
     public:
 
+        /**
+         * @brief The point storage of a Poly2, up to S2D_POLY_INLINE_POINTS points
+         * are stored inline so that small polygons never allocate
+        */
+        using PointStorage = InlineVec<Point2<T>, S2D_POLY_INLINE_POINTS>;
+
+        /**
+         * @brief The storage of the cached face normals, sized like PointStorage
+        */
+        using NormalStorage = InlineVec<NormVec2<T>, S2D_POLY_INLINE_POINTS>;
+
         /**
          * @brief Constructs a Poly2 eqivalant to a 
          * Rec2 with min point (0,0) and max point (1,1)
@@ -73,12 +118,51 @@ namespace Space2D {
          * @brief Constructs a Poly2 directly from a vector of points
          * @param points the points to construct from
         */
-        constexpr explicit Poly2(const std::vector<Point2<T>>& points) : points(points) {
+        constexpr explicit Poly2(const std::vector<Point2<T>>& points) : points(points.begin(), points.end()) {
             if (!isConvex()) {
                 throw std::logic_error("Poly2 is not convex");
             }
         }
 
+        /**
+         * @brief Constructs a Poly2 directly from point storage
+         * @param points the points to construct from
+        */
+        constexpr explicit Poly2(const PointStorage& points) : points(points) {
+            if (!isConvex()) {
+                throw std::logic_error("Poly2 is not convex");
+            }
+        }
+
+        /**
+         * @brief Constructs a Poly2 from a vector of points that are already known to be convex
+         * @details the convexity check is skipped, see TrustedConvex
+         * @param points the convex points to construct from
+        */
+        constexpr explicit Poly2(TrustedConvex, const std::vector<Point2<T>>& points)
+            : points(points.begin(), points.end()) {}
+
+        /**
+         * @brief Constructs a Poly2 from point storage that is already known to be convex
+         * @details the convexity check is skipped, see TrustedConvex
+         * @param points the convex points to construct from
+        */
+        constexpr explicit Poly2(TrustedConvex, const PointStorage& points) : points(points) {}
+
+        /**
+         * @brief Constructs a Poly2 from point storage that is already known to be convex
+         * @details the convexity check is skipped, see TrustedConvex
+         * @param points the convex points to take over
+        */
+        constexpr explicit Poly2(TrustedConvex, PointStorage&& points) noexcept : points(std::move(points)) {}
+
+        /**
+         * @brief Constructs a Poly2 from an initializer list of points that are already known to be convex
+         * @details the convexity check is skipped, see TrustedConvex
+         * @param list the convex points to construct from
+        */
+        constexpr explicit Poly2(TrustedConvex, const std::initializer_list<Point2<T>>& list) : points(list) {}
+
         /**
          * @brief Constructs a Poly2 from an initializer list of points 
          * @details Constructs a Poly2 from an initializer list of points,
@@ -137,7 +221,7 @@ namespace Space2D {
         template<typename... Args,
             typename = std::enable_if_t<sizeof...(Args) % 2 == 0 && sizeof...(Args) >= 2 && are_all_convertible<T, Args...>::value>>
         constexpr explicit Poly2(Args... pts) {
-            std::vector<T> pointvals{ (T)pts ... };
+            std::array<T, sizeof...(Args)> pointvals{ (T)pts ... };
             points.resize(pointvals.size() / 2);
             for (size_t i = 0; i < pointvals.size(); i += 2) {
                 points.at(i / 2) = Point2<T>(pointvals.at(i), pointvals.at(i + 1));
@@ -156,7 +240,7 @@ namespace Space2D {
          * @param points0_to_1 the list of points (0,0) to (1,1)
          * @param quadDim the rectangular dimension to construct the polygon inside
         */
-        constexpr explicit Poly2(const std::vector<Point2<T>>& points0_to_1, const Rect2<T>& quadDim) : points(points0_to_1) {
+        constexpr explicit Poly2(const std::vector<Point2<T>>& points0_to_1, const Rect2<T>& quadDim) : points(points0_to_1.begin(), points0_to_1.end()) {
             auto len = points.size();
             for (size_t i = 0; i < len; i++) {
                 auto& p = points.at(i);
@@ -179,13 +263,10 @@ namespace Space2D {
          * conversion functions
         */
         constexpr explicit Poly2(const Rect2<T>& quadDim) 
-            : Poly2({ Point2<T>(0,0), Point2<T>(0,1), Point2<T>(1,1), Point2<T>(1,0) }, 
-                quadDim) {
-
-            if (!isConvex()) {
-                throw std::logic_error("Poly2 is not convex");
-            }
+            : points{ quadDim.min, Point2<T>(quadDim.min.x, quadDim.max.y), 
+                quadDim.max, Point2<T>(quadDim.max.x, quadDim.min.y) } {
 
+            //a rectangle is always convex, no check needed
         }
 
         /**
@@ -264,6 +345,49 @@ namespace Space2D {
             return points == other.points;
         }
 
+        /**
+         * @brief Replaces the points of the Poly2 with points that are already known to be convex
+         * @details the convexity check is skipped, see TrustedConvex. The point storage is emptied
+         * and handed to fill, keeping any heap capacity, so refilling a Poly2 that has held as many
+         * points before allocates nothing
+         * @param fill called with the emptied point storage, appends the new points to it
+        */
+        template<typename Fill>
+        constexpr void refill(TrustedConvex, Fill&& fill) {
+            dirty = false;
+            cache.reset();
+            cache.checkConvex = false;
+            points.clear();
+            fill(points);
+        }
+
+        /**
+         * @brief Builds the Poly2 made of every point passed through an affine map
+         * @details an affine map can't make a convex polygon concave, so the result is not
+         * checked again, but a convexity check still pending on this Poly2, after its points
+         * were edited, carries over to the result and throws from its first query instead
+         * @param map returns the image of a single point
+         * @return the mapped Poly2, without any cached values
+        */
+        template<typename Map>
+        constexpr Poly2 mapAffine(Map&& map) const {
+            PointStorage newPoints(size());
+            for (size_t i = 0; i < size(); i++) {
+                newPoints[i] = map(points[i]);
+            }
+            Poly2 result(trustedConvex, std::move(newPoints));
+            result.cache.checkConvex = dirty || cache.checkConvex;
+            return result;
+        }
+
+        /**
+         * @brief Read only access to the underlying point storage
+         * @return a reference to the points of the Poly2
+        */
+        constexpr const PointStorage& getPoints() const noexcept {
+            return points;
+        }
+
         /**
          * @brief Returns the size of the Poly2, or number of points
          * @return the number of points
@@ -375,11 +499,10 @@ namespace Space2D {
         */
         constexpr const Point2<T> centroid() const {
 
-            if (dirty) {
-                if (!isConvex()) {
-                    throw std::logic_error("Poly2 is not convex");
-                }
-                dirty = false;
+            syncCache();
+            requireConvex();
+            if (cache.hasCentroid) {
+                return cache.centroid;
             }
 
             Point2<T> cent;
@@ -389,10 +512,10 @@ namespace Space2D {
 
             for (size_t i = 0; i < len - 1; i++) {
 
-                double x0 = points[i].x;
-                double y0 = points[i].y;
-                double x1 = points[i + 1].x;
-                double y1 = points[i + 1].y;
+                double x0 = static_cast<double>(points[i].x);
+                double y0 = static_cast<double>(points[i].y);
+                double x1 = static_cast<double>(points[i + 1].x);
+                double y1 = static_cast<double>(points[i + 1].y);
 
                 double A = (x0 * y1) - (x1 * y0);
                 signedArea += A;
@@ -401,10 +524,10 @@ namespace Space2D {
                 cent.y += static_cast<T>((y0 + y1) * A);
             }
 
-            double x0 = points[len - 1].x;
-            double y0 = points[len - 1].y;
-            double x1 = points[0].x;
-            double y1 = points[0].y;
+            double x0 = static_cast<double>(points[len - 1].x);
+            double y0 = static_cast<double>(points[len - 1].y);
+            double x1 = static_cast<double>(points[0].x);
+            double y1 = static_cast<double>(points[0].y);
 
             double A = (x0 * y1) - (x1 * y0);
             signedArea += A;
@@ -416,6 +539,9 @@ namespace Space2D {
             cent.x /= static_cast<T>((6 * signedArea));
             cent.y /= static_cast<T>((6 * signedArea));
 
+            snapshotIfEmpty();
+            cache.centroid = cent;
+            cache.hasCentroid = true;
             return cent;
         }
 
@@ -427,11 +553,7 @@ namespace Space2D {
         */
         constexpr void moveCenterTo(const Point2<T>& newcenter) {
             auto cent = centroid();
-            auto diffVec = Vec2<T>(cent, newcenter);
-            cent = newcenter;
-            for (auto& p : points) {
-                p += diffVec;
-            }
+            (*this) += Vec2<T>(cent, newcenter);
         }
         
         /**
@@ -452,8 +574,27 @@ namespace Space2D {
         */
         constexpr NormVec2<T> getFaceNormal(const size_t i) const {
             if (i >= size()) throw std::out_of_range("Poly2 index out of range");
-            unsigned int j = i < points.size() - 1 ? i + 1 : 0;
-            return Vec2<T>(points[i], points[j]).unitNormal();
+            return getFaceNormals()[i];
+        }
+
+        /**
+         * @brief Computes the normals of every face at once
+         * @details the normals are cached, the reference stays valid until the Poly2 is next modified
+         * @return the face normals, indexed like getFaceNormal
+        */
+        constexpr const NormalStorage& getFaceNormals() const {
+            syncCache();
+            if (!cache.hasNormals) {
+                auto len = points.size();
+                cache.normals.resize(len);
+                for (size_t i = 0; i < len; i++) {
+                    size_t j = i < len - 1 ? i + 1 : 0;
+                    cache.normals[i] = Vec2<T>(points[i], points[j]).unitNormal();
+                }
+                snapshotIfEmpty();
+                cache.hasNormals = true;
+            }
+            return cache.normals;
         }
 
 
@@ -491,11 +632,10 @@ namespace Space2D {
         */
         constexpr T area() const {
 
-            if (dirty) {
-                if (!isConvex()) {
-                    throw std::logic_error("Poly2 is not convex");
-                }
-                dirty = false;
+            syncCache();
+            requireConvex();
+            if (cache.hasArea) {
+                return cache.area;
             }
 
             T a = 0.0;
@@ -507,39 +647,181 @@ namespace Space2D {
                 a += (points[j].x + points[i].x) * (points[j].y - points[i].y);
                 j = i;
             }
-            return abs(a / (T)2.0f);
+
+            snapshotIfEmpty();
+            cache.area = abs(a / (T)2.0f);
+            cache.hasArea = true;
+            return cache.area;
         }
 
         /**
          * @brief Computes the Axis Aligned Bounding Box (AABB) of the Poly2
          * @return the computed AABB
         */
-        constexpr Rect2<T> getAABB() const noexcept {
+        constexpr Rect2<T> getAABB() const {
+            syncCache();
+            if (cache.hasAABB) {
+                return cache.aabb;
+            }
+
             T minx = points[0].x;
             T miny = points[0].y;
             T maxx = points[0].x;
             T maxy = points[0].y;
             auto len = points.size();
             for (size_t i = 1; i < len; i++) {
-                minx = min(minx, points[i].x);
-                maxx = max(maxx, points[i].x);
+                minx = std::min(minx, points[i].x);
+                maxx = std::max(maxx, points[i].x);
 
-                miny = min(miny, points[i].y);
-                maxy = max(maxy, points[i].y);
+                miny = std::min(miny, points[i].y);
+                maxy = std::max(maxy, points[i].y);
             }
-            return Rect<T>(Point2<T>(minx, miny), Point2<T>(maxx, maxy));
+
+            snapshotIfEmpty();
+            cache.aabb = Rect2<T>(Point2<T>(minx, miny), Point2<T>(maxx, maxy));
+            cache.hasAABB = true;
+            return cache.aabb;
         }
 
 
         /**
-         * @brief Rotates the Poly2 by the given radian value
+         * @brief determines if a point is within the Poly2 or not
+         * @details like Rect2::contains, returns false if the point lies on one of the faces
+         * or corners of the Poly2. The Poly2 is split into a fan of triangles around its first
+         * point and the triangle the point falls in is found by binary search, so only
+         * O(log n) faces are tested. Zero length faces left by repeated points are skipped
+         * @param query the Point2 to check
+         * @return true if the query Point2 is within the Poly2
+        */
+        constexpr bool contains(const Point2<T>& query) const {
+            syncCache();
+            requireConvex();
+
+            const size_t len = points.size();
+            if (len < 3) return false;
+            const T sign = detail::windingSign(points.data(), len);
+
+            //positive when query lies strictly on the inner side of the line from a to b
+            auto side = [&](const Point2<T>& a, const Point2<T>& b) {
+                return sign * ((b.x - a.x) * (query.y - a.y) - (b.y - a.y) * (query.x - a.x));
+            };
+
+            //repeats of the first point would make zero length fan edges, so the fan starts past them
+            auto same = [](const Point2<T>& a, const Point2<T>& b) { return a.x == b.x && a.y == b.y; };
+            size_t lo = 1;
+            while (lo < len && same(points[lo], points[0])) lo++;
+            size_t hi = len - 1;
+            while (hi > lo && same(points[hi], points[0])) hi--;
+            if (hi <= lo) return false;
+
+            if (!(side(points[0], points[lo]) > (T)0.0)) return false;
+            if (!(side(points[hi], points[0]) > (T)0.0)) return false;
+
+            while (hi - lo > 1) {
+                size_t mid = (lo + hi) / 2;
+                if (side(points[0], points[mid]) > (T)0.0) {
+                    lo = mid;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+            return side(points[lo], points[hi]) > (T)0.0;
+        }
+
+        /**
+         * @brief determines which of many points are within the Poly2
+         * @details points outside the cached AABB are rejected up front. For float coordinates
+         * and fewer than batchContainsFaces faces the rest are tested against every face several
+         * points at a time, larger Poly2's fall back to the binary search of contains(Point2).
+         * The two tests round differently, so a point within rounding of the boundary may be
+         * inside for one and outside for the other
+         * @param queries the Point2's to check
+         * @param out receives 1 for each point within the Poly2 and 0 for the others,
+         * must be at least as long as queries
+         * @return the number of points within the Poly2
+        */
+        size_t contains(std::span<const Point2<T>> queries, std::span<std::uint8_t> out) const {
+            if (out.size() < queries.size()) throw std::out_of_range("Poly2 batch output is smaller than the input");
+
+            syncCache();
+            requireConvex();
+
+            const size_t len = points.size();
+            if (len < 3) {
+                std::fill(out.begin(), out.begin() + queries.size(), (std::uint8_t)0);
+                return 0;
+            }
+            const Rect2<T> box = getAABB();
+
+            if constexpr (std::is_same_v<T, float>) {
+                static_assert(sizeof(Point2<float>) == 2 * sizeof(float), "Point2<float> must be 2 packed floats");
+                if (len < batchContainsFaces) {
+                    //faces as start points and directions, flipped so the inside is on the left, on the
+                    //stack since there are fewer than batchContainsFaces of them. Zero length faces
+                    //from repeated points are left out, nothing is strictly inside of them
+                    const float sign = detail::windingSign(points.data(), len);
+                    std::array<float, batchContainsFaces> px, py, ex, ey;
+                    size_t faces = 0;
+                    for (size_t i = 0; i < len; i++) {
+                        const Point2<T>& next = points[i + 1 == len ? 0 : i + 1];
+                        if (next.x == points[i].x && next.y == points[i].y) continue;
+                        px[faces] = points[i].x;
+                        py[faces] = points[i].y;
+                        ex[faces] = sign * (next.x - points[i].x);
+                        ey[faces] = sign * (next.y - points[i].y);
+                        faces++;
+                    }
+                    if (faces < 3) {
+                        std::fill(out.begin(), out.begin() + queries.size(), (std::uint8_t)0);
+                        return 0;
+                    }
+
+                    return simd::convexContains(reinterpret_cast<const float*>(queries.data()), queries.size(),
+                        px.data(), py.data(), ex.data(), ey.data(), faces,
+                        box.min.x, box.min.y, box.max.x, box.max.y, out.data());
+                }
+            }
+
+            size_t count = 0;
+            for (size_t i = 0; i < queries.size(); i++) {
+                out[i] = box.contains(queries[i]) && contains(queries[i]);
+                count += out[i];
+            }
+            return count;
+        }
+
+        /**
+         * @brief Rotates the Poly2 in place
+         * @details a rotation keeps the Poly2 convex and its area, so the cached normals,
+         * centroid and snapshot turn with the points and only the AABB is dropped
+         * @param rot the rotation to apply
+         * @param center optionally set the center of the rotation
+        */
+        constexpr void rotate(const Rot2<T>& rot, const Point2<T>& center = Point2<T>()) noexcept {
+            for (auto& p : points) {
+                p = rot.rotate(p, center);
+            }
+            if (cache.empty()) return;
+            for (auto& p : cache.snapshot) {
+                p = rot.rotate(p, center);
+            }
+            if (cache.hasNormals) {
+                for (auto& n : cache.normals) {
+                    n = rot.rotate(n);
+                }
+            }
+            cache.centroid = rot.rotate(cache.centroid, center);
+            cache.hasAABB = false;
+        }
+
+        /**
+         * @brief Rotates the Poly2 in place by the given radian value
          * @param rad the radian value to rotate by
-         * @todo include a contains function for Poly2
+         * @param center optionally set the center of the rotation
         */
-        constexpr void rotate(const Radians rad) noexcept {
-            Mat3 rmat;
-            rmat.rotate(rad);
-            rmat.transform(*this);
+        constexpr void rotate(const Radians rad, const Point2<T>& center = Point2<T>()) noexcept {
+            rotate(Rot2<T>(rad), center);
         }
 
         /**
@@ -577,9 +859,9 @@ namespace Space2D {
         */
         template<typename Other>
         explicit operator Poly2<Other>() const {
-            auto otherPoints = std::vector<Point2<Other>>(size());
+            auto otherPoints = typename Poly2<Other>::PointStorage(size());
             for (size_t i = 0; i < size(); i++) {
-                otherPoints.at(i) = (Point2<Other>)points.at(i);
+                otherPoints[i] = (Point2<Other>)points[i];
             }
             return Poly2<Other>(otherPoints);
         }
@@ -663,23 +945,134 @@ namespace Space2D {
 
         private:
 
+            /**
+             * @brief the face count from which the batch contains switches to the binary search
+             * @details testing every face is cheaper while the faces are few, measured even at 64
+            */
+            static constexpr size_t batchContainsFaces = 64;
+
             /**
              * @brief the points of the Poly2
             */
-            std::vector<Point2<T>> points;
+            PointStorage points;
 
             /**
              * @brief a dirty bit for the Poly2
              * @details a dirty bit for the Poly2, this is used to 
-             * check the concavity invariant; every time a point is accessed
+             * check the concavity invariant and the cached values; every time a point is accessed
              * non const, it is possible the user could change a point and break concavity,
-             * therefore the dirty bit is set when a point is non const accessed, and any function
-             * that is concavity sensative will check the invariant again if the dirty bit is set
+             * therefore the dirty bit is set when a point is non const accessed. The next cached
+             * query compares the points against the snapshot the cache was computed from, so
+             * non const accesses that only read don't throw the cache away
             */
             mutable bool dirty = false;
 
+            /**
+             * @brief the lazily computed derived values of the Poly2
+             * @details snapshot holds the points the cached values were computed from, it is
+             * only meaningful while at least one value is cached
+            */
+            struct DerivedCache {
+                PointStorage snapshot;
+                NormalStorage normals;
+                Rect2<T> aabb;
+                Point2<T> centroid;
+                T area = (T)0.0;
+
+                bool hasArea = false;
+                bool hasCentroid = false;
+                bool hasAABB = false;
+                bool hasNormals = false;
+
+                /**
+                 * @brief set when the points changed since the last convexity check
+                */
+                bool checkConvex = false;
+
+                constexpr bool empty() const noexcept {
+                    return !(hasArea || hasCentroid || hasAABB || hasNormals);
+                }
+
+                constexpr void reset() noexcept {
+                    hasArea = false;
+                    hasCentroid = false;
+                    hasAABB = false;
+                    hasNormals = false;
+                }
+            };
+
+            mutable DerivedCache cache;
+
+            /**
+             * @brief resolves a pending dirty bit, dropping the cache only if the points really changed
+             * @details the points are compared exactly, Point2::operator== would let an edit within
+             * epsilon keep stale values
+            */
+            constexpr void syncCache() const {
+                if (dirty) {
+                    dirty = false;
+                    auto exact = [](const Point2<T>& a, const Point2<T>& b) { return a.x == b.x && a.y == b.y; };
+                    if (cache.empty() || cache.snapshot.size() != points.size() ||
+                        !std::equal(points.begin(), points.end(), cache.snapshot.begin(), exact)) {
+                        cache.reset();
+                        cache.checkConvex = true;
+                    }
+                }
+            }
+
+            /**
+             * @brief records the points the cache is computed from, called before the first value is cached
+            */
+            constexpr void snapshotIfEmpty() const {
+                if (cache.empty()) {
+                    cache.snapshot = points;
+                }
+            }
+
+            /**
+             * @brief rechecks the concavity invariant if the points changed since it was last checked
+            */
+            constexpr void requireConvex() const {
+                if (cache.checkConvex) {
+                    if (!isConvex()) {
+                        throw std::logic_error("Poly2 is not convex");
+                    }
+                    cache.checkConvex = false;
+                }
+            }
+
+            /**
+             * @brief updates the cache after every point was offset by the same vector
+             * @details area and normals don't change under translation, the centroid, AABB and
+             * snapshot move along with the points
+             * @param offset applies the offset to a single point
+            */
+            template<typename Offset>
+            constexpr void offsetCache(Offset&& offset) {
+                if (cache.empty()) return;
+                for (auto& p : cache.snapshot) {
+                    offset(p);
+                }
+                offset(cache.centroid);
+                offset(cache.aabb.min);
+                offset(cache.aabb.max);
+            }
+
+            /**
+             * @brief takes over the cache of the Poly2 this one was offset from
+             * @param source the Poly2 before the offset
+             * @param offset applies the offset to a single point
+            */
+            template<typename Offset>
+            constexpr void adoptOffsetCache(const Poly2& source, Offset&& offset) {
+                if (source.dirty || source.cache.empty()) return;
+                cache = source.cache;
+                offsetCache(offset);
+            }
+
             /**
              * @brief determines if the polygon is convex, necessasary for checking invariants
+             * @details every face vector is computed once, without bounds checks
              * @return true if the polygon is convex
             */
             constexpr bool isConvex() const noexcept {
@@ -687,12 +1080,19 @@ namespace Space2D {
                 T curr = 0;
 
                 size_t sizeval = size();
-                std::vector<T> crossproducts;
+                if (sizeval < 3) {
+                    return true;
+                }
+
+                const Point2<T>* pts = points.data();
+                Vec2<T> first = Vec2<T>(pts[0], pts[1]);
+                Vec2<T> face = first;
 
                 for (size_t i = 0; i < sizeval; i++) {
-                    size_t j = (i + 1) % sizeval;
+                    Vec2<T> nextFace = i + 1 == sizeval ? first :
+                        Vec2<T>(pts[i + 1], pts[i + 2 == sizeval ? 0 : i + 2]);
 
-                    curr = (-getFaceVec(i)).cross(getFaceVec(j));
+                    curr = (-face).cross(nextFace);
 
                     if (curr != 0) {
                         if (curr * prev < 0) {
@@ -702,6 +1102,7 @@ namespace Space2D {
                             prev = curr;
                         }
                     }
+                    face = nextFace;
                 }
                 return true;
             }
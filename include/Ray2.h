@@ -0,0 +1,356 @@
+#pragma once
+#include <span>
+#include <limits>
+#include <string>
+#include <ostream>
+#include <typeinfo>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "S2DSimd.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class NormVec2;
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Rect2;
+    template<typename T>
+    class Poly2;
+
+    /**
+     * @brief The result of casting a Ray2 against a shape
+     * @details a ray that starts inside the shape hits it at distance 0, and since it
+     * crosses no face there, its normal is the reverse of the ray direction
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    struct RayHit2
+    {
+        /**
+         * @brief true if the ray reached the shape within its length
+        */
+        bool hit = false;
+
+        /**
+         * @brief the distance along the ray to the hit, 0 when not hit
+        */
+        T distance = (T)0.0;
+
+        /**
+         * @brief the point where the ray enters the shape
+        */
+        Point2<T> point;
+
+        /**
+         * @brief the outward normal of the face the ray enters through, from getFaceNormal
+        */
+        NormVec2<T> normal;
+
+        /**
+         * @brief Checks if the ray hit
+        */
+        constexpr explicit operator bool() const noexcept {
+            return hit;
+        }
+
+        /**
+         * @brief Prints the RayHit2
+         * @param os Input stream
+         * @param it The RayHit2 to print
+         * @return a reference to the stream for << chaining
+        */
+        friend std::ostream& operator << (std::ostream& os, const RayHit2& it) {
+
+            std::string typname = typeid(T).name();
+            std::string::size_type i = typname.find("struct");
+            if (i != std::string::npos) {
+                typname.erase(i, 7);
+            }
+            i = typname.find("class");
+            if (i != std::string::npos) {
+                typname.erase(i, 6);
+            }
+
+            os << "RayHit2<" << typname << ">(hit: " << it.hit;
+            if (it.hit) {
+                os << ", distance: " << it.distance << ", point: (" << it.point.x << ", " << it.point.y
+                    << "), normal: (" << it.normal.x << ", " << it.normal.y << ")";
+            }
+            os << ")";
+            return os;
+        }
+    };
+
+    /**
+     * @brief A half line in 2 Dimensional space, starting at an origin and following a unit direction
+     * @details since the direction is a NormVec2, fractions along the ray are distances
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    class Ray2
+    {
+    public:
+
+        /**
+         * @brief Constructs a Ray2 from the origin along +x
+        */
+        constexpr Ray2() = default;
+
+        /**
+         * @brief Constructs a Ray2
+         * @param origin the start of the ray
+         * @param direction the direction of the ray
+        */
+        constexpr explicit Ray2(const Point2<T>& origin, const NormVec2<T>& direction) noexcept
+            : origin(origin), direction(direction) {}
+
+        /**
+         * @brief Computes the point a distance along the ray
+         * @param distance the distance from the origin
+         * @return the point at that distance
+        */
+        constexpr Point2<T> pointAt(const T& distance) const noexcept {
+            return Point2<T>(origin.x + direction.x * distance, origin.y + direction.y * distance);
+        }
+
+        /**
+         * @brief Casts the ray against a Rect2 with the slab test
+         * @details the slabs are crossed by multiplying with the reciprocal of the direction, like
+         * the batch casts, so both give the same distance to the bit
+         * @param rect the Rect2 to cast against
+         * @param maxDistance the length of the ray
+         * @return where the ray enters the Rect2, if it does before maxDistance
+        */
+        RayHit2<T> cast(const Rect2<T>& rect, const T& maxDistance) const {
+            T enter = (T)0.0;
+            T exit = maxDistance;
+
+            if (direction.x == (T)0.0) {
+                if (origin.x < rect.min.x || origin.x > rect.max.x) return RayHit2<T>();
+            }
+            else {
+                const T inv = (T)1.0 / direction.x;
+                T t1 = (rect.min.x - origin.x) * inv;
+                T t2 = (rect.max.x - origin.x) * inv;
+                enter = std::max(enter, std::min(t1, t2));
+                exit = std::min(exit, std::max(t1, t2));
+            }
+
+            if (direction.y == (T)0.0) {
+                if (origin.y < rect.min.y || origin.y > rect.max.y) return RayHit2<T>();
+            }
+            else {
+                const T inv = (T)1.0 / direction.y;
+                T t1 = (rect.min.y - origin.y) * inv;
+                T t2 = (rect.max.y - origin.y) * inv;
+                enter = std::max(enter, std::min(t1, t2));
+                exit = std::min(exit, std::max(t1, t2));
+            }
+
+            if (exit < enter) return RayHit2<T>();
+            return rectHit(rect, enter);
+        }
+
+        /**
+         * @brief Casts the ray against a convex Poly2 with the Cyrus-Beck clip
+         * @details the ray is clipped against the half plane of every face; it enters through
+         * the last face it crosses on the way in and leaves through the first on the way out
+         * @param poly the convex Poly2 to cast against
+         * @param maxDistance the length of the ray
+         * @return where the ray enters the Poly2, if it does before maxDistance
+        */
+        RayHit2<T> cast(const Poly2<T>& poly, const T& maxDistance) const {
+            const auto& points = poly.getPoints();
+            const auto& normals = poly.getFaceNormals();
+            const size_t count = points.size();
+            const T sign = detail::windingSign(points.data(), count);
+
+            T enter = (T)0.0;
+            T exit = maxDistance;
+            size_t face = count;
+
+            for (size_t i = 0; i < count; i++) {
+                //sign * normal points out of the polygon
+                T nx = normals[i].x * sign;
+                T ny = normals[i].y * sign;
+                T denom = nx * direction.x + ny * direction.y;
+                T dist = nx * (points[i].x - origin.x) + ny * (points[i].y - origin.y);
+
+                if (denom == (T)0.0) {
+                    if (dist < (T)0.0) return RayHit2<T>();
+                    continue;
+                }
+
+                T t = dist / denom;
+                if (denom < (T)0.0) {
+                    if (t > enter) {
+                        enter = t;
+                        face = i;
+                    }
+                }
+                else if (t < exit) {
+                    exit = t;
+                }
+                if (exit < enter) return RayHit2<T>();
+            }
+
+            RayHit2<T> result;
+            result.hit = true;
+            result.distance = enter;
+            result.point = pointAt(enter);
+            result.normal = face == count ? -direction : (sign > (T)0.0 ? normals[face] : -normals[face]);
+            return result;
+        }
+
+        /**
+         * @brief Casts the ray against many Rect2's
+         * @details for float coordinates the slab tests run several boxes per instruction
+         * @param rects the Rect2's to cast against
+         * @param maxDistance the length of the ray
+         * @param out receives the hit against each Rect2, must be at least as long as rects
+         * @return the number of Rect2's hit
+        */
+        size_t castBatch(std::span<const Rect2<T>> rects, const T& maxDistance, std::span<RayHit2<T>> out) const {
+            if (out.size() < rects.size()) throw std::out_of_range("Ray2 batch output is smaller than the input");
+
+            size_t hits = 0;
+            if constexpr (std::is_same_v<T, float>) {
+                static_assert(sizeof(Rect2<float>) == 4 * sizeof(float), "Rect2<float> must be 4 packed floats");
+
+                float t[batchChunk];
+                for (size_t first = 0; first < rects.size(); first += batchChunk) {
+                    size_t n = std::min(batchChunk, rects.size() - first);
+                    simd::raySlabBoxes(reinterpret_cast<const float*>(rects.data() + first), n,
+                        origin.x, origin.y, direction.x, direction.y, maxDistance, t);
+
+                    for (size_t i = 0; i < n; i++) {
+                        if (t[i] == std::numeric_limits<float>::infinity()) {
+                            out[first + i] = RayHit2<T>();
+                            continue;
+                        }
+                        out[first + i] = rectHit(rects[first + i], t[i]);
+                        hits++;
+                    }
+                }
+            }
+            else {
+                for (size_t i = 0; i < rects.size(); i++) {
+                    out[i] = cast(rects[i], maxDistance);
+                    hits += out[i].hit;
+                }
+            }
+            return hits;
+        }
+
+        /**
+         * @brief Casts many rays against one Rect2
+         * @details for float coordinates the slab tests run several rays per instruction
+         * @param rays the rays to cast
+         * @param rect the Rect2 to cast against
+         * @param maxDistance the length of every ray
+         * @param out receives the hit of each ray, must be at least as long as rays
+         * @return the number of rays that hit
+        */
+        static size_t castBatch(std::span<const Ray2> rays, const Rect2<T>& rect, const T& maxDistance, std::span<RayHit2<T>> out) {
+            if (out.size() < rays.size()) throw std::out_of_range("Ray2 batch output is smaller than the input");
+
+            size_t hits = 0;
+            if constexpr (std::is_same_v<T, float>) {
+                static_assert(sizeof(Ray2<float>) == 4 * sizeof(float), "Ray2<float> must be 4 packed floats");
+
+                float t[batchChunk];
+                for (size_t first = 0; first < rays.size(); first += batchChunk) {
+                    size_t n = std::min(batchChunk, rays.size() - first);
+                    simd::raySlabRays(reinterpret_cast<const float*>(rays.data() + first), n,
+                        rect.min.x, rect.min.y, rect.max.x, rect.max.y, maxDistance, t);
+
+                    for (size_t i = 0; i < n; i++) {
+                        if (t[i] == std::numeric_limits<float>::infinity()) {
+                            out[first + i] = RayHit2<T>();
+                            continue;
+                        }
+                        out[first + i] = rays[first + i].rectHit(rect, t[i]);
+                        hits++;
+                    }
+                }
+            }
+            else {
+                for (size_t i = 0; i < rays.size(); i++) {
+                    out[i] = rays[i].cast(rect, maxDistance);
+                    hits += out[i].hit;
+                }
+            }
+            return hits;
+        }
+
+        /**
+         * @brief Prints the Ray2
+         * @param os Input stream
+         * @param it The Ray2 to print
+         * @return a reference to the stream for << chaining
+        */
+        friend std::ostream& operator << (std::ostream& os, const Ray2& it) {
+
+            std::string typname = typeid(T).name();
+            std::string::size_type i = typname.find("struct");
+            if (i != std::string::npos) {
+                typname.erase(i, 7);
+            }
+            i = typname.find("class");
+            if (i != std::string::npos) {
+                typname.erase(i, 6);
+            }
+
+            os << "Ray2<" << typname << ">(origin: (" << it.origin.x << ", " << it.origin.y
+                << "), direction: (" << it.direction.x << ", " << it.direction.y << "))";
+            return os;
+        }
+
+        /**
+         * @brief The start of the ray
+        */
+        Point2<T> origin;
+
+        /**
+         * @brief The direction of the ray
+        */
+        NormVec2<T> direction;
+
+    private:
+
+        /**
+         * @brief the number of results computed on the stack at a time by the batch casts
+        */
+        static constexpr size_t batchChunk = 256;
+
+        /**
+         * @brief builds the hit for a ray known to enter rect at distance
+         * @details the face entered is the one on the axis whose slab the ray reached last
+        */
+        RayHit2<T> rectHit(const Rect2<T>& rect, const T& distance) const {
+            RayHit2<T> result;
+            result.hit = true;
+            result.distance = distance;
+            result.point = pointAt(distance);
+
+            T nearX = direction.x == (T)0.0 ? (T)-1.0 : ((direction.x > (T)0.0 ? rect.min.x : rect.max.x) - origin.x) * ((T)1.0 / direction.x);
+            T nearY = direction.y == (T)0.0 ? (T)-1.0 : ((direction.y > (T)0.0 ? rect.min.y : rect.max.y) - origin.y) * ((T)1.0 / direction.y);
+
+            if (nearX < (T)0.0 && nearY < (T)0.0) {
+                result.normal = -direction;
+            }
+            else if (nearX >= nearY) {
+                result.normal = rect.getFaceNormal(direction.x > (T)0.0 ? RectFace::Left : RectFace::Right);
+            }
+            else {
+                result.normal = rect.getFaceNormal(direction.y > (T)0.0 ? RectFace::Up : RectFace::Down);
+            }
+            return result;
+        }
+    };
+}
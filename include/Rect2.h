@@ -1,4 +1,5 @@
 #pragma once
+#include <utility>
 #include "AngularType.h"
 #include "S2DIterator.h"
 
@@ -6,14 +7,14 @@
 #ifndef S2D_RECT_2D_OPERATOR
 #define S2D_VEC_2D_OPERATOR
 #define S2D_VEC_2D_OP_EQ(op, typ2d) \
-    constexpr inline Rect2& operator##op(const typ2d<T>& rhs) noexcept {\
+    constexpr inline Rect2& operator op(const typ2d<T>& rhs) noexcept {\
     min op rhs;\
     max op rhs;\
     return (*this);\
 	}
 
 #define S2D_VEC_2D_OP(op, typ2d) \
-	constexpr inline Rect2 operator##op(const typ2d<T>& rhs) const noexcept { \
+	constexpr inline Rect2 operator op(const typ2d<T>& rhs) const noexcept { \
     return Rect2(min op rhs, max op rhs);\
 	}
 #endif
@@ -330,6 +331,75 @@ namespace Space2D {
             return true;
         }
 
+        /**
+         * @brief determines if another Rect2 lies completely within this one
+         * @details unlike contains(Point2), touching faces count as contained
+         * @param b the other Rect2 to check with
+         * @return true if b is inside the Rect2
+        */
+        constexpr bool contains(const Rect2& b) const noexcept {
+            return min.x <= b.min.x && min.y <= b.min.y &&
+                b.max.x <= max.x && b.max.y <= max.y;
+        }
+
+        /**
+         * @brief Computes the smallest Rect2 enclosing both Rect2's
+         * @param b the other Rect2 to enclose
+         * @return the enclosing Rect2
+        */
+        constexpr Rect2 combine(const Rect2& b) const noexcept {
+            return Rect2(
+                Point2<T>(min.x < b.min.x ? min.x : b.min.x, min.y < b.min.y ? min.y : b.min.y),
+                Point2<T>(max.x > b.max.x ? max.x : b.max.x, max.y > b.max.y ? max.y : b.max.y)
+            );
+        }
+
+        /**
+         * @brief determines if a segment touches the Rect2, using the slab test
+         * @details the segment covers origin + direction * t for t in [0, maxFraction]
+         * @param origin the start of the segment
+         * @param direction the direction of the segment, need not be normalized
+         * @param maxFraction how far along direction the segment extends
+         * @return true if the segment touches the Rect2, faces included
+        */
+        constexpr bool intersectsSegment(const Point2<T>& origin, const Vec2<T>& direction, const T& maxFraction) const noexcept {
+            T tmin = (T)0.0;
+            T tmax = maxFraction;
+
+            if (direction.x == (T)0.0) {
+                if (origin.x < min.x || origin.x > max.x) return false;
+            }
+            else {
+                T t1 = (min.x - origin.x) / direction.x;
+                T t2 = (max.x - origin.x) / direction.x;
+                if (t1 > t2) std::swap(t1, t2);
+                if (t1 > tmin) tmin = t1;
+                if (t2 < tmax) tmax = t2;
+                if (tmin > tmax) return false;
+            }
+
+            if (direction.y == (T)0.0) {
+                if (origin.y < min.y || origin.y > max.y) return false;
+            }
+            else {
+                T t1 = (min.y - origin.y) / direction.y;
+                T t2 = (max.y - origin.y) / direction.y;
+                if (t1 > t2) std::swap(t1, t2);
+                if (t1 > tmin) tmin = t1;
+                if (t2 < tmax) tmax = t2;
+                if (tmin > tmax) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Computes the perimeter of the Rect2
+         * @return the computed perimeter
+        */
+        constexpr T perimeter() const noexcept {
+            return (width() + height()) * (T)2.0;
+        }
+
         /**
          * @brief Computes the width and height of the Rect2
          * @return the width and height of the Rect2
@@ -481,19 +551,19 @@ namespace Space2D {
         }
 
         constexpr NormVec2<T> getNormal_1_0() const noexcept {
-            return NormVec2<T>(static_cast<T>(1), static_cast<T>(0));
+            return NormVec2<T>((T)1.0, (T)0.0);
         }
 
         constexpr NormVec2<T> getNormal_neg1_0() const noexcept {
-            return NormVec2<T>(static_cast<T>(-1), static_cast<T>(0));
+            return NormVec2<T>((T)-1.0, (T)0.0);
         }
 
         constexpr NormVec2<T> getNormal_0_1() const noexcept {
-            return NormVec2<T>(static_cast<T>(0), static_cast<T>(1));
+            return NormVec2<T>((T)0.0, (T)1.0);
         }
 
         constexpr NormVec2<T> getNormal_0_neg1() const noexcept {
-            return NormVec2<T>(static_cast<T>(0), static_cast<T>(-1));
+            return NormVec2<T>((T)0.0, (T)-1.0);
         }
 
         /**
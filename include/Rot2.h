@@ -0,0 +1,291 @@
+#pragma once
+#include <cmath>
+#include <string>
+#include <typeinfo>
+#include <iostream>
+#include "AngularType.h"
+#include "S2DTrig.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class NormVec2;
+    template<typename T>
+    class Poly2;
+    template<typename T>
+    class Mat3;
+
+    /**
+     * @brief A rotation stored as its cosine and sine, the unit complex number cos + i sin
+     * @details rotations compose by complex multiplication and rotate points with four
+     * multiplies, so an orientation kept as a Rot2 and advanced through integrate never
+     * calls a trig function. Only constructing from an angle, slerp and converting back
+     * to an angle do
+     * @tparam T Underlying data type of the cosine and sine
+    */
+    template<typename T>
+    class Rot2
+    {
+    public:
+
+        /**
+         * @brief Construct the identity rotation
+        */
+        constexpr Rot2() noexcept : cos((T)1.0), sin((T)0.0) {}
+
+        /**
+         * @brief Construct a Rot2 from an angle, Degrees and Percent convert through Radians
+         * @param rad the angle to rotate by, counter clockwise
+        */
+        constexpr explicit Rot2(const Radians rad) noexcept {
+            const SinCos sc = sincos(rad);
+            cos = (T)sc.cos;
+            sin = (T)sc.sin;
+        }
+
+        /**
+         * @brief Construct the Rot2 turning the x axis onto a direction
+         * @param dir the direction, already of unit length
+        */
+        constexpr explicit Rot2(const NormVec2<T>& dir) noexcept : cos(dir.x), sin(dir.y) {}
+
+        /**
+         * @brief Construct a Rot2 from a cosine and sine that are already of unit length
+         * @param cos the cosine of the rotation
+         * @param sin the sine of the rotation
+         * @return the Rot2
+        */
+        static constexpr Rot2 fromCosSin(const T& cos, const T& sin) noexcept {
+            Rot2 r;
+            r.cos = cos;
+            r.sin = sin;
+            return r;
+        }
+
+        /**
+         * @brief The Rot2 turning one direction onto another
+         * @param from the direction to turn from
+         * @param to the direction to turn to
+         * @return the Rot2, so that rotate(from) faces along to
+        */
+        static constexpr Rot2 between(const NormVec2<T>& from, const NormVec2<T>& to) noexcept {
+            return fromCosSin(from.x * to.x + from.y * to.y, from.x * to.y - from.y * to.x);
+        }
+
+        /**
+         * @brief composes two rotations, rotating by rhs then by this
+         * @param rhs the Rot2 applied first
+         * @return the composed Rot2
+        */
+        constexpr Rot2 operator*(const Rot2& rhs) const noexcept {
+            return fromCosSin(cos * rhs.cos - sin * rhs.sin, sin * rhs.cos + cos * rhs.sin);
+        }
+
+        /**
+         * @brief composes rhs into this rotation, rotating by rhs then by this
+         * @param rhs the Rot2 applied first
+         * @return a reference to this Rot2
+        */
+        constexpr Rot2& operator*=(const Rot2& rhs) noexcept {
+            return (*this) = (*this) * rhs;
+        }
+
+        /**
+         * @brief checks if two Rot2's are equal, within epsilon on each component
+        */
+        constexpr bool operator==(const Rot2& other) const noexcept {
+            return std::abs((double)(cos - other.cos)) < epsilon && std::abs((double)(sin - other.sin)) < epsilon;
+        }
+
+        /**
+         * @brief The rotation undoing this one
+         * @return the inverse, the complex conjugate
+        */
+        constexpr Rot2 inverse() const noexcept {
+            return fromCosSin(cos, -sin);
+        }
+
+        /**
+         * @brief rotates a Vec2
+         * @param v the Vec2 to rotate
+         * @return the rotated Vec2
+        */
+        constexpr Vec2<T> rotate(const Vec2<T>& v) const noexcept {
+            return Vec2<T>(cos * v.x - sin * v.y, sin * v.x + cos * v.y);
+        }
+
+        /**
+         * @brief rotates a Vec2 by the inverse of this rotation, without forming the inverse
+         * @param v the Vec2 to rotate
+         * @return the rotated Vec2
+        */
+        constexpr Vec2<T> unrotate(const Vec2<T>& v) const noexcept {
+            return Vec2<T>(cos * v.x + sin * v.y, cos * v.y - sin * v.x);
+        }
+
+        /**
+         * @brief rotates a Point2 around a center
+         * @param p the Point2 to rotate
+         * @param center optionally set the center of the rotation
+         * @return the rotated Point2
+        */
+        constexpr Point2<T> rotate(const Point2<T>& p, const Point2<T>& center = Point2<T>()) const noexcept {
+            const T dx = p.x - center.x;
+            const T dy = p.y - center.y;
+            return Point2<T>(center.x + cos * dx - sin * dy, center.y + sin * dx + cos * dy);
+        }
+
+        /**
+         * @brief rotates a NormVec2, the result is renormalized
+         * @param n the NormVec2 to rotate
+         * @return the rotated NormVec2
+        */
+        constexpr NormVec2<T> rotate(const NormVec2<T>& n) const noexcept {
+            return NormVec2<T>(cos * n.x - sin * n.y, sin * n.x + cos * n.y);
+        }
+
+        /**
+         * @brief rotates a Poly2 around a center, see Poly2::rotate
+         * @param p the Poly2 to rotate
+         * @param center optionally set the center of the rotation
+         * @return the rotated Poly2
+        */
+        Poly2<T> rotate(const Poly2<T>& p, const Point2<T>& center = Point2<T>()) const {
+            Poly2<T> out = p;
+            out.rotate(*this, center);
+            return out;
+        }
+
+        /**
+         * @brief advances the rotation by a small angle without trig functions
+         * @details the step is the Cayley transform of angle / 2, of unit length and turning
+         * by 2 atan(angle / 2), which is short of angle by angle^3 / 12: under 1e-4 radians
+         * for steps up to 0.1 radians, such as an angular velocity times a tick. A Newton step
+         * towards unit length follows, so rounding never builds up over many ticks
+         * @param angle the angle to turn by, in radians
+         * @return a reference to this Rot2
+        */
+        constexpr Rot2& integrate(const T& angle) noexcept {
+            const T h = angle * (T)0.5;
+            const T scale = (T)1.0 / ((T)1.0 + h * h);
+            (*this) *= fromCosSin(((T)1.0 - h * h) * scale, (T)2.0 * h * scale);
+            nudgeToUnit();
+            return *this;
+        }
+
+        /**
+         * @brief scales the cosine and sine back to unit length
+         * @details composing many rotations lets rounding errors grow the length, a renormalize
+         * every few hundred compositions keeps it within float precision
+         * @return a reference to this Rot2
+        */
+        constexpr Rot2& renormalize() noexcept {
+            const T len = (T)std::sqrt((double)(cos * cos + sin * sin));
+            cos = cos / len;
+            sin = sin / len;
+            return *this;
+        }
+
+        /**
+         * @brief the angle of the rotation
+         * @return the angle in (-pi, pi]
+        */
+        Radians angle() const noexcept {
+            return Radians(std::atan2((float)sin, (float)cos));
+        }
+
+        /**
+         * @brief converts the rotation to an angle in any unit, such as Degrees or Percent
+        */
+        template<typename Ratio>
+        explicit operator AngType<Ratio>() const noexcept {
+            return angle();
+        }
+
+        /**
+         * @brief the direction the x axis is turned onto
+        */
+        constexpr NormVec2<T> toNormVec2() const noexcept {
+            return NormVec2<T>(cos, sin);
+        }
+
+        /**
+         * @brief the rotation as a matrix
+        */
+        constexpr Mat3<T> toMat3() const noexcept {
+            return Mat3<T>(cos, -sin, (T)0.0, sin, cos, (T)0.0);
+        }
+
+        /**
+         * @brief Prints the Rot2
+         * @param os Input stream
+         * @param it The Rot2 to print
+         * @return a reference to the stream for << chaining
+        */
+        friend std::ostream& operator << (std::ostream& os, const Rot2<T>& it) {
+            std::string typname = typeid(T).name();
+            std::string::size_type i = typname.find("struct");
+            if (i != std::string::npos) {
+                typname.erase(i, 7);
+            }
+            i = typname.find("class");
+            if (i != std::string::npos) {
+                typname.erase(i, 6);
+            }
+            os << "Rot2<" << typname << ">(" << it.cos << ", " << it.sin << ")";
+            return os;
+        }
+
+        /**
+         * @brief the cosine of the rotation
+        */
+        T cos;
+
+        /**
+         * @brief the sine of the rotation
+        */
+        T sin;
+
+    private:
+
+        /**
+         * @brief one Newton step of 1 / sqrt towards unit length, enough for a length already within float error of 1
+        */
+        constexpr void nudgeToUnit() noexcept {
+            const T fix = ((T)3.0 - (cos * cos + sin * sin)) * (T)0.5;
+            cos = cos * fix;
+            sin = sin * fix;
+        }
+    };
+
+    /**
+     * @brief interpolates two rotations by normalizing the linear blend of their components
+     * @details cheaper than slerp and turns the short way round, but not at a constant rate,
+     * and it is undefined for opposite rotations
+     * @param a the rotation at t = 0
+     * @param b the rotation at t = 1
+     * @param t the blend factor
+     * @return the interpolated Rot2
+    */
+    template<typename T>
+    constexpr Rot2<T> nlerp(const Rot2<T>& a, const Rot2<T>& b, const T& t) noexcept {
+        return Rot2<T>::fromCosSin(a.cos + t * (b.cos - a.cos), a.sin + t * (b.sin - a.sin)).renormalize();
+    }
+
+    /**
+     * @brief interpolates two rotations at a constant angular rate, the short way round
+     * @param a the rotation at t = 0
+     * @param b the rotation at t = 1
+     * @param t the blend factor
+     * @return the interpolated Rot2
+    */
+    template<typename T>
+    Rot2<T> slerp(const Rot2<T>& a, const Rot2<T>& b, const T& t) noexcept {
+        const Rot2<T> delta = a.inverse() * b;
+        return a * Rot2<T>(Radians(delta.angle().get() * (float)t));
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <type_traits>
+#include <utility>
+
+namespace Space2D {
+
+    namespace detail {
+
+        /**
+         * @brief Invokes a query callback and reports whether the query should continue
+         * @details query callbacks may either return void, to visit every result, or bool,
+         * where returning false stops the query early
+         * @param callback the callback to invoke
+         * @param ...args the arguments to pass to the callback
+         * @return false if the callback asked to stop
+        */
+        template<typename Callback, typename... Args>
+        constexpr bool invokeContinue(Callback&& callback, Args&&... args) {
+            if constexpr (std::is_void_v<std::invoke_result_t<Callback, Args...>>) {
+                std::forward<Callback>(callback)(std::forward<Args>(args)...);
+                return true;
+            }
+            else {
+                return static_cast<bool>(std::forward<Callback>(callback)(std::forward<Args>(args)...));
+            }
+        }
+    }
+}
@@ -0,0 +1,389 @@
+#pragma once
+#include <algorithm>
+#include <stdexcept>
+#include "S2DTags.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Rect2;
+    template<typename T>
+    class Poly2;
+
+    namespace detail {
+
+        /**
+         * @brief twice the signed area of the triangle o, a, b
+         * @return positive when b lies left of the line from o to a, 0 when the three are collinear
+        */
+        template<typename T>
+        constexpr T clipCross(const Point2<T>& o, const Point2<T>& a, const Point2<T>& b) noexcept {
+            return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+        }
+
+        /**
+         * @brief appends a clipped point, skipping exact repeats of the previous one
+        */
+        template<typename Storage, typename T>
+        constexpr void clipEmit(Storage& out, const Point2<T>& p) {
+            if (!out.empty() && out.back().x == p.x && out.back().y == p.y) return;
+            out.push_back(p);
+        }
+
+        /**
+         * @brief drops every corner that does not turn the way the polygon is wound
+         * @details those are repeats, corners on a straight face, or tiny dents where a
+         * rounded crossing point landed just off the face it lies on. Leaves nothing if
+         * fewer than 3 corners remain, as then no area is left
+         * @param out the clipped corners
+         * @param sign the winding sign of the corners, see windingSign
+        */
+        template<typename Storage, typename T>
+        constexpr void clipFinish(Storage& out, const T sign) {
+            auto bends = [&](const Point2<T>& a, const Point2<T>& b, const Point2<T>& c) {
+                return sign * clipCross(a, b, c) > (T)0.0;
+            };
+
+            size_t k = 0;
+            for (size_t i = 0; i < out.size(); i++) {
+                out[k++] = out[i];
+                while (k >= 3 && !bends(out[k - 3], out[k - 2], out[k - 1])) {
+                    out[k - 2] = out[k - 1];
+                    k--;
+                }
+            }
+
+            //the corners where the list wraps around
+            while (k >= 3) {
+                if (!bends(out[k - 2], out[k - 1], out[0])) {
+                    k--;
+                }
+                else if (!bends(out[k - 1], out[0], out[1])) {
+                    std::copy(out.begin() + 1, out.begin() + k, out.begin());
+                    k--;
+                }
+                else {
+                    break;
+                }
+            }
+            out.resize(k < 3 ? 0 : k);
+        }
+
+        /**
+         * @brief Sutherland-Hodgman against the four sides of a Rect2, run as a pipeline
+         * @details every stage clips against one side and feeds its output straight into the
+         * next stage, remembering only its first and previous point, so no intermediate
+         * polygons are stored
+        */
+        template<typename T, typename Storage>
+        struct RectClipper {
+            const Rect2<T>& rect;
+            Storage& out;
+            Point2<T> first[4]{};
+            Point2<T> prev[4]{};
+            bool started[4] = { false, false, false, false };
+
+            constexpr bool inside(const size_t stage, const Point2<T>& p) const {
+                switch (stage) {
+                case 0: return p.x >= rect.min.x;
+                case 1: return p.x <= rect.max.x;
+                case 2: return p.y >= rect.min.y;
+                default: return p.y <= rect.max.y;
+                }
+            }
+
+            constexpr Point2<T> crossing(const size_t stage, const Point2<T>& a, const Point2<T>& b) const {
+                if (stage < 2) {
+                    T x = stage == 0 ? rect.min.x : rect.max.x;
+                    return Point2<T>(x, a.y + (b.y - a.y) * ((x - a.x) / (b.x - a.x)));
+                }
+                T y = stage == 2 ? rect.min.y : rect.max.y;
+                return Point2<T>(a.x + (b.x - a.x) * ((y - a.y) / (b.y - a.y)), y);
+            }
+
+            constexpr void edge(const size_t stage, const Point2<T>& a, const Point2<T>& b) {
+                bool aIn = inside(stage, a);
+                bool bIn = inside(stage, b);
+                if (aIn != bIn) {
+                    //always interpolate from the inside end, so both directions of an edge agree
+                    push(stage + 1, aIn ? crossing(stage, a, b) : crossing(stage, b, a));
+                }
+                if (bIn) {
+                    push(stage + 1, b);
+                }
+            }
+
+            constexpr void push(const size_t stage, const Point2<T>& p) {
+                if (stage == 4) {
+                    clipEmit(out, p);
+                    return;
+                }
+                if (!started[stage]) {
+                    started[stage] = true;
+                    first[stage] = p;
+                }
+                else {
+                    edge(stage, prev[stage], p);
+                }
+                prev[stage] = p;
+            }
+
+            constexpr void close() {
+                for (size_t stage = 0; stage < 4; stage++) {
+                    if (started[stage]) {
+                        edge(stage, prev[stage], first[stage]);
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief the corners of a convex polygon in counter clockwise order, whichever way it is wound
+        */
+        template<typename T>
+        struct CCWView {
+            const Point2<T>* points;
+            size_t count;
+            bool reversed;
+
+            constexpr const Point2<T>& operator[](const size_t i) const noexcept {
+                return points[reversed ? count - 1 - i : i];
+            }
+        };
+
+        /**
+         * @brief classifies how segments ab and cd meet
+         * @details '1' for a proper crossing, 'v' when an end of one lies on the other, 'e' when
+         * they overlap along a line and '0' when they miss
+         * @param p receives the meeting point, the first end of the overlap for 'e'
+        */
+        template<typename T>
+        constexpr char segmentMeet(const Point2<T>& a, const Point2<T>& b, const Point2<T>& c, const Point2<T>& d, Point2<T>& p) {
+            T denom = (b.x - a.x) * (d.y - c.y) - (b.y - a.y) * (d.x - c.x);
+
+            if (denom == (T)0.0) {
+                if (clipCross(a, b, c) != (T)0.0) return '0';
+
+                //on the common line, compare along whichever axis the segments span
+                auto between = [](const Point2<T>& s, const Point2<T>& e, const Point2<T>& q) {
+                    if (s.x != e.x) return (s.x <= q.x && q.x <= e.x) || (s.x >= q.x && q.x >= e.x);
+                    return (s.y <= q.y && q.y <= e.y) || (s.y >= q.y && q.y >= e.y);
+                };
+                if (between(a, b, c)) { p = c; return 'e'; }
+                if (between(a, b, d)) { p = d; return 'e'; }
+                if (between(c, d, a)) { p = a; return 'e'; }
+                return '0';
+            }
+
+            T sNum = (c.x - a.x) * (d.y - c.y) - (c.y - a.y) * (d.x - c.x);
+            T tNum = (c.x - a.x) * (b.y - a.y) - (c.y - a.y) * (b.x - a.x);
+            char code = '?';
+            if (sNum == (T)0.0 || sNum == denom || tNum == (T)0.0 || tNum == denom) code = 'v';
+
+            T s = sNum / denom;
+            T t = tNum / denom;
+            if ((T)0.0 < s && s < (T)1.0 && (T)0.0 < t && t < (T)1.0) code = '1';
+            else if (s < (T)0.0 || s > (T)1.0 || t < (T)0.0 || t > (T)1.0) code = '0';
+
+            p = Point2<T>(a.x + s * (b.x - a.x), a.y + s * (b.y - a.y));
+            return code;
+        }
+
+        /**
+         * @brief the mean of the corners, strictly inside a convex polygon with any area
+        */
+        template<typename T>
+        constexpr Point2<T> meanCorner(const CCWView<T>& poly) {
+            T x = (T)0.0;
+            T y = (T)0.0;
+            for (size_t i = 0; i < poly.count; i++) {
+                x += poly[i].x;
+                y += poly[i].y;
+            }
+            return Point2<T>(x / (T)(double)poly.count, y / (T)(double)poly.count);
+        }
+
+        /**
+         * @brief true if p is inside or on the counter clockwise convex polygon
+        */
+        template<typename T>
+        constexpr bool insideCCW(const CCWView<T>& poly, const Point2<T>& p) {
+            for (size_t i = 0; i < poly.count; i++) {
+                if (clipCross(poly[i], poly[i + 1 == poly.count ? 0 : i + 1], p) < (T)0.0) return false;
+            }
+            return true;
+        }
+    }
+
+    /**
+     * @brief Clips a Poly2 to a Rect2 with Sutherland-Hodgman
+     * @details clipping a convex Poly2 can only give a convex Poly2, so out is refilled through
+     * Poly2::refill without the convexity check, reusing its point storage. The result is wound
+     * the same way as poly. If no area is left, out is emptied
+     * @param poly the Poly2 to clip, must not be out
+     * @param rect the Rect2 to clip to
+     * @param out receives the clipped Poly2
+     * @return true if any area is left
+    */
+    template<typename T>
+    bool clip(const Poly2<T>& poly, const Rect2<T>& rect, Poly2<T>& out) {
+        if (&poly == &out) throw std::logic_error("clip output must not be its input");
+
+        out.refill(trustedConvex, [&](typename Poly2<T>::PointStorage& points) {
+            detail::RectClipper<T, typename Poly2<T>::PointStorage> clipper{ rect, points };
+            for (const Point2<T>& p : poly.getPoints()) {
+                clipper.push(0, p);
+            }
+            clipper.close();
+            detail::clipFinish(points, detail::windingSign(poly.getPoints().data(), poly.size()));
+        });
+        return out.size() != 0;
+    }
+
+    /**
+     * @brief Clips a Poly2 to a Rect2 with Sutherland-Hodgman
+     * @param poly the Poly2 to clip
+     * @param rect the Rect2 to clip to
+     * @return the clipped Poly2, empty if no area is left
+    */
+    template<typename T>
+    Poly2<T> clip(const Poly2<T>& poly, const Rect2<T>& rect) {
+        Poly2<T> out(trustedConvex, typename Poly2<T>::PointStorage());
+        clip(poly, rect, out);
+        return out;
+    }
+
+    /**
+     * @brief Intersects two convex Poly2's in O(n + m) with O'Rourke's edge chasing
+     * @details the two boundaries are walked together, always advancing the edge that points
+     * at the other, and each crossing switches which boundary is being emitted. Like clip, out is
+     * refilled without the convexity check and wound the same way as a. Touching Poly2's, which
+     * share no area, give an empty out
+     * @param a the first Poly2, must not be out
+     * @param b the second Poly2, must not be out
+     * @param out receives the intersection
+     * @return true if the Poly2's share any area
+    */
+    template<typename T>
+    bool intersect(const Poly2<T>& a, const Poly2<T>& b, Poly2<T>& out) {
+        if (&a == &out || &b == &out) throw std::logic_error("intersect output must not be one of its inputs");
+
+        const auto& pa = a.getPoints();
+        const auto& pb = b.getPoints();
+        const size_t n = pa.size();
+        const size_t m = pb.size();
+        if (n < 3 || m < 3) {
+            out.refill(trustedConvex, [](typename Poly2<T>::PointStorage&) {});
+            return false;
+        }
+
+        const bool aReversed = detail::windingSign(pa.data(), n) < (T)0.0;
+        const detail::CCWView<T> P{ pa.data(), n, aReversed };
+        const detail::CCWView<T> Q{ pb.data(), m, detail::windingSign(pb.data(), m) < (T)0.0 };
+
+        out.refill(trustedConvex, [&](typename Poly2<T>::PointStorage& points) {
+            enum class Inside { Unknown, P, Q };
+            Inside inside = Inside::Unknown;
+
+            size_t ia = 0;
+            size_t ib = 0;
+            size_t advancedA = 0;
+            size_t advancedB = 0;
+            bool crossed = false;
+
+            auto advanceA = [&]() {
+                if (inside == Inside::P) detail::clipEmit(points, P[ia]);
+                advancedA++;
+                ia = ia + 1 == n ? 0 : ia + 1;
+            };
+            auto advanceB = [&]() {
+                if (inside == Inside::Q) detail::clipEmit(points, Q[ib]);
+                advancedB++;
+                ib = ib + 1 == m ? 0 : ib + 1;
+            };
+
+            do {
+                const Point2<T>& a0 = P[ia == 0 ? n - 1 : ia - 1];
+                const Point2<T>& a1 = P[ia];
+                const Point2<T>& b0 = Q[ib == 0 ? m - 1 : ib - 1];
+                const Point2<T>& b1 = Q[ib];
+
+                T turn = (a1.x - a0.x) * (b1.y - b0.y) - (a1.y - a0.y) * (b1.x - b0.x);
+                T aSide = detail::clipCross(b0, b1, a1);
+                T bSide = detail::clipCross(a0, a1, b1);
+
+                Point2<T> p;
+                char code = detail::segmentMeet(a0, a1, b0, b1, p);
+                if (code == '1' || code == 'v') {
+                    if (!crossed) {
+                        crossed = true;
+                        advancedA = 0;
+                        advancedB = 0;
+                    }
+                    detail::clipEmit(points, p);
+                    if (aSide > (T)0.0) inside = Inside::P;
+                    else if (bSide > (T)0.0) inside = Inside::Q;
+                }
+
+                //opposite facing overlapping edges, or parallel edges facing away, share no area
+                if (code == 'e' && (a1.x - a0.x) * (b1.x - b0.x) + (a1.y - a0.y) * (b1.y - b0.y) < (T)0.0) {
+                    points.clear();
+                    return;
+                }
+                if (turn == (T)0.0 && aSide < (T)0.0 && bSide < (T)0.0) {
+                    points.clear();
+                    return;
+                }
+
+                if (turn == (T)0.0 && aSide == (T)0.0 && bSide == (T)0.0) {
+                    if (inside == Inside::P) advanceB();
+                    else advanceA();
+                }
+                else if (turn >= (T)0.0) {
+                    if (bSide > (T)0.0) advanceA();
+                    else advanceB();
+                }
+                else {
+                    if (aSide > (T)0.0) advanceB();
+                    else advanceA();
+                }
+            } while ((advancedA < n || advancedB < m) && advancedA < 2 * n && advancedB < 2 * m);
+
+            if (inside == Inside::Unknown) {
+                //the boundaries never cross, at most they touch, so either one holds the other or
+                //they share no area. The mean corner is strictly inside, unlike a touching corner,
+                //and the inner one is always inside the outer Poly2, which is the larger one
+                points.clear();
+                if (detail::insideCCW(Q, detail::meanCorner(P)) || detail::insideCCW(P, detail::meanCorner(Q))) {
+                    if (a.area() <= b.area()) {
+                        for (size_t i = 0; i < n; i++) points.push_back(P[i]);
+                    }
+                    else {
+                        for (size_t i = 0; i < m; i++) points.push_back(Q[i]);
+                    }
+                }
+            }
+
+            detail::clipFinish(points, (T)1.0);
+            if (aReversed) {
+                std::reverse(points.begin(), points.end());
+            }
+        });
+        return out.size() != 0;
+    }
+
+    /**
+     * @brief Intersects two convex Poly2's in O(n + m) with O'Rourke's edge chasing
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @return the intersection, empty if the Poly2's share no area
+    */
+    template<typename T>
+    Poly2<T> intersect(const Poly2<T>& a, const Poly2<T>& b) {
+        Poly2<T> out(trustedConvex, typename Poly2<T>::PointStorage());
+        intersect(a, b, out);
+        return out;
+    }
+}
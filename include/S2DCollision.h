@@ -0,0 +1,352 @@
+#pragma once
+#include <array>
+#include <algorithm>
+#include "S2DMath.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class NormVec2;
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Rect2;
+    template<typename T>
+    class Poly2;
+
+    /**
+     * @brief The result of a narrowphase collision test between two convex shapes
+     * @details when the shapes overlap, normal points from the first shape towards the
+     * second, and moving the second shape by normal * depth separates them. Up to two
+     * contact points are reported, they lie on the incident face of the overlap
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    struct Manifold2
+    {
+        /**
+         * @brief true if the shapes overlap, touching counts as overlapping
+        */
+        bool colliding = false;
+
+        /**
+         * @brief the penetration depth along normal, 0 when not colliding
+        */
+        T depth = (T)0.0;
+
+        /**
+         * @brief the collision normal, pointing from the first shape to the second
+        */
+        NormVec2<T> normal;
+
+        /**
+         * @brief the contact points, only the first contactCount are meaningful
+        */
+        std::array<Point2<T>, 2> contacts{};
+
+        /**
+         * @brief the number of valid contact points, 0, 1 or 2
+        */
+        size_t contactCount = 0;
+
+        /**
+         * @brief Checks if the shapes collided
+        */
+        constexpr explicit operator bool() const noexcept {
+            return colliding;
+        }
+
+        /**
+         * @brief Prints the Manifold2
+         * @param os Input stream
+         * @param it The Manifold2 to print
+         * @return a reference to the stream for << chaining
+        */
+        friend std::ostream& operator << (std::ostream& os, const Manifold2& it) {
+
+            std::string typname = typeid(T).name();
+            std::string::size_type i = typname.find("struct");
+            if (i != std::string::npos) {
+                typname.erase(i, 7);
+            }
+            i = typname.find("class");
+            if (i != std::string::npos) {
+                typname.erase(i, 6);
+            }
+
+            os << "Manifold2<" << typname << ">(colliding: " << it.colliding;
+            if (it.colliding) {
+                os << ", depth: " << it.depth << ", normal: (" << it.normal.x << ", " << it.normal.y << "), contacts: {";
+                for (size_t i = 0; i < it.contactCount; i++) {
+                    os << " (" << it.contacts[i].x << ", " << it.contacts[i].y << ")";
+                }
+                os << " }";
+            }
+            os << ")";
+            return os;
+        }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief a non owning view of a convex shape for the SAT routines
+         * @details normals holds the face normals produced by the Vec2::unitNormal rule, which
+         * point outward for counter clockwise points and inward for clockwise points; sign
+         * flips them so that sign * normal always points outward
+        */
+        template<typename T>
+        struct SatShape {
+            const Point2<T>* points;
+            const NormVec2<T>* normals;
+            size_t count;
+            T sign;
+
+            constexpr const Point2<T>& point(const size_t i) const noexcept {
+                return points[i];
+            }
+
+            constexpr const Point2<T>& nextPoint(const size_t i) const noexcept {
+                return points[i + 1 == count ? 0 : i + 1];
+            }
+
+            constexpr T nx(const size_t i) const noexcept {
+                return normals[i].x * sign;
+            }
+
+            constexpr T ny(const size_t i) const noexcept {
+                return normals[i].y * sign;
+            }
+        };
+
+        template<typename T>
+        SatShape<T> makeSatShape(const Poly2<T>& poly) {
+            const auto& points = poly.getPoints();
+            return SatShape<T>{ points.data(), poly.getFaceNormals().data(), points.size(), windingSign(points.data(), points.size()) };
+        }
+
+        /**
+         * @brief SatShape storage for a Rect2, its faces are axis aligned so the normals are known up front
+        */
+        template<typename T>
+        struct RectSatShape {
+            std::array<Point2<T>, 4> points;
+            std::array<NormVec2<T>, 4> normals;
+
+            explicit RectSatShape(const Rect2<T>& r) :
+                points{ r.min, Point2<T>(r.max.x, r.min.y), r.max, Point2<T>(r.min.x, r.max.y) },
+                normals{ NormVec2<T>((T)0.0, (T)-1.0), NormVec2<T>((T)1.0, (T)0.0),
+                    NormVec2<T>((T)0.0, (T)1.0), NormVec2<T>((T)-1.0, (T)0.0) } {}
+
+            SatShape<T> view() const noexcept {
+                return SatShape<T>{ points.data(), normals.data(), 4, (T)1.0 };
+            }
+        };
+
+        /**
+         * @brief finds the face of a whose outward normal separates b the most
+         * @details stops at the first separating axis, in which case the returned
+         * separation is positive
+         * @param face receives the index of the face
+         * @return the largest separation, negative when the shapes overlap on every face of a
+        */
+        template<typename T>
+        constexpr T maxSeparation(const SatShape<T>& a, const SatShape<T>& b, size_t& face) noexcept {
+            T best = (T)0.0;
+            for (size_t i = 0; i < a.count; i++) {
+                T nx = a.nx(i);
+                T ny = a.ny(i);
+                const Point2<T>& v = a.point(i);
+
+                T minDist = nx * (b.points[0].x - v.x) + ny * (b.points[0].y - v.y);
+                for (size_t j = 1; j < b.count; j++) {
+                    T dist = nx * (b.points[j].x - v.x) + ny * (b.points[j].y - v.y);
+                    if (dist < minDist) minDist = dist;
+                }
+
+                if (i == 0 || minDist > best) {
+                    best = minDist;
+                    face = i;
+                    if (best > (T)0.0) {
+                        return best;
+                    }
+                }
+            }
+            return best;
+        }
+
+        /**
+         * @brief clips a segment against the half plane dot(n, p) >= offset, n need not be normalized
+         * @param inCount the number of points in in, a single point is kept or dropped as is
+         * @return the number of points left, the points are written into out
+        */
+        template<typename T>
+        constexpr size_t clipSegment(const std::array<Point2<T>, 2>& in, const size_t inCount, std::array<Point2<T>, 2>& out,
+            const T& nx, const T& ny, const T& offset) noexcept {
+
+            size_t count = 0;
+            T d0 = nx * in[0].x + ny * in[0].y - offset;
+            if (inCount == 1) {
+                if (d0 >= (T)0.0) out[count++] = in[0];
+                return count;
+            }
+            T d1 = nx * in[1].x + ny * in[1].y - offset;
+
+            if (d0 >= (T)0.0) out[count++] = in[0];
+            if (d1 >= (T)0.0) out[count++] = in[1];
+
+            if (d0 * d1 < (T)0.0) {
+                T t = d0 / (d0 - d1);
+                out[count++] = Point2<T>(in[0].x + (in[1].x - in[0].x) * t, in[0].y + (in[1].y - in[0].y) * t);
+            }
+            return count;
+        }
+
+        /**
+         * @brief Separating Axis Theorem overlap test, without building contacts
+        */
+        template<typename T>
+        constexpr bool satOverlaps(const SatShape<T>& a, const SatShape<T>& b) noexcept {
+            if (a.count == 0 || b.count == 0) return false;
+            size_t face = 0;
+            return maxSeparation(a, b, face) <= (T)0.0 && maxSeparation(b, a, face) <= (T)0.0;
+        }
+
+        /**
+         * @brief Separating Axis Theorem test between two convex shapes
+         * @details the reference face is the face of least penetration, contacts are
+         * found by clipping the most anti parallel face of the other shape against it
+        */
+        template<typename T>
+        Manifold2<T> satCollide(const SatShape<T>& a, const SatShape<T>& b) {
+            Manifold2<T> result;
+            if (a.count == 0 || b.count == 0) return result;
+
+            size_t faceA = 0;
+            T sepA = maxSeparation(a, b, faceA);
+            if (sepA > (T)0.0) return result;
+
+            size_t faceB = 0;
+            T sepB = maxSeparation(b, a, faceB);
+            if (sepB > (T)0.0) return result;
+
+            //prefer the faces of a unless b is clearly better, keeps the normal stable between frames
+            const bool flip = sepB > sepA * (T)0.98 + (T)0.001 * abs(sepA);
+            const SatShape<T>& ref = flip ? b : a;
+            const SatShape<T>& inc = flip ? a : b;
+            const size_t refFace = flip ? faceB : faceA;
+            const T sep = flip ? sepB : sepA;
+
+            T nx = ref.nx(refFace);
+            T ny = ref.ny(refFace);
+
+            size_t incFace = 0;
+            T minDot = inc.nx(0) * nx + inc.ny(0) * ny;
+            for (size_t i = 1; i < inc.count; i++) {
+                T d = inc.nx(i) * nx + inc.ny(i) * ny;
+                if (d < minDot) {
+                    minDot = d;
+                    incFace = i;
+                }
+            }
+
+            const Point2<T>& r0 = ref.point(refFace);
+            const Point2<T>& r1 = ref.nextPoint(refFace);
+            T tx = r1.x - r0.x;
+            T ty = r1.y - r0.y;
+
+            std::array<Point2<T>, 2> incident{ inc.point(incFace), inc.nextPoint(incFace) };
+            std::array<Point2<T>, 2> clipped;
+            std::array<Point2<T>, 2> clipped2;
+
+            //an incident vertex sitting on a side plane clips down to a single point, which is still a contact
+            size_t count = clipSegment(incident, 2, clipped, tx, ty, tx * r0.x + ty * r0.y);
+            if (count > 0) {
+                count = clipSegment(clipped, count, clipped2, -tx, -ty, -(tx * r1.x + ty * r1.y));
+            }
+
+            result.colliding = true;
+            result.depth = -sep;
+            result.normal = flip ? NormVec2<T>(-nx, -ny) : NormVec2<T>(nx, ny);
+
+            T refOffset = nx * r0.x + ny * r0.y;
+            for (size_t i = 0; i < count; i++) {
+                if (nx * clipped2[i].x + ny * clipped2[i].y - refOffset <= (T)0.0) {
+                    result.contacts[result.contactCount++] = clipped2[i];
+                }
+            }
+            return result;
+        }
+    }
+
+    /**
+     * @brief Narrowphase collision test between two convex Poly2's
+     * @details uses the Separating Axis Theorem over the face normals of both polygons,
+     * and returns as soon as a separating axis is found
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @return the collision manifold, with the normal pointing from a to b
+    */
+    template<typename T>
+    Manifold2<T> collide(const Poly2<T>& a, const Poly2<T>& b) {
+        return detail::satCollide(detail::makeSatShape(a), detail::makeSatShape(b));
+    }
+
+    /**
+     * @brief Narrowphase collision test between a convex Poly2 and a Rect2
+     * @param a the Poly2
+     * @param b the Rect2
+     * @return the collision manifold, with the normal pointing from a to b
+    */
+    template<typename T>
+    Manifold2<T> collide(const Poly2<T>& a, const Rect2<T>& b) {
+        return detail::satCollide(detail::makeSatShape(a), detail::RectSatShape<T>(b).view());
+    }
+
+    /**
+     * @brief Narrowphase collision test between a Rect2 and a convex Poly2
+     * @param a the Rect2
+     * @param b the Poly2
+     * @return the collision manifold, with the normal pointing from a to b
+    */
+    template<typename T>
+    Manifold2<T> collide(const Rect2<T>& a, const Poly2<T>& b) {
+        return detail::satCollide(detail::RectSatShape<T>(a).view(), detail::makeSatShape(b));
+    }
+
+    /**
+     * @brief Overlap test between two convex Poly2's
+     * @details runs the same early out SAT as collide, but skips building the manifold
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @return true if the Poly2's overlap, touching counts as overlapping
+    */
+    template<typename T>
+    bool overlaps(const Poly2<T>& a, const Poly2<T>& b) {
+        return detail::satOverlaps(detail::makeSatShape(a), detail::makeSatShape(b));
+    }
+
+    /**
+     * @brief Overlap test between a convex Poly2 and a Rect2
+     * @param a the Poly2
+     * @param b the Rect2
+     * @return true if the shapes overlap, touching counts as overlapping
+    */
+    template<typename T>
+    bool overlaps(const Poly2<T>& a, const Rect2<T>& b) {
+        return detail::satOverlaps(detail::makeSatShape(a), detail::RectSatShape<T>(b).view());
+    }
+
+    /**
+     * @brief Overlap test between a Rect2 and a convex Poly2
+     * @param a the Rect2
+     * @param b the Poly2
+     * @return true if the shapes overlap, touching counts as overlapping
+    */
+    template<typename T>
+    bool overlaps(const Rect2<T>& a, const Poly2<T>& b) {
+        return overlaps(b, a);
+    }
+}
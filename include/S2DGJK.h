@@ -0,0 +1,698 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <algorithm>
+#include "S2DMath.h"
+#include "S2DCollision.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class NormVec2;
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Poly2;
+
+    /**
+     * @brief Warm start data for the GJK queries
+     * @details stores which vertices of the two shapes made up the final simplex of the last
+     * query. Passing the same cache back in for the same pair of shapes on the next frame
+     * restarts GJK from that simplex, so coherent motion usually converges in one or two
+     * iterations. A default constructed cache is empty and starts from scratch. The cache
+     * only stores indices, so it stays valid when the shapes move, and is discarded
+     * automatically if an index no longer exists
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    struct SimplexCache2
+    {
+        /**
+         * @brief the number of simplex vertices stored, 0 to 3
+        */
+        size_t count = 0;
+
+        /**
+         * @brief the vertex index on the first shape of each simplex vertex
+        */
+        std::array<size_t, 3> indexA{};
+
+        /**
+         * @brief the vertex index on the second shape of each simplex vertex
+        */
+        std::array<size_t, 3> indexB{};
+    };
+
+    /**
+     * @brief The result of a GJK distance query
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    struct DistanceResult2
+    {
+        /**
+         * @brief the distance between the shapes, 0 if they overlap
+        */
+        T distance = (T)0.0;
+
+        /**
+         * @brief the closest point on the first shape
+        */
+        Point2<T> pointA;
+
+        /**
+         * @brief the closest point on the second shape
+        */
+        Point2<T> pointB;
+
+        /**
+         * @brief true if the shapes overlap or touch
+        */
+        bool overlapping = false;
+
+        /**
+         * @brief the number of GJK iterations the query took
+        */
+        size_t iterations = 0;
+    };
+
+    namespace detail {
+
+        /**
+         * @brief a non owning view of the vertices of a convex shape, for the GJK routines
+        */
+        template<typename T>
+        struct GjkShape {
+            const Point2<T>* points;
+            size_t count;
+
+            /**
+             * @brief finds the vertex furthest along dir
+             * @details the projections of a convex polygon's vertices onto any direction are
+             * unimodal around the polygon, so the search hill climbs from the hint vertex instead
+             * of scanning every vertex; with a hint from the previous iteration or frame this is
+             * usually a step or two even for very large polygons. Repeated and collinear vertices
+             * leave runs of equal projections, the climb walks across those rather than stopping
+             * @param dx the x component of the direction
+             * @param dy the y component of the direction
+             * @param hint the vertex to start from
+             * @return the index of the support vertex
+            */
+            size_t support(const T& dx, const T& dy, size_t hint) const noexcept {
+                auto proj = [&](const size_t i) {
+                    return points[i].x * dx + points[i].y * dy;
+                };
+                auto step = [&](const size_t i, const bool forward) {
+                    return forward ? (i + 1 == count ? 0 : i + 1) : (i == 0 ? count - 1 : i - 1);
+                };
+
+                if (hint >= count) hint = 0;
+                T best = proj(hint);
+
+                //true if the first vertex that differs from the hint in this direction projects further
+                auto improves = [&](const bool forward) {
+                    size_t i = step(hint, forward);
+                    for (size_t steps = 1; steps < count; steps++) {
+                        T val = proj(i);
+                        if (val != best) {
+                            return val > best;
+                        }
+                        i = step(i, forward);
+                    }
+                    return false;
+                };
+
+                const bool forward = improves(true);
+                if (!forward && !improves(false)) {
+                    return hint;
+                }
+
+                //walk in the improving direction, across ties, until the projection drops
+                size_t next = step(hint, forward);
+                for (size_t steps = 1; steps < count; steps++) {
+                    T nextVal = proj(next);
+                    if (nextVal < best) {
+                        break;
+                    }
+                    if (nextVal > best) {
+                        hint = next;
+                        best = nextVal;
+                    }
+                    next = step(next, forward);
+                }
+                return hint;
+            }
+        };
+
+        template<typename T>
+        GjkShape<T> makeGjkShape(const Poly2<T>& poly) noexcept {
+            return GjkShape<T>{ poly.getPoints().data(), poly.size() };
+        }
+
+        /**
+         * @brief a vertex of the Minkowski difference A - B, together with the points that produced it
+        */
+        template<typename T>
+        struct SimplexVertex {
+            Point2<T> wA;
+            Point2<T> wB;
+            Vec2<T> w;
+            T a = (T)1.0;
+            size_t indexA = 0;
+            size_t indexB = 0;
+        };
+
+        template<typename T>
+        SimplexVertex<T> makeSimplexVertex(const GjkShape<T>& a, const GjkShape<T>& b, const size_t ia, const size_t ib) noexcept {
+            SimplexVertex<T> v;
+            v.indexA = ia;
+            v.indexB = ib;
+            v.wA = a.points[ia];
+            v.wB = b.points[ib];
+            v.w = Vec2<T>(v.wA.x - v.wB.x, v.wA.y - v.wB.y);
+            return v;
+        }
+
+        template<typename T>
+        SimplexVertex<T> supportVertex(const GjkShape<T>& a, const GjkShape<T>& b,
+            const T& dx, const T& dy, const size_t hintA, const size_t hintB) noexcept {
+            return makeSimplexVertex(a, b, a.support(dx, dy, hintA), b.support(-dx, -dy, hintB));
+        }
+
+        template<typename T>
+        constexpr T cross(const Vec2<T>& a, const Vec2<T>& b) noexcept {
+            return a.x * b.y - a.y * b.x;
+        }
+
+        template<typename T>
+        constexpr T dot(const Vec2<T>& a, const Vec2<T>& b) noexcept {
+            return a.x * b.x + a.y * b.y;
+        }
+
+        /**
+         * @brief the GJK simplex, reduced after every step to the feature closest to the origin
+        */
+        template<typename T>
+        struct Simplex {
+            std::array<SimplexVertex<T>, 3> v;
+            size_t count = 0;
+
+            /**
+             * @brief closest point to the origin on a segment, in barycentric coordinates
+            */
+            void solve2() noexcept {
+                Vec2<T> e12(v[1].w.x - v[0].w.x, v[1].w.y - v[0].w.y);
+
+                T d12_2 = -dot(v[0].w, e12);
+                if (d12_2 <= (T)0.0) {
+                    v[0].a = (T)1.0;
+                    count = 1;
+                    return;
+                }
+
+                T d12_1 = dot(v[1].w, e12);
+                if (d12_1 <= (T)0.0) {
+                    v[1].a = (T)1.0;
+                    count = 1;
+                    v[0] = v[1];
+                    return;
+                }
+
+                T inv = (T)1.0 / (d12_1 + d12_2);
+                v[0].a = d12_1 * inv;
+                v[1].a = d12_2 * inv;
+                count = 2;
+            }
+
+            /**
+             * @brief closest point to the origin on a triangle, in barycentric coordinates
+             * @details checks the vertex, edge and interior voronoi regions of the triangle
+            */
+            void solve3() noexcept {
+                const Vec2<T>& w1 = v[0].w;
+                const Vec2<T>& w2 = v[1].w;
+                const Vec2<T>& w3 = v[2].w;
+
+                Vec2<T> e12(w2.x - w1.x, w2.y - w1.y);
+                T d12_1 = dot(w2, e12);
+                T d12_2 = -dot(w1, e12);
+
+                Vec2<T> e13(w3.x - w1.x, w3.y - w1.y);
+                T d13_1 = dot(w3, e13);
+                T d13_2 = -dot(w1, e13);
+
+                Vec2<T> e23(w3.x - w2.x, w3.y - w2.y);
+                T d23_1 = dot(w3, e23);
+                T d23_2 = -dot(w2, e23);
+
+                T n123 = cross(e12, e13);
+                T d123_1 = n123 * cross(w2, w3);
+                T d123_2 = n123 * cross(w3, w1);
+                T d123_3 = n123 * cross(w1, w2);
+
+                if (d12_2 <= (T)0.0 && d13_2 <= (T)0.0) {
+                    v[0].a = (T)1.0;
+                    count = 1;
+                    return;
+                }
+
+                if (d12_1 > (T)0.0 && d12_2 > (T)0.0 && d123_3 <= (T)0.0) {
+                    T inv = (T)1.0 / (d12_1 + d12_2);
+                    v[0].a = d12_1 * inv;
+                    v[1].a = d12_2 * inv;
+                    count = 2;
+                    return;
+                }
+
+                if (d13_1 > (T)0.0 && d13_2 > (T)0.0 && d123_2 <= (T)0.0) {
+                    T inv = (T)1.0 / (d13_1 + d13_2);
+                    v[0].a = d13_1 * inv;
+                    v[2].a = d13_2 * inv;
+                    count = 2;
+                    v[1] = v[2];
+                    return;
+                }
+
+                if (d12_1 <= (T)0.0 && d23_2 <= (T)0.0) {
+                    v[1].a = (T)1.0;
+                    count = 1;
+                    v[0] = v[1];
+                    return;
+                }
+
+                if (d13_1 <= (T)0.0 && d23_1 <= (T)0.0) {
+                    v[2].a = (T)1.0;
+                    count = 1;
+                    v[0] = v[2];
+                    return;
+                }
+
+                if (d23_1 > (T)0.0 && d23_2 > (T)0.0 && d123_1 <= (T)0.0) {
+                    T inv = (T)1.0 / (d23_1 + d23_2);
+                    v[1].a = d23_1 * inv;
+                    v[2].a = d23_2 * inv;
+                    count = 2;
+                    v[0] = v[2];
+                    return;
+                }
+
+                T inv = (T)1.0 / (d123_1 + d123_2 + d123_3);
+                v[0].a = d123_1 * inv;
+                v[1].a = d123_2 * inv;
+                v[2].a = d123_3 * inv;
+                count = 3;
+            }
+
+            /**
+             * @brief the direction from the simplex towards the origin, not normalized
+             * @details for a segment the perpendicular is used instead of the negated closest
+             * point, which loses precision when the origin is close to the segment
+            */
+            Vec2<T> searchDirection() const noexcept {
+                if (count == 1) {
+                    return Vec2<T>(-v[0].w.x, -v[0].w.y);
+                }
+                Vec2<T> e12(v[1].w.x - v[0].w.x, v[1].w.y - v[0].w.y);
+                T sgn = cross(e12, Vec2<T>(-v[0].w.x, -v[0].w.y));
+                if (sgn > (T)0.0) {
+                    return Vec2<T>(-e12.y, e12.x);
+                }
+                else {
+                    return Vec2<T>(e12.y, -e12.x);
+                }
+            }
+
+            /**
+             * @brief computes the closest points on both shapes from the barycentric coordinates
+            */
+            void witnessPoints(Point2<T>& pA, Point2<T>& pB) const noexcept {
+                if (count == 1) {
+                    pA = v[0].wA;
+                    pB = v[0].wB;
+                }
+                else if (count == 2) {
+                    pA = Point2<T>(v[0].a * v[0].wA.x + v[1].a * v[1].wA.x, v[0].a * v[0].wA.y + v[1].a * v[1].wA.y);
+                    pB = Point2<T>(v[0].a * v[0].wB.x + v[1].a * v[1].wB.x, v[0].a * v[0].wB.y + v[1].a * v[1].wB.y);
+                }
+                else {
+                    pA = Point2<T>(
+                        v[0].a * v[0].wA.x + v[1].a * v[1].wA.x + v[2].a * v[2].wA.x,
+                        v[0].a * v[0].wA.y + v[1].a * v[1].wA.y + v[2].a * v[2].wA.y);
+                    pB = pA;
+                }
+            }
+
+            void readCache(const SimplexCache2<T>& cache, const GjkShape<T>& a, const GjkShape<T>& b) noexcept {
+                count = 0;
+                for (size_t i = 0; i < cache.count; i++) {
+                    if (cache.indexA[i] >= a.count || cache.indexB[i] >= b.count) {
+                        count = 0;
+                        break;
+                    }
+                    v[count++] = makeSimplexVertex(a, b, cache.indexA[i], cache.indexB[i]);
+                }
+
+                //the shapes may have moved enough to collapse the cached simplex, restart from its first vertex
+                if (count == 2 && v[0].w.x == v[1].w.x && v[0].w.y == v[1].w.y) {
+                    count = 1;
+                }
+                if (count == 3 && cross(Vec2<T>(v[1].w.x - v[0].w.x, v[1].w.y - v[0].w.y),
+                                        Vec2<T>(v[2].w.x - v[0].w.x, v[2].w.y - v[0].w.y)) == (T)0.0) {
+                    count = 1;
+                }
+
+                if (count == 0) {
+                    seed(a, b);
+                }
+            }
+
+            /**
+             * @brief starts the simplex from a support point, so that every vertex lies on the
+             * boundary of the Minkowski difference, which EPA relies on
+            */
+            void seed(const GjkShape<T>& a, const GjkShape<T>& b) noexcept {
+                v[0] = supportVertex(a, b, (T)1.0, (T)0.0, 0, 0);
+                count = 1;
+            }
+
+            void writeCache(SimplexCache2<T>& cache) const noexcept {
+                cache.count = count;
+                for (size_t i = 0; i < count; i++) {
+                    cache.indexA[i] = v[i].indexA;
+                    cache.indexB[i] = v[i].indexB;
+                }
+            }
+        };
+
+        /**
+         * @brief runs GJK until the simplex encloses the origin or stops getting closer to it
+         * @return the number of iterations taken
+        */
+        template<typename T>
+        size_t runGjk(const GjkShape<T>& a, const GjkShape<T>& b, Simplex<T>& simplex) noexcept {
+            const size_t maxIterations = a.count + b.count + 20;
+            const T epsilonSq = (T)1e-12;
+
+            size_t iter = 0;
+            while (iter < maxIterations) {
+
+                std::array<size_t, 3> saveA;
+                std::array<size_t, 3> saveB;
+                size_t saveCount = simplex.count;
+                for (size_t i = 0; i < saveCount; i++) {
+                    saveA[i] = simplex.v[i].indexA;
+                    saveB[i] = simplex.v[i].indexB;
+                }
+
+                if (simplex.count == 2) {
+                    simplex.solve2();
+                }
+                else if (simplex.count == 3) {
+                    simplex.solve3();
+                }
+
+                if (simplex.count == 3) {
+                    break;
+                }
+
+                Vec2<T> d = simplex.searchDirection();
+                if (dot(d, d) < epsilonSq) {
+                    //the origin is on the simplex, the shapes touch
+                    break;
+                }
+
+                SimplexVertex<T> vertex = supportVertex(a, b, d.x, d.y, simplex.v[0].indexA, simplex.v[0].indexB);
+                iter++;
+
+                bool duplicate = false;
+                for (size_t i = 0; i < saveCount; i++) {
+                    if (vertex.indexA == saveA[i] && vertex.indexB == saveB[i]) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+                if (duplicate) {
+                    break;
+                }
+
+                //no progress towards the origin, the simplex already holds the closest feature
+                if (dot(vertex.w, d) - dot(simplex.v[0].w, d) <= (T)0.0) {
+                    break;
+                }
+
+                simplex.v[simplex.count++] = vertex;
+            }
+            return iter;
+        }
+
+        /**
+         * @brief grows a degenerate simplex that touches the origin into a triangle for EPA
+         * @return false if the Minkowski difference has no area, and so no penetration
+        */
+        template<typename T>
+        bool completeSimplex(const GjkShape<T>& a, const GjkShape<T>& b, Simplex<T>& simplex) noexcept {
+            if (simplex.count == 1) {
+                const std::array<Vec2<T>, 4> dirs{
+                    Vec2<T>((T)1.0, (T)0.0), Vec2<T>((T)-1.0, (T)0.0), Vec2<T>((T)0.0, (T)1.0), Vec2<T>((T)0.0, (T)-1.0)
+                };
+                for (const auto& d : dirs) {
+                    SimplexVertex<T> vertex = supportVertex(a, b, d.x, d.y, simplex.v[0].indexA, simplex.v[0].indexB);
+                    if (vertex.w.x != simplex.v[0].w.x || vertex.w.y != simplex.v[0].w.y) {
+                        simplex.v[simplex.count++] = vertex;
+                        break;
+                    }
+                }
+                if (simplex.count == 1) return false;
+            }
+
+            if (simplex.count == 2) {
+                Vec2<T> e12(simplex.v[1].w.x - simplex.v[0].w.x, simplex.v[1].w.y - simplex.v[0].w.y);
+                for (T sgn : { (T)1.0, (T)-1.0 }) {
+                    SimplexVertex<T> vertex = supportVertex(a, b, -e12.y * sgn, e12.x * sgn, simplex.v[0].indexA, simplex.v[0].indexB);
+                    Vec2<T> e13(vertex.w.x - simplex.v[0].w.x, vertex.w.y - simplex.v[0].w.y);
+                    if (cross(e12, e13) != (T)0.0) {
+                        simplex.v[simplex.count++] = vertex;
+                        break;
+                    }
+                }
+                if (simplex.count == 2) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Expanding Polytope Algorithm, finds the face of the Minkowski difference closest to the origin
+         * @details the simplex must be a triangle containing the origin
+        */
+        template<typename T>
+        Manifold2<T> runEpa(const GjkShape<T>& a, const GjkShape<T>& b, const Simplex<T>& simplex) {
+            std::vector<SimplexVertex<T>> polytope(simplex.v.begin(), simplex.v.begin() + 3);
+            if (cross(Vec2<T>(polytope[1].w.x - polytope[0].w.x, polytope[1].w.y - polytope[0].w.y),
+                      Vec2<T>(polytope[2].w.x - polytope[0].w.x, polytope[2].w.y - polytope[0].w.y)) < (T)0.0) {
+                std::swap(polytope[1], polytope[2]);
+            }
+
+            const size_t maxIterations = a.count + b.count + 20;
+            const T tolerance = (T)1e-4;
+
+            size_t edge = 0;
+            T nx = (T)0.0;
+            T ny = (T)0.0;
+            T dist = (T)0.0;
+
+            for (size_t iter = 0; iter < maxIterations; iter++) {
+
+                //closest edge of the counter clockwise polytope, its outward normal is (e.y, -e.x)
+                bool first = true;
+                for (size_t i = 0; i < polytope.size(); i++) {
+                    size_t j = i + 1 == polytope.size() ? 0 : i + 1;
+                    T ex = polytope[j].w.x - polytope[i].w.x;
+                    T ey = polytope[j].w.y - polytope[i].w.y;
+                    T len = sqrt<T>(ex * ex + ey * ey);
+                    if (len == (T)0.0) continue;
+
+                    T enx = ey / len;
+                    T eny = -ex / len;
+                    T d = enx * polytope[i].w.x + eny * polytope[i].w.y;
+                    if (first || d < dist) {
+                        first = false;
+                        dist = d;
+                        nx = enx;
+                        ny = eny;
+                        edge = i;
+                    }
+                }
+
+                SimplexVertex<T> vertex = supportVertex(a, b, nx, ny, polytope[edge].indexA, polytope[edge].indexB);
+                T supportDist = nx * vertex.w.x + ny * vertex.w.y;
+                if (supportDist - dist <= tolerance * (abs<T>(dist) + (T)1.0)) {
+                    break;
+                }
+
+                bool duplicate = false;
+                for (const auto& p : polytope) {
+                    if (p.indexA == vertex.indexA && p.indexB == vertex.indexB) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+                if (duplicate) {
+                    break;
+                }
+
+                polytope.insert(polytope.begin() + (edge + 1), vertex);
+            }
+
+            //project the origin onto the closest edge to find the witness points
+            const auto& v0 = polytope[edge];
+            const auto& v1 = polytope[edge + 1 == polytope.size() ? 0 : edge + 1];
+            T ex = v1.w.x - v0.w.x;
+            T ey = v1.w.y - v0.w.y;
+            T lenSq = ex * ex + ey * ey;
+            T t = lenSq > (T)0.0 ? -(v0.w.x * ex + v0.w.y * ey) / lenSq : (T)0.0;
+            t = std::clamp(t, (T)0.0, (T)1.0);
+
+            Point2<T> pA(v0.wA.x + (v1.wA.x - v0.wA.x) * t, v0.wA.y + (v1.wA.y - v0.wA.y) * t);
+            Point2<T> pB(v0.wB.x + (v1.wB.x - v0.wB.x) * t, v0.wB.y + (v1.wB.y - v0.wB.y) * t);
+
+            Manifold2<T> result;
+            result.colliding = true;
+            result.depth = dist < (T)0.0 ? (T)0.0 : dist;
+            result.normal = NormVec2<T>(nx, ny);
+            result.contacts[0] = Point2<T>((pA.x + pB.x) / (T)2.0, (pA.y + pB.y) / (T)2.0);
+            result.contactCount = 1;
+            return result;
+        }
+
+        template<typename T>
+        DistanceResult2<T> gjkDistance(const GjkShape<T>& a, const GjkShape<T>& b, SimplexCache2<T>& cache) noexcept {
+            Simplex<T> simplex;
+            simplex.readCache(cache, a, b);
+
+            DistanceResult2<T> result;
+            result.iterations = runGjk(a, b, simplex);
+            simplex.writeCache(cache);
+            simplex.witnessPoints(result.pointA, result.pointB);
+
+            T dx = result.pointB.x - result.pointA.x;
+            T dy = result.pointB.y - result.pointA.y;
+            result.distance = simplex.count == 3 ? (T)0.0 : sqrt<T>(dx * dx + dy * dy);
+            result.overlapping = simplex.count == 3 || result.distance == (T)0.0;
+            return result;
+        }
+
+        template<typename T>
+        Manifold2<T> epaPenetration(const GjkShape<T>& a, const GjkShape<T>& b, SimplexCache2<T>& cache) {
+            const bool warmStarted = cache.count > 0;
+
+            Simplex<T> simplex;
+            simplex.readCache(cache, a, b);
+            runGjk(a, b, simplex);
+            simplex.writeCache(cache);
+
+            //cached vertices may have moved inside the Minkowski difference since the last frame,
+            //which would leave a reflex vertex in the polytope, so EPA restarts from a fresh simplex
+            Point2<T> pA;
+            Point2<T> pB;
+            simplex.witnessPoints(pA, pB);
+            if (warmStarted && pA == pB) {
+                simplex.seed(a, b);
+                runGjk(a, b, simplex);
+                simplex.witnessPoints(pA, pB);
+            }
+
+            if (simplex.count < 3) {
+                if (pA != pB || !completeSimplex(a, b, simplex)) {
+                    //separated, or touching with no overlapping area
+                    Manifold2<T> result;
+                    result.colliding = pA == pB;
+                    if (result.colliding) {
+                        result.contacts[0] = pA;
+                        result.contactCount = 1;
+                    }
+                    return result;
+                }
+            }
+            return runEpa(a, b, simplex);
+        }
+    }
+
+    /**
+     * @brief GJK distance query between two convex Poly2's
+     * @details cost grows with the number of GJK iterations rather than the vertex counts,
+     * which makes it a better fit than SAT for polygons with many vertices
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @param cache the warm start cache for this pair, updated with the final simplex
+     * @return the distance and the closest points on both Poly2's
+    */
+    template<typename T>
+    DistanceResult2<T> gjkDistance(const Poly2<T>& a, const Poly2<T>& b, SimplexCache2<T>& cache) noexcept {
+        return detail::gjkDistance(detail::makeGjkShape(a), detail::makeGjkShape(b), cache);
+    }
+
+    /**
+     * @brief GJK distance query between two convex Poly2's, without warm starting
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @return the distance and the closest points on both Poly2's
+    */
+    template<typename T>
+    DistanceResult2<T> gjkDistance(const Poly2<T>& a, const Poly2<T>& b) noexcept {
+        SimplexCache2<T> cache;
+        return gjkDistance(a, b, cache);
+    }
+
+    /**
+     * @brief GJK overlap test between two convex Poly2's
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @param cache the warm start cache for this pair, updated with the final simplex
+     * @return true if the Poly2's overlap, touching counts as overlapping
+    */
+    template<typename T>
+    bool gjkIntersects(const Poly2<T>& a, const Poly2<T>& b, SimplexCache2<T>& cache) noexcept {
+        return gjkDistance(a, b, cache).overlapping;
+    }
+
+    /**
+     * @brief GJK overlap test between two convex Poly2's, without warm starting
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @return true if the Poly2's overlap, touching counts as overlapping
+    */
+    template<typename T>
+    bool gjkIntersects(const Poly2<T>& a, const Poly2<T>& b) noexcept {
+        SimplexCache2<T> cache;
+        return gjkIntersects(a, b, cache);
+    }
+
+    /**
+     * @brief GJK and EPA penetration query between two convex Poly2's
+     * @details GJK finds whether the Poly2's overlap, then EPA expands the final simplex to
+     * find the penetration depth and normal. A single contact point is reported, halfway
+     * between the deepest points of the two Poly2's
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @param cache the warm start cache for this pair, updated with the final GJK simplex
+     * @return the collision manifold, with the normal pointing from a to b
+    */
+    template<typename T>
+    Manifold2<T> epaPenetration(const Poly2<T>& a, const Poly2<T>& b, SimplexCache2<T>& cache) {
+        return detail::epaPenetration(detail::makeGjkShape(a), detail::makeGjkShape(b), cache);
+    }
+
+    /**
+     * @brief GJK and EPA penetration query between two convex Poly2's, without warm starting
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @return the collision manifold, with the normal pointing from a to b
+    */
+    template<typename T>
+    Manifold2<T> epaPenetration(const Poly2<T>& a, const Poly2<T>& b) {
+        SimplexCache2<T> cache;
+        return epaPenetration(a, b, cache);
+    }
+}
@@ -0,0 +1,268 @@
+#pragma once
+#include <span>
+#include <vector>
+#include <future>
+#include <thread>
+#include <algorithm>
+#include <utility>
+#include "S2DTags.h"
+
+#ifndef S2D_HULL_PARALLEL_THRESHOLD
+#define S2D_HULL_PARALLEL_THRESHOLD 65536
+#endif
+
+namespace Space2D {
+
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Poly2;
+
+    namespace detail {
+
+        /**
+         * @brief twice the signed area of the triangle o, a, b
+         * @return positive when b lies left of the line from o to a, 0 when the three are collinear
+        */
+        template<typename T>
+        constexpr T hullCross(const Point2<T>& o, const Point2<T>& a, const Point2<T>& b) noexcept {
+            return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+        }
+
+        /**
+         * @brief orders points by x, then by y
+         * @details exact, unlike Point2::operator== which compares within epsilon
+        */
+        template<typename T>
+        constexpr bool hullLess(const Point2<T>& a, const Point2<T>& b) noexcept {
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+        }
+
+        /**
+         * @brief checks two points for exact equality
+         * @details hullCross(o, a, a) is only 0 when nothing fuses its multiplies, under FMA
+         * contraction a copy of a line's own end can land on either side of it
+        */
+        template<typename T>
+        constexpr bool hullSame(const Point2<T>& a, const Point2<T>& b) noexcept {
+            return a.x == b.x && a.y == b.y;
+        }
+
+        /**
+         * @brief copies the points that could be corners of the hull
+         * @details a point strictly inside the quadrilateral of the lowest, rightmost, highest
+         * and leftmost points can never be a hull corner; on spread out clouds this discards most
+         * of the input in one linear pass, before anything is sorted or partitioned
+         * @param points the points to filter
+         * @param out receives the remaining points
+        */
+        template<typename T>
+        void hullCandidates(std::span<const Point2<T>> points, std::vector<Point2<T>>& out) {
+            out.clear();
+            if (points.empty()) return;
+
+            Point2<T> left = points[0];
+            Point2<T> right = points[0];
+            Point2<T> bottom = points[0];
+            Point2<T> top = points[0];
+            for (const Point2<T>& p : points) {
+                if (p.x < left.x) left = p;
+                if (p.x > right.x) right = p;
+                if (p.y < bottom.y) bottom = p;
+                if (p.y > top.y) top = p;
+            }
+
+            //counter clockwise, a degenerate edge gives a cross of 0 and keeps everything
+            const Point2<T> quad[4] = { bottom, right, top, left };
+            for (const Point2<T>& p : points) {
+                bool inside = hullCross(quad[0], quad[1], p) > (T)0.0 && hullCross(quad[1], quad[2], p) > (T)0.0 &&
+                    hullCross(quad[2], quad[3], p) > (T)0.0 && hullCross(quad[3], quad[0], p) > (T)0.0;
+                if (!inside) out.push_back(p);
+            }
+        }
+
+        /**
+         * @brief Andrew's monotone chain
+         * @details sorts the points, then builds the lower and upper chains with a stack,
+         * dropping every corner that does not turn left
+         * @param points the points, reordered in place
+         * @param hull receives the hull corners, counter clockwise from the lowest x point
+        */
+        template<typename T>
+        void monotoneChain(std::vector<Point2<T>>& points, std::vector<Point2<T>>& hull) {
+            std::sort(points.begin(), points.end(), hullLess<T>);
+            points.erase(std::unique(points.begin(), points.end(),
+                hullSame<T>), points.end());
+
+            hull.clear();
+            if (points.size() < 3) {
+                hull = points;
+                return;
+            }
+
+            hull.resize(2 * points.size());
+            size_t k = 0;
+            for (size_t i = 0; i < points.size(); i++) {
+                while (k >= 2 && hullCross(hull[k - 2], hull[k - 1], points[i]) <= (T)0.0) k--;
+                hull[k++] = points[i];
+            }
+            for (size_t i = points.size() - 1, lower = k + 1; i > 0; i--) {
+                while (k >= lower && hullCross(hull[k - 2], hull[k - 1], points[i - 1]) <= (T)0.0) k--;
+                hull[k++] = points[i - 1];
+            }
+            hull.resize(k - 1);
+        }
+
+        /**
+         * @brief QuickHull
+         * @details splits the points by the line between the lowest and highest x point, then
+         * repeatedly takes the point farthest outside each hull edge found so far and throws
+         * away the points inside the triangle it makes. The recursion runs on an explicit stack,
+         * since clouds with many hull corners can recurse as deep as the input is long
+         * @param points the points, reordered in place
+         * @param hull receives the hull corners, counter clockwise from the lowest x point
+        */
+        template<typename T>
+        void quickHullSides(std::vector<Point2<T>>& points, std::vector<Point2<T>>& hull) {
+            hull.clear();
+            if (points.empty()) return;
+
+            auto [minIt, maxIt] = std::minmax_element(points.begin(), points.end(), hullLess<T>);
+            const Point2<T> a = *minIt;
+            const Point2<T> b = *maxIt;
+            hull.push_back(a);
+            if (!hullLess(a, b)) return;
+
+            //below the line goes from a to b, above it from b back to a, copies of a and b are on neither
+            auto off = [&](const Point2<T>& p) { return !hullSame(p, a) && !hullSame(p, b); };
+            auto lowerEnd = std::partition(points.begin(), points.end(),
+                [&](const Point2<T>& p) { return hullCross(a, b, p) < (T)0.0 && off(p); });
+            auto upperEnd = std::partition(lowerEnd, points.end(),
+                [&](const Point2<T>& p) { return hullCross(a, b, p) > (T)0.0 && off(p); });
+
+            //the points strictly right of from to to, emitting to once they are done
+            struct Side {
+                Point2<T> from;
+                Point2<T> to;
+                size_t first;
+                size_t last;
+                bool emit;
+            };
+            std::vector<Side> stack;
+            stack.push_back({ b, a, (size_t)(lowerEnd - points.begin()), (size_t)(upperEnd - points.begin()), false });
+            stack.push_back({ b, b, 0, 0, true });
+            stack.push_back({ a, b, 0, (size_t)(lowerEnd - points.begin()), false });
+
+            while (!stack.empty()) {
+                Side side = stack.back();
+                stack.pop_back();
+                if (side.emit) {
+                    hull.push_back(side.to);
+                    continue;
+                }
+                if (side.first == side.last) continue;
+
+                size_t far = side.first;
+                T farCross = hullCross(side.from, side.to, points[far]);
+                for (size_t i = side.first + 1; i < side.last; i++) {
+                    T cross = hullCross(side.from, side.to, points[i]);
+                    if (cross < farCross) {
+                        farCross = cross;
+                        far = i;
+                    }
+                }
+                //c and its copies leave the range before it is split, so every side is strictly
+                //smaller than the last, see hullSame
+                std::swap(points[far], points[side.last - 1]);
+                const Point2<T> c = points[side.last - 1];
+
+                auto begin = points.begin();
+                auto mid = std::partition(begin + side.first, begin + side.last - 1,
+                    [&](const Point2<T>& p) { return hullCross(side.from, c, p) < (T)0.0 && !hullSame(p, c); });
+                auto end = std::partition(mid, begin + side.last - 1,
+                    [&](const Point2<T>& p) { return hullCross(c, side.to, p) < (T)0.0 && !hullSame(p, c); });
+
+                stack.push_back({ c, side.to, (size_t)(mid - begin), (size_t)(end - begin), false });
+                stack.push_back({ c, c, 0, 0, true });
+                stack.push_back({ side.from, c, side.first, (size_t)(mid - begin), false });
+            }
+        }
+
+        /**
+         * @brief runs a hull algorithm over the points, split across threads for large inputs
+         * @details above S2D_HULL_PARALLEL_THRESHOLD points the input is cut into one contiguous
+         * chunk per thread, each chunk is hulled on its own, and the hull of the chunk hulls is
+         * the hull of everything
+         * @param points the points to hull
+         * @param threads the most threads to use, 0 for one per hardware thread
+         * @param algorithm the hull of a scratch vector of points
+        */
+        template<typename T, typename Algorithm>
+        Poly2<T> buildHull(std::span<const Point2<T>> points, unsigned threads, Algorithm algorithm) {
+            auto chunkHull = [&](std::span<const Point2<T>> chunk) {
+                std::vector<Point2<T>> scratch;
+                std::vector<Point2<T>> hull;
+                hullCandidates(chunk, scratch);
+                algorithm(scratch, hull);
+                return hull;
+            };
+
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            const size_t count = points.size();
+            const size_t chunks = count < S2D_HULL_PARALLEL_THRESHOLD ? 1 :
+                std::min<size_t>(threads, count / (S2D_HULL_PARALLEL_THRESHOLD / 2));
+
+            std::vector<Point2<T>> hull;
+            if (chunks <= 1) {
+                hull = chunkHull(points);
+            }
+            else {
+                std::vector<std::future<std::vector<Point2<T>>>> pending;
+                for (size_t c = 1; c < chunks; c++) {
+                    size_t first = count * c / chunks;
+                    size_t last = count * (c + 1) / chunks;
+                    pending.push_back(std::async(std::launch::async, chunkHull, points.subspan(first, last - first)));
+                }
+
+                std::vector<Point2<T>> merged = chunkHull(points.subspan(0, count / chunks));
+                for (auto& part : pending) {
+                    std::vector<Point2<T>> partHull = part.get();
+                    merged.insert(merged.end(), partHull.begin(), partHull.end());
+                }
+                algorithm(merged, hull);
+            }
+            return Poly2<T>(trustedConvex, typename Poly2<T>::PointStorage(hull.begin(), hull.end()));
+        }
+    }
+
+    /**
+     * @brief Builds the convex hull of a set of points with Andrew's monotone chain
+     * @details the corners come out counter clockwise, starting from the point with the lowest
+     * x (then lowest y), without duplicate or collinear points, so the face normals of the
+     * result point outward. Fewer than 3 distinct or only collinear points give a Poly2 of 1 or 2
+     * points, and no points an empty one. Above S2D_HULL_PARALLEL_THRESHOLD points the work is
+     * split across threads
+     * @param points the points to hull
+     * @param threads the most threads to use, 0 for one per hardware thread
+     * @return the convex hull
+    */
+    template<typename T>
+    Poly2<T> convexHull(std::span<const Point2<T>> points, unsigned threads = 0) {
+        return detail::buildHull(points, threads, detail::monotoneChain<T>);
+    }
+
+    /**
+     * @brief Builds the convex hull of a set of points with QuickHull
+     * @details gives the same Poly2 as convexHull. QuickHull skips the sort and so tends to win
+     * when few points end up on the hull, but degrades towards O(n^2) when most of them do
+     * @param points the points to hull
+     * @param threads the most threads to use, 0 for one per hardware thread
+     * @return the convex hull
+    */
+    template<typename T>
+    Poly2<T> quickHull(std::span<const Point2<T>> points, unsigned threads = 0) {
+        return detail::buildHull(points, threads, detail::quickHullSides<T>);
+    }
+}
@@ -0,0 +1,353 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <initializer_list>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+
+namespace Space2D {
+
+    /**
+     * @brief Sequence container with room for N elements stored inline
+     * @details Behaves like a minimal std::vector, but the first N elements live inside the
+     * object itself, so small sequences never touch the heap. Once the size grows past N
+     * the elements spill over to an internal std::vector; shrinking back to N or less moves
+     * them inline again but keeps the heap capacity around for reuse
+     * @tparam T the element type, must be default constructible
+     * @tparam N the number of elements stored inline
+    */
+    template<typename T, size_t N>
+    class InlineVec
+    {
+    public:
+
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        /**
+         * @brief Constructs an empty InlineVec
+        */
+        constexpr InlineVec() noexcept(std::is_nothrow_default_constructible_v<T>) = default;
+
+        /**
+         * @brief Constructs an InlineVec of count default constructed elements
+         * @param count the number of elements
+        */
+        constexpr explicit InlineVec(const size_t count) {
+            resize(count);
+        }
+
+        /**
+         * @brief Constructs an InlineVec from an initializer list
+         * @param list the elements to copy
+        */
+        constexpr InlineVec(const std::initializer_list<T>& list) {
+            assign(list.begin(), list.end());
+        }
+
+        /**
+         * @brief Constructs an InlineVec from an iterator range
+         * @param first the beginning of the range
+         * @param last one past the end of the range
+        */
+        template<typename It>
+        constexpr InlineVec(It first, It last) {
+            assign(first, last);
+        }
+
+        constexpr InlineVec(const InlineVec&) = default;
+        constexpr InlineVec& operator=(const InlineVec&) = default;
+
+        /**
+         * @brief Move constructs an InlineVec, the source is left empty
+         * @details the heap storage is taken over, so the count has to go with it
+         * @param other the InlineVec to move from
+        */
+        constexpr InlineVec(InlineVec&& other) noexcept(std::is_nothrow_move_assignable_v<T>)
+            : heap(std::move(other.heap)), count(other.count) {
+            std::move(other.local.begin(), other.local.end(), local.begin());
+            other.heap.clear();
+            other.count = 0;
+        }
+
+        /**
+         * @brief Move assigns an InlineVec, the source is left empty
+         * @param other the InlineVec to move from
+         * @return a reference to this InlineVec
+        */
+        constexpr InlineVec& operator=(InlineVec&& other) noexcept(std::is_nothrow_move_assignable_v<T>) {
+            if (this != &other) {
+                std::move(other.local.begin(), other.local.end(), local.begin());
+                heap = std::move(other.heap);
+                count = other.count;
+                other.heap.clear();
+                other.count = 0;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Replaces the contents with an iterator range
+         * @param first the beginning of the range
+         * @param last one past the end of the range
+        */
+        template<typename It>
+        constexpr void assign(It first, It last) {
+            resize(static_cast<size_t>(std::distance(first, last)));
+            std::copy(first, last, begin());
+        }
+
+        /**
+         * @brief Returns the number of elements
+         * @return the number of elements
+        */
+        constexpr size_t size() const noexcept {
+            return count;
+        }
+
+        /**
+         * @brief Checks if the InlineVec holds no elements
+         * @return true if there are no elements
+        */
+        constexpr bool empty() const noexcept {
+            return count == 0;
+        }
+
+        /**
+         * @brief Checks if the elements currently live in the heap storage
+         * @return true if the size is larger than the inline capacity
+        */
+        constexpr bool onHeap() const noexcept {
+            return count > N;
+        }
+
+        /**
+         * @brief Reserves heap storage ahead of time for count elements
+         * @details has no effect when count fits inline
+         * @param capacity the number of elements to reserve for
+        */
+        constexpr void reserve(const size_t capacity) {
+            if (capacity > N) heap.reserve(capacity);
+        }
+
+        /**
+         * @brief Resizes the InlineVec, new elements are default constructed
+         * @param newCount the new number of elements
+        */
+        constexpr void resize(const size_t newCount) {
+            if (newCount <= N) {
+                if (onHeap()) {
+                    std::copy(heap.begin(), heap.begin() + newCount, local.begin());
+                    heap.clear();
+                }
+                else {
+                    for (size_t i = count; i < newCount; i++) {
+                        local[i] = T();
+                    }
+                }
+            }
+            else {
+                if (!onHeap()) {
+                    heap.assign(local.begin(), local.begin() + count);
+                }
+                heap.resize(newCount);
+            }
+            count = newCount;
+        }
+
+        /**
+         * @brief Removes all elements, keeping any heap capacity
+        */
+        constexpr void clear() {
+            resize(0);
+        }
+
+        /**
+         * @brief Appends an element
+         * @param value the element to append
+        */
+        constexpr void push_back(const T& value) {
+            if (count < N) {
+                local[count++] = value;
+            }
+            else {
+                if (count == N) {
+                    heap.assign(local.begin(), local.end());
+                }
+                heap.push_back(value);
+                count++;
+            }
+        }
+
+        /**
+         * @brief Removes the last element
+        */
+        constexpr void pop_back() {
+            resize(count - 1);
+        }
+
+        /**
+         * @brief Raw access to the elements
+         * @return a pointer to the first element
+        */
+        constexpr T* data() noexcept {
+            return onHeap() ? heap.data() : local.data();
+        }
+
+        /**
+         * @brief Raw access to the elements
+         * @return a read only pointer to the first element
+        */
+        constexpr const T* data() const noexcept {
+            return onHeap() ? heap.data() : local.data();
+        }
+
+        /**
+         * @brief Unchecked element access
+         * @param i The index
+         * @return a read and write reference to the element
+        */
+        constexpr T& operator[] (const size_t i) noexcept {
+            return data()[i];
+        }
+
+        /**
+         * @brief Unchecked element access
+         * @param i The index
+         * @return a read only reference to the element
+        */
+        constexpr const T& operator[] (const size_t i) const noexcept {
+            return data()[i];
+        }
+
+        /**
+         * @brief Bounds checked element access
+         * @param i The index
+         * @return a read and write reference to the element
+        */
+        constexpr T& at(const size_t i) {
+            if (i >= count) throw std::out_of_range("InlineVec subscript out of range");
+            return data()[i];
+        }
+
+        /**
+         * @brief Bounds checked element access
+         * @param i The index
+         * @return a read only reference to the element
+        */
+        constexpr const T& at(const size_t i) const {
+            if (i >= count) throw std::out_of_range("InlineVec subscript out of range");
+            return data()[i];
+        }
+
+        /**
+         * @brief Access to the first element, the InlineVec must not be empty
+         * @return a reference to the first element
+        */
+        constexpr T& front() noexcept {
+            return data()[0];
+        }
+
+        /**
+         * @brief Access to the first element, the InlineVec must not be empty
+         * @return a read only reference to the first element
+        */
+        constexpr const T& front() const noexcept {
+            return data()[0];
+        }
+
+        /**
+         * @brief Access to the last element, the InlineVec must not be empty
+         * @return a reference to the last element
+        */
+        constexpr T& back() noexcept {
+            return data()[count - 1];
+        }
+
+        /**
+         * @brief Access to the last element, the InlineVec must not be empty
+         * @return a read only reference to the last element
+        */
+        constexpr const T& back() const noexcept {
+            return data()[count - 1];
+        }
+
+        /**
+         * @brief Beginning of the Iterator range
+         * @return An iterator at the first element
+        */
+        constexpr iterator begin() noexcept {
+            return data();
+        }
+
+        /**
+         * @brief One past the end of the Iterator range
+         * @return An iterator one past the last element
+        */
+        constexpr iterator end() noexcept {
+            return data() + count;
+        }
+
+        /**
+         * @brief Beginning of the Iterator range
+         * @return A const iterator at the first element
+        */
+        constexpr const_iterator begin() const noexcept {
+            return data();
+        }
+
+        /**
+         * @brief One past the end of the Iterator range
+         * @return A const iterator one past the last element
+        */
+        constexpr const_iterator end() const noexcept {
+            return data() + count;
+        }
+
+        /**
+         * @brief Beginning of the Iterator range
+         * @return A const iterator at the first element
+        */
+        constexpr const_iterator cbegin() const noexcept {
+            return data();
+        }
+
+        /**
+         * @brief One past the end of the Iterator range
+         * @return A const iterator one past the last element
+        */
+        constexpr const_iterator cend() const noexcept {
+            return data() + count;
+        }
+
+        /**
+         * @brief Equality operator for InlineVec
+         * @param other The InlineVec to compare with
+         * @return true if both hold equal elements in the same order
+        */
+        constexpr bool operator==(const InlineVec& other) const {
+            return count == other.count && std::equal(begin(), end(), other.begin());
+        }
+
+    private:
+
+        /**
+         * @brief the inline element storage, used while count <= N
+        */
+        std::array<T, N> local{};
+
+        /**
+         * @brief the spill over storage, holds every element while count > N
+        */
+        std::vector<T> heap;
+
+        /**
+         * @brief the number of elements
+        */
+        size_t count = 0;
+    };
+}
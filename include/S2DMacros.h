@@ -122,7 +122,7 @@ operator lhstyp<T>(rhstyp<T>& rhs) {\
 #ifndef S2D_OPS_ITR
 #define S2D_OPS_ITR(lhst, rhst, op) \
     template<typename T>\
-    constexpr inline lhst<T>& operator##op##=(lhst<T>& lhs, const rhst<T>& rhs) noexcept {\
+    constexpr inline lhst<T>& operator op##=(lhst<T>& lhs, const rhst<T>& rhs) noexcept {\
         size_t rhstNum = rhs.numVals();\
         size_t lhstNum = lhs.numVals();\
         size_t count = 0;\
@@ -134,7 +134,7 @@ operator lhstyp<T>(rhstyp<T>& rhs) {\
         return *this;\
 	}\
     template<typename T>\
-	constexpr inline lhst<T> operator##op(const lhst<T>& lhs, const rhst<T>& rhs) noexcept { \
+	constexpr inline lhst<T> operator op(const lhst<T>& lhs, const rhst<T>& rhs) noexcept { \
         lhst<T> retval;\
         size_t rhstNum = rhs.numVals();\
         size_t lhstNum = lhs.numVals();\
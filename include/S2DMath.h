@@ -1,5 +1,6 @@
 #pragma once
 #include <cmath>
+#include "S2DTrig.h"
 
 namespace Space2D {
 	template<typename T>
@@ -19,7 +20,7 @@ namespace Space2D {
 #define S2D_STDMATH_FN(fn)\
 	template<typename T>\
 	inline T fn(const T a) noexcept {\
-		return (T)(std::##fn((double)a));\
+		return (T)(std::fn((double)a));\
 	}
 #endif
 
@@ -36,13 +37,7 @@ namespace Space2D {
 	//	return static_cast<T>(std::sin(static_cast<double>(a)));
 	//}
 
-	inline float cos(const Radians a) noexcept {
-		return std::cos(a.get());
-	}
-
-	inline float sin(const Radians a) noexcept {
-		return std::sin(a.get());
-	}
+	//sin, cos and sincos of Radians live in S2DTrig.h
 }
 
 //standard linear interpolation
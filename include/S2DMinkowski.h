@@ -0,0 +1,293 @@
+#pragma once
+#include <span>
+#include <cmath>
+#include <future>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "S2DTags.h"
+#include "S2DClip.h"
+
+#ifndef S2D_INFLATE_PARALLEL_THRESHOLD
+#define S2D_INFLATE_PARALLEL_THRESHOLD 1024
+#endif
+
+namespace Space2D {
+
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Poly2;
+
+    namespace detail {
+
+        /**
+         * @brief the face of a convex polygon leaving corner i of its counter clockwise view
+        */
+        template<typename T>
+        constexpr Vec2<T> ccwFaceVec(const Poly2<T>& poly, const CCWView<T>& view, const size_t i) {
+            if (!view.reversed) return poly.getFaceVec(i);
+            return -poly.getFaceVec(i + 2 > view.count ? view.count - 1 : view.count - 2 - i);
+        }
+
+        /**
+         * @brief the index of the lowest corner of a counter clockwise view, the leftmost of ties
+        */
+        template<typename T>
+        constexpr size_t lowestCorner(const CCWView<T>& view) {
+            size_t lowest = 0;
+            for (size_t i = 1; i < view.count; i++) {
+                if (view[i].y < view[lowest].y || (view[i].y == view[lowest].y && view[i].x < view[lowest].x)) {
+                    lowest = i;
+                }
+            }
+            return lowest;
+        }
+
+        /**
+         * @brief appends the corners that round one corner of an inflated polygon
+         * @details the corner is turned through in steps, each a face tangent to the circle of
+         * the inflation distance around the corner, so the result holds the true rounded
+         * offset. A single step gives the mitred corner of the two offset faces meeting
+         * @param out the inflated corners
+         * @param corner the corner being rounded
+         * @param from the outward normal of the face entering the corner
+         * @param turn the signed angle from that normal to the normal of the face leaving it
+         * @param distance the inflation distance
+         * @param steps the number of faces to round the corner with
+        */
+        template<typename Storage, typename T>
+        void inflateCorner(Storage& out, const Point2<T>& corner, const double fromX, const double fromY,
+            const double turn, const double distance, const size_t steps) {
+
+            const double step = turn / (double)steps;
+            const double stepCos = std::cos(step);
+            const double stepSin = std::sin(step);
+            const double halfCos = std::cos(step * 0.5);
+            const double halfSin = std::sin(step * 0.5);
+            const double radius = distance / halfCos;
+
+            //the first face touches the circle half a step in, each next one a step further
+            double dirX = fromX * halfCos - fromY * halfSin;
+            double dirY = fromX * halfSin + fromY * halfCos;
+            for (size_t j = 0; j < steps; j++) {
+                out.push_back(Point2<T>(corner.x + (T)(radius * dirX), corner.y + (T)(radius * dirY)));
+                double nextX = dirX * stepCos - dirY * stepSin;
+                dirY = dirX * stepSin + dirY * stepCos;
+                dirX = nextX;
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the Minkowski sum of two convex Poly2's in O(n + m)
+     * @details both Poly2's are walked counter clockwise from their lowest corner, and their
+     * faces, taken from getFaceVec, are merged in order of angle. The sum of convex Poly2's is
+     * convex, so out is refilled through Poly2::refill without the convexity check, reusing its
+     * point storage. The result is wound the same way as a, without collinear corners, and is
+     * emptied if it has no area
+     * @param a the first Poly2, must not be out
+     * @param b the second Poly2, must not be out
+     * @param out receives the sum
+     * @return true if the sum has any area
+    */
+    template<typename T>
+    bool minkowskiSum(const Poly2<T>& a, const Poly2<T>& b, Poly2<T>& out) {
+        if (&a == &out || &b == &out) throw std::logic_error("minkowskiSum output must not be one of its inputs");
+
+        const auto& pa = a.getPoints();
+        const auto& pb = b.getPoints();
+        const size_t n = pa.size();
+        const size_t m = pb.size();
+
+        out.refill(trustedConvex, [&](typename Poly2<T>::PointStorage& points) {
+            if (n == 0 || m == 0) return;
+
+            const bool aReversed = detail::windingSign(pa.data(), n) < (T)0.0;
+            const detail::CCWView<T> P{ pa.data(), n, aReversed };
+            const detail::CCWView<T> Q{ pb.data(), m, detail::windingSign(pb.data(), m) < (T)0.0 };
+            const size_t startA = detail::lowestCorner(P);
+            const size_t startB = detail::lowestCorner(Q);
+
+            //starting from the lowest corners, both face sequences turn through one full circle
+            Point2<T> corner(P[startA].x + Q[startB].x, P[startA].y + Q[startB].y);
+            size_t i = 0;
+            size_t j = 0;
+            while (i < n || j < m) {
+                points.push_back(corner);
+                Vec2<T> faceA = i < n ? detail::ccwFaceVec(a, P, (startA + i) % n) : Vec2<T>();
+                Vec2<T> faceB = j < m ? detail::ccwFaceVec(b, Q, (startB + j) % m) : Vec2<T>();
+                T turn = faceA.cross(faceB);
+
+                if (j == m || (i < n && turn > (T)0.0)) {
+                    corner = corner + faceA;
+                    i++;
+                }
+                else if (i == n || turn < (T)0.0) {
+                    corner = corner + faceB;
+                    j++;
+                }
+                else {
+                    corner = corner + faceA + faceB;
+                    i++;
+                    j++;
+                }
+            }
+
+            detail::clipFinish(points, (T)1.0);
+            if (aReversed) {
+                std::reverse(points.begin(), points.end());
+            }
+        });
+        return out.size() != 0;
+    }
+
+    /**
+     * @brief Computes the Minkowski sum of two convex Poly2's in O(n + m)
+     * @param a the first Poly2
+     * @param b the second Poly2
+     * @return the sum, empty if it has no area
+    */
+    template<typename T>
+    Poly2<T> minkowskiSum(const Poly2<T>& a, const Poly2<T>& b) {
+        Poly2<T> out(trustedConvex, typename Poly2<T>::PointStorage());
+        minkowskiSum(a, b, out);
+        return out;
+    }
+
+    /**
+     * @brief Grows a convex Poly2 outward by a distance
+     * @details every face moves out along its cached normal. With roundSegments of 0 the moved
+     * faces meet in mitred corners, except that corners turning by more than a right angle get
+     * extra faces, so no corner reaches further than sqrt(2) times the distance. Otherwise each
+     * corner is rounded with faces tangent to its circle, a full turn being split into
+     * roundSegments faces, so the result always holds every point within the distance of poly.
+     * A single point inflates to a square or a round, a segment to a capsule. Refills out like
+     * minkowskiSum, wound the same way as poly
+     * @param poly the Poly2 to inflate, must not be out
+     * @param distance how far to move the faces, must not be negative
+     * @param out receives the inflated Poly2
+     * @param roundSegments the faces a full turn of rounded corners is split into, 0 for mitred corners
+     * @return true if the result has any area
+    */
+    template<typename T>
+    bool inflate(const Poly2<T>& poly, const T& distance, Poly2<T>& out, const size_t roundSegments = 0) {
+        if (&poly == &out) throw std::logic_error("inflate output must not be its input");
+        if (distance < (T)0.0) throw std::logic_error("inflate distance must not be negative");
+
+        constexpr double pi = 3.14159265358979323846;
+        const size_t n = poly.size();
+
+        out.refill(trustedConvex, [&](typename Poly2<T>::PointStorage& points) {
+            if (n == 0) return;
+
+            const auto& corners = poly.getPoints();
+            const double sign = (double)detail::windingSign(corners.data(), n);
+            const double dist = (double)distance;
+
+            auto steps = [&](const double turn) {
+                double full = std::abs(turn) / (2.0 * pi);
+                size_t count = (size_t)std::ceil(std::abs(turn) / (0.5 * pi) - 1e-9);
+                if (roundSegments != 0) {
+                    count = std::max(count, (size_t)std::ceil(full * (double)roundSegments - 1e-9));
+                }
+                return std::max<size_t>(count, 1);
+            };
+
+            //faces of no length have no normal, so corners are rounded between real faces only
+            size_t last = n;
+            for (size_t i = n; i-- > 0;) {
+                Vec2<T> face = poly.getFaceVec(i);
+                if (face.x != (T)0.0 || face.y != (T)0.0) {
+                    last = i;
+                    break;
+                }
+            }
+            if (last == n) {
+                detail::inflateCorner(points, corners[0], 0.0, -1.0, 2.0 * pi, dist, steps(2.0 * pi));
+                detail::clipFinish(points, (T)1.0);
+                return;
+            }
+
+            const auto& normals = poly.getFaceNormals();
+            double fromX = sign * (double)normals[last].x;
+            double fromY = sign * (double)normals[last].y;
+            for (size_t i = 0; i < n; i++) {
+                Vec2<T> face = poly.getFaceVec(i);
+                if (face.x == (T)0.0 && face.y == (T)0.0) continue;
+
+                double toX = sign * (double)normals[i].x;
+                double toY = sign * (double)normals[i].y;
+                double cross = sign * (fromX * toY - fromY * toX);
+                double turn = sign * std::atan2(cross == 0.0 ? 0.0 : cross, fromX * toX + fromY * toY);
+
+                detail::inflateCorner(points, corners[i], fromX, fromY, turn, dist, steps(turn));
+                fromX = toX;
+                fromY = toY;
+            }
+            detail::clipFinish(points, (T)sign);
+        });
+        return out.size() != 0;
+    }
+
+    /**
+     * @brief Grows a convex Poly2 outward by a distance
+     * @param poly the Poly2 to inflate
+     * @param distance how far to move the faces, must not be negative
+     * @param roundSegments the faces a full turn of rounded corners is split into, 0 for mitred corners
+     * @return the inflated Poly2
+    */
+    template<typename T>
+    Poly2<T> inflate(const Poly2<T>& poly, const T& distance, const size_t roundSegments = 0) {
+        Poly2<T> out(trustedConvex, typename Poly2<T>::PointStorage());
+        inflate(poly, distance, out, roundSegments);
+        return out;
+    }
+
+    /**
+     * @brief Inflates a whole set of convex Poly2's, such as the obstacles of a level as it loads
+     * @details from S2D_INFLATE_PARALLEL_THRESHOLD Poly2's on, the set is cut into one
+     * contiguous chunk per thread. Each out entry is refilled like inflate
+     * @param polys the Poly2's to inflate
+     * @param distance how far to move the faces, must not be negative
+     * @param out receives the inflated Poly2 of each input, must be at least as long as polys
+     * and must not overlap it
+     * @param roundSegments the faces a full turn of rounded corners is split into, 0 for mitred corners
+     * @param threads the most threads to use, 0 for one per hardware thread
+    */
+    template<typename T>
+    void inflateBatch(std::span<const Poly2<T>> polys, const T& distance, std::span<Poly2<T>> out,
+        const size_t roundSegments = 0, unsigned threads = 0) {
+
+        if (out.size() < polys.size()) throw std::out_of_range("inflateBatch output is smaller than the input");
+        if (polys.data() < out.data() + out.size() && out.data() < polys.data() + polys.size()) {
+            throw std::logic_error("inflateBatch output must not overlap its input");
+        }
+        if (distance < (T)0.0) throw std::logic_error("inflate distance must not be negative");
+
+        auto inflateRange = [&](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; i++) {
+                inflate(polys[i], distance, out[i], roundSegments);
+            }
+        };
+
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        const size_t count = polys.size();
+        const size_t chunks = count < S2D_INFLATE_PARALLEL_THRESHOLD ? 1 :
+            std::min<size_t>(threads, count / (S2D_INFLATE_PARALLEL_THRESHOLD / 2));
+
+        std::vector<std::future<void>> pending;
+        for (size_t c = 1; c < chunks; c++) {
+            pending.push_back(std::async(std::launch::async, inflateRange, count * c / chunks, count * (c + 1) / chunks));
+        }
+        inflateRange(0, count / chunks);
+        for (auto& part : pending) {
+            part.get();
+        }
+    }
+}
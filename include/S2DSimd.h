@@ -0,0 +1,526 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <limits>
+#include <algorithm>
+
+/*
+  SIMD selection for the batch kernels used by the Space2D containers.
+  The widest instruction set the compiler was told it may use is picked at
+  compile time (/arch:AVX2 on MSVC, -mavx2 -mfma on gcc/clang), SSE2 is
+  assumed on any x86-64 target, and everything else falls back to plain
+  scalar loops. Define S2D_NO_SIMD before including Space2D to force the
+  scalar paths
+*/
+
+#ifndef S2D_NO_SIMD
+#if defined(__AVX2__)
+#define S2D_SIMD_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define S2D_SIMD_SSE2
+#endif
+#endif
+
+#if defined(S2D_SIMD_AVX2) || defined(S2D_SIMD_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace Space2D {
+
+    /**
+     * @brief Alignment in bytes used for all SIMD friendly Space2D buffers,
+     * wide enough for one AVX register
+    */
+    inline constexpr size_t simdAlignment = 32;
+
+    /**
+     * @brief Minimal allocator handing out storage aligned to a fixed boundary
+     * @details used by the structure of arrays containers so that every coordinate
+     * array starts on a SIMD register boundary
+     * @tparam U the type being allocated
+     * @tparam Align the requested alignment in bytes
+    */
+    template<typename U, size_t Align = simdAlignment>
+    struct AlignedAllocator {
+
+        using value_type = U;
+
+        template<typename Other>
+        struct rebind {
+            using other = AlignedAllocator<Other, Align>;
+        };
+
+        constexpr AlignedAllocator() noexcept = default;
+
+        template<typename Other>
+        constexpr AlignedAllocator(const AlignedAllocator<Other, Align>&) noexcept {}
+
+        U* allocate(const size_t n) {
+            if (n > std::numeric_limits<size_t>::max() / sizeof(U)) throw std::bad_array_new_length();
+            return static_cast<U*>(::operator new(n * sizeof(U), std::align_val_t(Align)));
+        }
+
+        void deallocate(U* p, const size_t) noexcept {
+            ::operator delete(p, std::align_val_t(Align));
+        }
+
+        template<typename Other>
+        constexpr bool operator==(const AlignedAllocator<Other, Align>&) const noexcept {
+            return true;
+        }
+    };
+
+    namespace simd {
+
+        /**
+         * @brief Applies the affine transform [a b tx; c d ty] to n points stored as separate x and y arrays
+         * @details the input and output arrays may alias each other exactly (in place transform),
+         * but must not partially overlap
+         * @param xin the input x coordinates
+         * @param yin the input y coordinates
+         * @param xout the output x coordinates
+         * @param yout the output y coordinates
+         * @param n the number of points
+        */
+        inline void affineTransform(
+            const float* xin, const float* yin, float* xout, float* yout, const size_t n,
+            const float a, const float b, const float tx,
+            const float c, const float d, const float ty) noexcept {
+
+            size_t i = 0;
+
+#if defined(S2D_SIMD_AVX2)
+            const __m256 va = _mm256_set1_ps(a);
+            const __m256 vb = _mm256_set1_ps(b);
+            const __m256 vtx = _mm256_set1_ps(tx);
+            const __m256 vc = _mm256_set1_ps(c);
+            const __m256 vd = _mm256_set1_ps(d);
+            const __m256 vty = _mm256_set1_ps(ty);
+
+            for (; i + 8 <= n; i += 8) {
+                const __m256 x = _mm256_loadu_ps(xin + i);
+                const __m256 y = _mm256_loadu_ps(yin + i);
+                //no fused multiply add, so the result rounds the same way as the SSE2 path and Mat3::transform
+                const __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(va, x), _mm256_mul_ps(vb, y)), vtx);
+                const __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vc, x), _mm256_mul_ps(vd, y)), vty);
+                _mm256_storeu_ps(xout + i, rx);
+                _mm256_storeu_ps(yout + i, ry);
+            }
+#endif
+
+#if defined(S2D_SIMD_SSE2)
+            const __m128 sa = _mm_set1_ps(a);
+            const __m128 sb = _mm_set1_ps(b);
+            const __m128 stx = _mm_set1_ps(tx);
+            const __m128 sc = _mm_set1_ps(c);
+            const __m128 sd = _mm_set1_ps(d);
+            const __m128 sty = _mm_set1_ps(ty);
+
+            for (; i + 4 <= n; i += 4) {
+                const __m128 x = _mm_loadu_ps(xin + i);
+                const __m128 y = _mm_loadu_ps(yin + i);
+                const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(sa, x), _mm_mul_ps(sb, y)), stx);
+                const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(sc, x), _mm_mul_ps(sd, y)), sty);
+                _mm_storeu_ps(xout + i, rx);
+                _mm_storeu_ps(yout + i, ry);
+            }
+#endif
+
+            for (; i < n; i++) {
+                const float x = xin[i];
+                const float y = yin[i];
+                xout[i] = a * x + b * y + tx;
+                yout[i] = c * x + d * y + ty;
+            }
+        }
+
+        /**
+         * @brief Slab test of one ray against one box
+         * @details multiplies by the reciprocal of the direction like the vector paths, so the
+         * tails of the batches agree with their bodies
+         * @param ox the x coordinate of the ray origin
+         * @param oy the y coordinate of the ray origin
+         * @param dx the x component of the ray direction, may be 0
+         * @param dy the y component of the ray direction, may be 0
+         * @param minX the left of the box
+         * @param minY the top of the box
+         * @param maxX the right of the box
+         * @param maxY the bottom of the box
+         * @param maxT the end of the ray
+         * @return the fraction along the ray where it enters the box, 0 if it starts inside,
+         * or infinity if it misses the box before maxT
+        */
+        inline float raySlab(
+            const float ox, const float oy, const float dx, const float dy,
+            const float minX, const float minY, const float maxX, const float maxY, const float maxT) noexcept {
+
+            constexpr float inf = std::numeric_limits<float>::infinity();
+            float enter = 0.0f;
+            float exit = maxT;
+
+            if (dx == 0.0f) {
+                if (ox < minX || ox > maxX) return inf;
+            }
+            else {
+                const float inv = 1.0f / dx;
+                const float t1 = (minX - ox) * inv;
+                const float t2 = (maxX - ox) * inv;
+                enter = std::max(enter, std::min(t1, t2));
+                exit = std::min(exit, std::max(t1, t2));
+            }
+
+            if (dy == 0.0f) {
+                if (oy < minY || oy > maxY) return inf;
+            }
+            else {
+                const float inv = 1.0f / dy;
+                const float t1 = (minY - oy) * inv;
+                const float t2 = (maxY - oy) * inv;
+                enter = std::max(enter, std::min(t1, t2));
+                exit = std::min(exit, std::max(t1, t2));
+            }
+
+            return enter <= exit ? enter : inf;
+        }
+
+#if defined(S2D_SIMD_AVX2)
+        /**
+         * @brief clips the entry and exit fractions of 8 rays against one slab
+         * @details a ray parallel to the slab is either inside it for its whole length or never,
+         * which replaces the infinities and NaNs the division produces for it
+        */
+        inline void raySlabAxis8(const __m256 o, const __m256 d, const __m256 invD, const __m256 lo, const __m256 hi,
+            __m256& enter, __m256& exit) noexcept {
+
+            const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+            const __m256 negInf = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+
+            const __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(lo, o), invD);
+            const __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(hi, o), invD);
+            __m256 near = _mm256_min_ps(t1, t2);
+            __m256 far = _mm256_max_ps(t1, t2);
+
+            const __m256 parallel = _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_EQ_OQ);
+            const __m256 inside = _mm256_and_ps(_mm256_cmp_ps(o, lo, _CMP_GE_OQ), _mm256_cmp_ps(o, hi, _CMP_LE_OQ));
+            near = _mm256_blendv_ps(near, _mm256_blendv_ps(inf, negInf, inside), parallel);
+            far = _mm256_blendv_ps(far, _mm256_blendv_ps(negInf, inf, inside), parallel);
+
+            enter = _mm256_max_ps(enter, near);
+            exit = _mm256_min_ps(exit, far);
+        }
+
+        /**
+         * @brief loads 8 records of 4 floats and transposes them so each register holds one field of all 8
+        */
+        inline void transpose8x4(const float* records, __m256& f0, __m256& f1, __m256& f2, __m256& f3) noexcept {
+            const __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(records)), _mm_loadu_ps(records + 16), 1);
+            const __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(records + 4)), _mm_loadu_ps(records + 20), 1);
+            const __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(records + 8)), _mm_loadu_ps(records + 24), 1);
+            const __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(records + 12)), _mm_loadu_ps(records + 28), 1);
+
+            const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+            const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+            const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+            const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+
+            f0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            f1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            f2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            f3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        inline __m256 raySlabFinish8(const __m256 enter, const __m256 exit) noexcept {
+            const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+            return _mm256_blendv_ps(inf, enter, _mm256_cmp_ps(enter, exit, _CMP_LE_OQ));
+        }
+#endif
+
+#if defined(S2D_SIMD_SSE2)
+        /**
+         * @brief SSE2 version of raySlabAxis8, SSE2 has no blend so selects are and/andnot/or
+        */
+        inline void raySlabAxis4(const __m128 o, const __m128 d, const __m128 invD, const __m128 lo, const __m128 hi,
+            __m128& enter, __m128& exit) noexcept {
+
+            const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+            const __m128 negInf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+            auto select = [](const __m128 mask, const __m128 a, const __m128 b) {
+                return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+            };
+
+            const __m128 t1 = _mm_mul_ps(_mm_sub_ps(lo, o), invD);
+            const __m128 t2 = _mm_mul_ps(_mm_sub_ps(hi, o), invD);
+            __m128 near = _mm_min_ps(t1, t2);
+            __m128 far = _mm_max_ps(t1, t2);
+
+            const __m128 parallel = _mm_cmpeq_ps(d, _mm_setzero_ps());
+            const __m128 inside = _mm_and_ps(_mm_cmpge_ps(o, lo), _mm_cmple_ps(o, hi));
+            near = select(parallel, select(inside, negInf, inf), near);
+            far = select(parallel, select(inside, inf, negInf), far);
+
+            enter = _mm_max_ps(enter, near);
+            exit = _mm_min_ps(exit, far);
+        }
+
+        inline __m128 raySlabFinish4(const __m128 enter, const __m128 exit) noexcept {
+            const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+            const __m128 hit = _mm_cmple_ps(enter, exit);
+            return _mm_or_ps(_mm_and_ps(hit, enter), _mm_andnot_ps(hit, inf));
+        }
+#endif
+
+        /**
+         * @brief Slab tests one ray against n boxes
+         * @details the boxes are stored as interleaved minX, minY, maxX, maxY records, which is
+         * the layout of an array of Rect2<float>, and are transposed in registers
+         * @param boxes the boxes, 4 floats each
+         * @param n the number of boxes
+         * @param ox the x coordinate of the ray origin
+         * @param oy the y coordinate of the ray origin
+         * @param dx the x component of the ray direction, may be 0
+         * @param dy the y component of the ray direction, may be 0
+         * @param maxT the end of the ray
+         * @param tOut receives the result of raySlab for each box
+        */
+        inline void raySlabBoxes(const float* boxes, const size_t n,
+            const float ox, const float oy, const float dx, const float dy, const float maxT, float* tOut) noexcept {
+
+            size_t i = 0;
+
+#if defined(S2D_SIMD_AVX2)
+            {
+                const __m256 vox = _mm256_set1_ps(ox);
+                const __m256 voy = _mm256_set1_ps(oy);
+                const __m256 vdx = _mm256_set1_ps(dx);
+                const __m256 vdy = _mm256_set1_ps(dy);
+                const __m256 vinvX = _mm256_set1_ps(1.0f / dx);
+                const __m256 vinvY = _mm256_set1_ps(1.0f / dy);
+                const __m256 vmaxT = _mm256_set1_ps(maxT);
+
+                for (; i + 8 <= n; i += 8) {
+                    __m256 minX, minY, maxX, maxY;
+                    transpose8x4(boxes + i * 4, minX, minY, maxX, maxY);
+                    __m256 enter = _mm256_setzero_ps();
+                    __m256 exit = vmaxT;
+                    raySlabAxis8(vox, vdx, vinvX, minX, maxX, enter, exit);
+                    raySlabAxis8(voy, vdy, vinvY, minY, maxY, enter, exit);
+                    _mm256_storeu_ps(tOut + i, raySlabFinish8(enter, exit));
+                }
+            }
+#endif
+
+#if defined(S2D_SIMD_SSE2)
+            {
+                const __m128 vox = _mm_set1_ps(ox);
+                const __m128 voy = _mm_set1_ps(oy);
+                const __m128 vdx = _mm_set1_ps(dx);
+                const __m128 vdy = _mm_set1_ps(dy);
+                const __m128 vinvX = _mm_set1_ps(1.0f / dx);
+                const __m128 vinvY = _mm_set1_ps(1.0f / dy);
+                const __m128 vmaxT = _mm_set1_ps(maxT);
+
+                for (; i + 4 <= n; i += 4) {
+                    __m128 minX = _mm_loadu_ps(boxes + i * 4);
+                    __m128 minY = _mm_loadu_ps(boxes + i * 4 + 4);
+                    __m128 maxX = _mm_loadu_ps(boxes + i * 4 + 8);
+                    __m128 maxY = _mm_loadu_ps(boxes + i * 4 + 12);
+                    _MM_TRANSPOSE4_PS(minX, minY, maxX, maxY);
+                    __m128 enter = _mm_setzero_ps();
+                    __m128 exit = vmaxT;
+                    raySlabAxis4(vox, vdx, vinvX, minX, maxX, enter, exit);
+                    raySlabAxis4(voy, vdy, vinvY, minY, maxY, enter, exit);
+                    _mm_storeu_ps(tOut + i, raySlabFinish4(enter, exit));
+                }
+            }
+#endif
+
+            for (; i < n; i++) {
+                const float* b = boxes + i * 4;
+                tOut[i] = raySlab(ox, oy, dx, dy, b[0], b[1], b[2], b[3], maxT);
+            }
+        }
+
+        /**
+         * @brief Slab tests n rays against one box
+         * @details the rays are stored as interleaved ox, oy, dx, dy records, which is the
+         * layout of an array of Ray2<float>, and are transposed in registers
+         * @param rays the rays, 4 floats each
+         * @param n the number of rays
+         * @param minX the left of the box
+         * @param minY the top of the box
+         * @param maxX the right of the box
+         * @param maxY the bottom of the box
+         * @param maxT the end of every ray
+         * @param tOut receives the result of raySlab for each ray
+        */
+        inline void raySlabRays(const float* rays, const size_t n,
+            const float minX, const float minY, const float maxX, const float maxY, const float maxT, float* tOut) noexcept {
+
+            size_t i = 0;
+
+#if defined(S2D_SIMD_AVX2)
+            {
+                const __m256 vminX = _mm256_set1_ps(minX);
+                const __m256 vminY = _mm256_set1_ps(minY);
+                const __m256 vmaxX = _mm256_set1_ps(maxX);
+                const __m256 vmaxY = _mm256_set1_ps(maxY);
+                const __m256 vmaxT = _mm256_set1_ps(maxT);
+                const __m256 one = _mm256_set1_ps(1.0f);
+
+                for (; i + 8 <= n; i += 8) {
+                    __m256 ox, oy, dx, dy;
+                    transpose8x4(rays + i * 4, ox, oy, dx, dy);
+                    __m256 enter = _mm256_setzero_ps();
+                    __m256 exit = vmaxT;
+                    raySlabAxis8(ox, dx, _mm256_div_ps(one, dx), vminX, vmaxX, enter, exit);
+                    raySlabAxis8(oy, dy, _mm256_div_ps(one, dy), vminY, vmaxY, enter, exit);
+                    _mm256_storeu_ps(tOut + i, raySlabFinish8(enter, exit));
+                }
+            }
+#endif
+
+#if defined(S2D_SIMD_SSE2)
+            {
+                const __m128 vminX = _mm_set1_ps(minX);
+                const __m128 vminY = _mm_set1_ps(minY);
+                const __m128 vmaxX = _mm_set1_ps(maxX);
+                const __m128 vmaxY = _mm_set1_ps(maxY);
+                const __m128 vmaxT = _mm_set1_ps(maxT);
+                const __m128 one = _mm_set1_ps(1.0f);
+
+                for (; i + 4 <= n; i += 4) {
+                    __m128 ox = _mm_loadu_ps(rays + i * 4);
+                    __m128 oy = _mm_loadu_ps(rays + i * 4 + 4);
+                    __m128 dx = _mm_loadu_ps(rays + i * 4 + 8);
+                    __m128 dy = _mm_loadu_ps(rays + i * 4 + 12);
+                    _MM_TRANSPOSE4_PS(ox, oy, dx, dy);
+                    __m128 enter = _mm_setzero_ps();
+                    __m128 exit = vmaxT;
+                    raySlabAxis4(ox, dx, _mm_div_ps(one, dx), vminX, vmaxX, enter, exit);
+                    raySlabAxis4(oy, dy, _mm_div_ps(one, dy), vminY, vmaxY, enter, exit);
+                    _mm_storeu_ps(tOut + i, raySlabFinish4(enter, exit));
+                }
+            }
+#endif
+
+            for (; i < n; i++) {
+                const float* r = rays + i * 4;
+                tOut[i] = raySlab(r[0], r[1], r[2], r[3], minX, minY, maxX, maxY, maxT);
+            }
+        }
+
+        /**
+         * @brief Tests which of n points lie strictly inside a convex polygon
+         * @details the points are stored as interleaved x, y pairs, which is the layout of an
+         * array of Point2<float>. A point is inside when it is strictly inside the bounding box
+         * and strictly left of every edge, that is ex * (y - py) - ey * (x - px) > 0 for the edge
+         * starting at (px, py) with direction (ex, ey). Edges are tested for several points at
+         * once, and a group of points stops as soon as all of them are known to be outside
+         * @param points the points, 2 floats each
+         * @param n the number of points
+         * @param px the x coordinate of the start of each edge
+         * @param py the y coordinate of the start of each edge
+         * @param ex the x component of each edge, flipped so the interior is on the left
+         * @param ey the y component of each edge, flipped so the interior is on the left
+         * @param edges the number of edges
+         * @param minX the left of the bounding box
+         * @param minY the top of the bounding box
+         * @param maxX the right of the bounding box
+         * @param maxY the bottom of the bounding box
+         * @param out receives 1 for each point inside and 0 for each point outside
+         * @return the number of points inside
+        */
+        inline size_t convexContains(const float* points, const size_t n,
+            const float* px, const float* py, const float* ex, const float* ey, const size_t edges,
+            const float minX, const float minY, const float maxX, const float maxY, unsigned char* out) noexcept {
+
+            size_t i = 0;
+            size_t count = 0;
+
+#if defined(S2D_SIMD_AVX2)
+            {
+                const __m256 vminX = _mm256_set1_ps(minX);
+                const __m256 vminY = _mm256_set1_ps(minY);
+                const __m256 vmaxX = _mm256_set1_ps(maxX);
+                const __m256 vmaxY = _mm256_set1_ps(maxY);
+                const __m256 zero = _mm256_setzero_ps();
+
+                for (; i + 8 <= n; i += 8) {
+                    const __m256 p0 = _mm256_loadu_ps(points + i * 2);
+                    const __m256 p1 = _mm256_loadu_ps(points + i * 2 + 8);
+                    //the in lane shuffles leave the points in the order 0 1 4 5 2 3 6 7, the permute restores it
+                    const __m256 x = _mm256_castpd_ps(_mm256_permute4x64_pd(
+                        _mm256_castps_pd(_mm256_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+                    const __m256 y = _mm256_castpd_ps(_mm256_permute4x64_pd(
+                        _mm256_castps_pd(_mm256_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+
+                    __m256 inside = _mm256_and_ps(
+                        _mm256_and_ps(_mm256_cmp_ps(x, vminX, _CMP_GT_OQ), _mm256_cmp_ps(x, vmaxX, _CMP_LT_OQ)),
+                        _mm256_and_ps(_mm256_cmp_ps(y, vminY, _CMP_GT_OQ), _mm256_cmp_ps(y, vmaxY, _CMP_LT_OQ)));
+
+                    for (size_t e = 0; e < edges && _mm256_movemask_ps(inside); e++) {
+                        const __m256 side = _mm256_sub_ps(
+                            _mm256_mul_ps(_mm256_set1_ps(ex[e]), _mm256_sub_ps(y, _mm256_set1_ps(py[e]))),
+                            _mm256_mul_ps(_mm256_set1_ps(ey[e]), _mm256_sub_ps(x, _mm256_set1_ps(px[e]))));
+                        inside = _mm256_and_ps(inside, _mm256_cmp_ps(side, zero, _CMP_GT_OQ));
+                    }
+
+                    const int mask = _mm256_movemask_ps(inside);
+                    for (size_t k = 0; k < 8; k++) {
+                        out[i + k] = (mask >> k) & 1;
+                        count += (mask >> k) & 1;
+                    }
+                }
+            }
+#endif
+
+#if defined(S2D_SIMD_SSE2)
+            {
+                const __m128 vminX = _mm_set1_ps(minX);
+                const __m128 vminY = _mm_set1_ps(minY);
+                const __m128 vmaxX = _mm_set1_ps(maxX);
+                const __m128 vmaxY = _mm_set1_ps(maxY);
+                const __m128 zero = _mm_setzero_ps();
+
+                for (; i + 4 <= n; i += 4) {
+                    const __m128 p0 = _mm_loadu_ps(points + i * 2);
+                    const __m128 p1 = _mm_loadu_ps(points + i * 2 + 4);
+                    const __m128 x = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+                    const __m128 y = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+
+                    __m128 inside = _mm_and_ps(
+                        _mm_and_ps(_mm_cmpgt_ps(x, vminX), _mm_cmplt_ps(x, vmaxX)),
+                        _mm_and_ps(_mm_cmpgt_ps(y, vminY), _mm_cmplt_ps(y, vmaxY)));
+
+                    for (size_t e = 0; e < edges && _mm_movemask_ps(inside); e++) {
+                        const __m128 side = _mm_sub_ps(
+                            _mm_mul_ps(_mm_set1_ps(ex[e]), _mm_sub_ps(y, _mm_set1_ps(py[e]))),
+                            _mm_mul_ps(_mm_set1_ps(ey[e]), _mm_sub_ps(x, _mm_set1_ps(px[e]))));
+                        inside = _mm_and_ps(inside, _mm_cmpgt_ps(side, zero));
+                    }
+
+                    const int mask = _mm_movemask_ps(inside);
+                    for (size_t k = 0; k < 4; k++) {
+                        out[i + k] = (mask >> k) & 1;
+                        count += (mask >> k) & 1;
+                    }
+                }
+            }
+#endif
+
+            for (; i < n; i++) {
+                const float x = points[i * 2];
+                const float y = points[i * 2 + 1];
+                bool inside = x > minX && x < maxX && y > minY && y < maxY;
+                for (size_t e = 0; e < edges && inside; e++) {
+                    inside = ex[e] * (y - py[e]) - ey[e] * (x - px[e]) > 0.0f;
+                }
+                out[i] = inside;
+                count += inside;
+            }
+            return count;
+        }
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace Space2D {
+
+    /**
+     * @brief Tag type selecting the Poly2 constructors that skip the convexity check
+     * @details only pass trustedConvex when the points are known to be convex already, such as
+     * points produced by transforming or translating an existing Poly2, a Poly2 built from
+     * unchecked points that turn out concave gives meaningless results from area and centroid
+    */
+    struct TrustedConvex {
+        explicit TrustedConvex() = default;
+    };
+
+    /**
+     * @brief The TrustedConvex tag value, ex:
+     *
+     *           Poly2f(trustedConvex, points);
+     *
+    */
+    inline constexpr TrustedConvex trustedConvex{};
+}
@@ -0,0 +1,325 @@
+#pragma once
+#include <span>
+#include <bit>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include "AngularType.h"
+#include "S2DSimd.h"
+
+/*
+  Sine and cosine of Radians with a selectable backend. exact goes to the
+  standard library, polynomial evaluates a minimax polynomial after reducing
+  the angle to a quarter turn, and table interpolates a table of one full turn.
+  The backend used by Mat3, Affine2 and NormVec2 is picked by defining
+  S2D_TRIG_PRECISION as exact, polynomial or table before including Space2D
+*/
+
+#ifndef S2D_TRIG_PRECISION
+#define S2D_TRIG_PRECISION exact
+#endif
+
+//number of entries of the table backend over one full turn, must be a power of two
+#ifndef S2D_TRIG_TABLE_SIZE
+#define S2D_TRIG_TABLE_SIZE 4096
+#endif
+
+namespace Space2D {
+
+    /**
+     * @brief The ways sin, cos and sincos can be computed
+    */
+    enum class TrigPrecision {
+        exact,      //the standard library, correctly rounded or close to it
+        polynomial, //a minimax polynomial, within trigMaxError of exact
+        table,      //linear interpolation of a table, within trigMaxError of exact
+    };
+
+    /**
+     * @brief The backend used when none is asked for, set through S2D_TRIG_PRECISION
+    */
+    inline constexpr TrigPrecision defaultTrigPrecision = TrigPrecision::S2D_TRIG_PRECISION;
+
+    /**
+     * @brief The largest absolute error of a backend against the true sine and cosine, for float angles
+    */
+    template<TrigPrecision P>
+    inline constexpr float trigMaxError = P == TrigPrecision::exact ? 0.0f :
+        P == TrigPrecision::polynomial ? 1.5e-7f : 4e-7f;
+
+    /**
+     * @brief The sine and cosine of one angle
+    */
+    struct SinCos {
+        float sin;
+        float cos;
+    };
+
+    namespace detail {
+
+        static_assert((S2D_TRIG_TABLE_SIZE & (S2D_TRIG_TABLE_SIZE - 1)) == 0, "S2D_TRIG_TABLE_SIZE must be a power of two");
+
+        inline constexpr float twoOverPi = 0.636619772367581343076f;
+
+        //pi / 2 split in three so that k * pi / 2 is exact in float for the k the polynomial accepts
+        inline constexpr float halfPiHi = 1.5703125f;
+        inline constexpr float halfPiMid = 4.837512969970703125e-4f;
+        inline constexpr float halfPiLo = 7.54978995489188216e-8f;
+
+        //past this the split above loses bits and the polynomial backends fall back to exact
+        inline constexpr float trigReduceLimit = 8192.0f;
+
+        //minimax coefficients over [-pi / 4, pi / 4]
+        inline constexpr float sinC3 = -1.6666654611e-1f;
+        inline constexpr float sinC5 = 8.3321608736e-3f;
+        inline constexpr float sinC7 = -1.9515295891e-4f;
+        inline constexpr float cosC4 = 4.166664568298827e-2f;
+        inline constexpr float cosC6 = -1.388731625493765e-3f;
+        inline constexpr float cosC8 = 2.443315711809948e-5f;
+
+        /**
+         * @brief sin(2 pi i / S2D_TRIG_TABLE_SIZE) for i in [0, S2D_TRIG_TABLE_SIZE], built on first use
+        */
+        inline const std::array<float, S2D_TRIG_TABLE_SIZE + 1>& sinTable() noexcept {
+            static const std::array<float, S2D_TRIG_TABLE_SIZE + 1> table = [] {
+                std::array<float, S2D_TRIG_TABLE_SIZE + 1> t{};
+                for (size_t i = 0; i <= S2D_TRIG_TABLE_SIZE; i++) {
+                    t[i] = (float)std::sin(6.283185307179586476925 * (double)i / S2D_TRIG_TABLE_SIZE);
+                }
+                return t;
+            }();
+            return table;
+        }
+
+        /**
+         * @brief reduces an angle to r in [-pi / 4, pi / 4] and its quarter turn k, angle = r + k pi / 2
+        */
+        inline float reduceQuarter(const float angle, int32_t& k) noexcept {
+            //rounded by hand, std::nearbyint is a library call without SSE4.1
+            const float q = angle * twoOverPi;
+            k = (int32_t)(q + std::copysign(0.5f, q));
+            const float kf = (float)k;
+            return ((angle - kf * halfPiHi) - kf * halfPiMid) - kf * halfPiLo;
+        }
+
+        inline SinCos sincosPolynomial(const float angle) noexcept {
+            if (!(std::abs(angle) <= trigReduceLimit)) return { std::sin(angle), std::cos(angle) };
+
+            int32_t k;
+            const float r = reduceQuarter(angle, k);
+            const float r2 = r * r;
+            const float s = r + r * r2 * (sinC3 + r2 * (sinC5 + r2 * sinC7));
+            const float c = 1.0f - 0.5f * r2 + r2 * r2 * (cosC4 + r2 * (cosC6 + r2 * cosC8));
+
+            //picked with masks as the SIMD lanes are, a switch on k mispredicts on random angles
+            const uint32_t swap = 0u - (uint32_t)(k & 1);
+            const uint32_t sBits = std::bit_cast<uint32_t>(s);
+            const uint32_t cBits = std::bit_cast<uint32_t>(c);
+            const uint32_t sinSign = (uint32_t)(k & 2) << 30;
+            const uint32_t cosSign = (uint32_t)((k + 1) & 2) << 30;
+            return {
+                std::bit_cast<float>(((sBits & ~swap) | (cBits & swap)) ^ sinSign),
+                std::bit_cast<float>(((cBits & ~swap) | (sBits & swap)) ^ cosSign)
+            };
+        }
+
+        inline SinCos sincosTable(const float angle) noexcept {
+            if (!(std::abs(angle) <= trigReduceLimit)) return { std::sin(angle), std::cos(angle) };
+
+            //reducing first keeps the table position exact for large angles
+            constexpr int32_t size = S2D_TRIG_TABLE_SIZE;
+            constexpr float perRadian = (float)(S2D_TRIG_TABLE_SIZE / 6.283185307179586476925);
+            int32_t k;
+            const float t = reduceQuarter(angle, k) * perRadian;
+            int32_t below = (int32_t)t;
+            below -= (float)below > t;
+            const float f = t - (float)below;
+            const int32_t i = (below + k * (size / 4)) & (size - 1);
+            const int32_t j = (i + size / 4) & (size - 1);
+
+            const auto& table = sinTable();
+            return {
+                table[i] + f * (table[i + 1] - table[i]),
+                table[j] + f * (table[j + 1] - table[j])
+            };
+        }
+    }
+
+    /**
+     * @brief Computes the sine and cosine of an angle together
+     * @details the polynomial and table backends share the reduction of the angle between both,
+     * and fall back to exact for angles beyond 8192 radians
+     * @tparam P the backend to compute them with
+     * @param a the angle
+     * @return the sine and cosine of a
+    */
+    template<TrigPrecision P = defaultTrigPrecision>
+    inline SinCos sincos(const Radians a) noexcept {
+        if constexpr (P == TrigPrecision::polynomial) return detail::sincosPolynomial(a.get());
+        else if constexpr (P == TrigPrecision::table) return detail::sincosTable(a.get());
+        else return { std::sin(a.get()), std::cos(a.get()) };
+    }
+
+    /**
+     * @brief Computes the sine of an angle
+     * @tparam P the backend to compute it with
+    */
+    template<TrigPrecision P = defaultTrigPrecision>
+    inline float sin(const Radians a) noexcept {
+        if constexpr (P == TrigPrecision::exact) return std::sin(a.get());
+        else return sincos<P>(a).sin;
+    }
+
+    /**
+     * @brief Computes the cosine of an angle
+     * @tparam P the backend to compute it with
+    */
+    template<TrigPrecision P = defaultTrigPrecision>
+    inline float cos(const Radians a) noexcept {
+        if constexpr (P == TrigPrecision::exact) return std::cos(a.get());
+        else return sincos<P>(a).cos;
+    }
+
+    namespace simd {
+
+        /**
+         * @brief Polynomial sine and cosine of n angles
+         * @details vectorized detail::sincosPolynomial, the quarter turn of each lane picks
+         * and negates its results without branches. A block holding an angle beyond the
+         * reduction limit, or NaN, is computed one angle at a time instead
+         * @param angles the angles in radians
+         * @param sinOut receives the sines, may alias angles exactly
+         * @param cosOut receives the cosines, may alias angles exactly
+         * @param n the number of angles
+        */
+        inline void sincosPolynomial(const float* angles, float* sinOut, float* cosOut, const size_t n) noexcept {
+            using namespace detail;
+            size_t i = 0;
+
+#if defined(S2D_SIMD_AVX2)
+            {
+                const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+                const __m256 limit = _mm256_set1_ps(trigReduceLimit);
+                const __m256i one = _mm256_set1_epi32(1);
+                const __m256i two = _mm256_set1_epi32(2);
+
+                for (; i + 8 <= n; i += 8) {
+                    const __m256 x = _mm256_loadu_ps(angles + i);
+                    if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_and_ps(x, absMask), limit, _CMP_LE_OQ)) != 0xff) {
+                        for (size_t j = i; j < i + 8; j++) {
+                            const SinCos sc = detail::sincosPolynomial(angles[j]);
+                            sinOut[j] = sc.sin;
+                            cosOut[j] = sc.cos;
+                        }
+                        continue;
+                    }
+
+                    const __m256 kf = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(twoOverPi)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                    const __m256i k = _mm256_cvtps_epi32(kf);
+                    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(kf, _mm256_set1_ps(halfPiHi)));
+                    r = _mm256_sub_ps(r, _mm256_mul_ps(kf, _mm256_set1_ps(halfPiMid)));
+                    r = _mm256_sub_ps(r, _mm256_mul_ps(kf, _mm256_set1_ps(halfPiLo)));
+                    const __m256 r2 = _mm256_mul_ps(r, r);
+
+                    __m256 s = _mm256_add_ps(_mm256_set1_ps(sinC5), _mm256_mul_ps(r2, _mm256_set1_ps(sinC7)));
+                    s = _mm256_add_ps(_mm256_set1_ps(sinC3), _mm256_mul_ps(r2, s));
+                    s = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, r2), s));
+                    __m256 c = _mm256_add_ps(_mm256_set1_ps(cosC6), _mm256_mul_ps(r2, _mm256_set1_ps(cosC8)));
+                    c = _mm256_add_ps(_mm256_set1_ps(cosC4), _mm256_mul_ps(r2, c));
+                    c = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(0.5f), r2)),
+                        _mm256_mul_ps(_mm256_mul_ps(r2, r2), c));
+
+                    //odd quarter turns swap sine and cosine, bit 1 of k and of k + 1 carries their signs
+                    const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(k, one), one));
+                    const __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(k, two), 30));
+                    const __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(k, one), two), 30));
+                    _mm256_storeu_ps(sinOut + i, _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sinSign));
+                    _mm256_storeu_ps(cosOut + i, _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosSign));
+                }
+            }
+#endif
+
+#if defined(S2D_SIMD_SSE2)
+            {
+                const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+                const __m128 limit = _mm_set1_ps(trigReduceLimit);
+                const __m128i one = _mm_set1_epi32(1);
+                const __m128i two = _mm_set1_epi32(2);
+                auto select = [](const __m128 mask, const __m128 a, const __m128 b) {
+                    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+                };
+
+                for (; i + 4 <= n; i += 4) {
+                    const __m128 x = _mm_loadu_ps(angles + i);
+                    if (_mm_movemask_ps(_mm_cmple_ps(_mm_and_ps(x, absMask), limit)) != 0xf) {
+                        for (size_t j = i; j < i + 4; j++) {
+                            const SinCos sc = detail::sincosPolynomial(angles[j]);
+                            sinOut[j] = sc.sin;
+                            cosOut[j] = sc.cos;
+                        }
+                        continue;
+                    }
+
+                    //SSE2 has no rounding instruction, but converting rounds to nearest under the default mode
+                    const __m128i k = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(twoOverPi)));
+                    const __m128 kf = _mm_cvtepi32_ps(k);
+                    __m128 r = _mm_sub_ps(x, _mm_mul_ps(kf, _mm_set1_ps(halfPiHi)));
+                    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(halfPiMid)));
+                    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(halfPiLo)));
+                    const __m128 r2 = _mm_mul_ps(r, r);
+
+                    __m128 s = _mm_add_ps(_mm_set1_ps(sinC5), _mm_mul_ps(r2, _mm_set1_ps(sinC7)));
+                    s = _mm_add_ps(_mm_set1_ps(sinC3), _mm_mul_ps(r2, s));
+                    s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), s));
+                    __m128 c = _mm_add_ps(_mm_set1_ps(cosC6), _mm_mul_ps(r2, _mm_set1_ps(cosC8)));
+                    c = _mm_add_ps(_mm_set1_ps(cosC4), _mm_mul_ps(r2, c));
+                    c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)),
+                        _mm_mul_ps(_mm_mul_ps(r2, r2), c));
+
+                    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(k, one), one));
+                    const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(k, two), 30));
+                    const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(k, one), two), 30));
+                    _mm_storeu_ps(sinOut + i, _mm_xor_ps(select(swap, c, s), sinSign));
+                    _mm_storeu_ps(cosOut + i, _mm_xor_ps(select(swap, s, c), cosSign));
+                }
+            }
+#endif
+
+            for (; i < n; i++) {
+                const SinCos sc = detail::sincosPolynomial(angles[i]);
+                sinOut[i] = sc.sin;
+                cosOut[i] = sc.cos;
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the sine and cosine of a whole array of angles, such as the rotations of
+     * every sprite in a frame
+     * @details the polynomial backend runs through simd::sincosPolynomial, the others one
+     * angle at a time
+     * @tparam P the backend to compute them with
+     * @param angles the angles
+     * @param sinOut receives the sines, must be at least as long as angles
+     * @param cosOut receives the cosines, must be at least as long as angles
+    */
+    template<TrigPrecision P = defaultTrigPrecision>
+    void sincos(std::span<const Radians> angles, std::span<float> sinOut, std::span<float> cosOut) {
+        if (sinOut.size() < angles.size() || cosOut.size() < angles.size()) {
+            throw std::out_of_range("sincos output is smaller than the input");
+        }
+
+        if constexpr (P == TrigPrecision::polynomial) {
+            static_assert(sizeof(Radians) == sizeof(float), "Radians must be a packed float");
+            simd::sincosPolynomial(reinterpret_cast<const float*>(angles.data()), sinOut.data(), cosOut.data(), angles.size());
+        }
+        else {
+            for (size_t i = 0; i < angles.size(); i++) {
+                const SinCos sc = sincos<P>(angles[i]);
+                sinOut[i] = sc.sin;
+                cosOut[i] = sc.cos;
+            }
+        }
+    }
+}
@@ -0,0 +1,776 @@
+#pragma once
+#include <set>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <memory_resource>
+#include <initializer_list>
+#include "S2DTags.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Poly2;
+    template<typename T>
+    class SimplePoly2;
+
+    /**
+     * @brief Reusable working memory for triangulating and decomposing SimplePoly2's
+     * @details every buffer keeps its capacity between calls, and the sweep status tree takes
+     * its nodes from a pool owned by the scratch, so once a scratch has worked through an
+     * outline, further outlines of up to the same size allocate nothing. A scratch is not
+     * tied to a coordinate type and may be shared by SimplePoly2's of any T, but not by two
+     * threads at once
+    */
+    class SimplePoly2Scratch
+    {
+    public:
+
+        /**
+         * @brief the corners of one triangle, as indices into the points of a SimplePoly2
+        */
+        using Triangle = std::array<std::uint32_t, 3>;
+
+        /**
+         * @brief Constructs an empty scratch
+        */
+        SimplePoly2Scratch() : status(EdgeLess{ this }, &pool) {}
+
+        //the sweep status compares through a pointer back to the scratch
+        SimplePoly2Scratch(const SimplePoly2Scratch&) = delete;
+        SimplePoly2Scratch& operator=(const SimplePoly2Scratch&) = delete;
+
+    private:
+
+        template<typename T>
+        friend class SimplePoly2;
+
+        struct Vertex {
+            double x;
+            double y;
+        };
+
+        struct Event {
+            double y;
+            double x;
+            std::uint32_t vertex;
+        };
+
+        //the classes of vertex of the monotone decomposition sweep
+        enum Kind : std::uint8_t { Start, End, Split, Merge, Regular };
+
+        static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+        /**
+         * @brief orders the edges crossing the sweep line from left to right
+         * @details the edges in the status never cross, so their order is the same wherever
+         * along the sweep it is evaluated. A bare x finds the edges left of a vertex
+        */
+        struct EdgeLess {
+            using is_transparent = void;
+            const SimplePoly2Scratch* scratch;
+
+            bool operator()(const std::uint32_t a, const std::uint32_t b) const { return scratch->edgeLess(a, b); }
+            bool operator()(const std::uint32_t a, const double x) const { return scratch->edgeX(a) < x; }
+            bool operator()(const double x, const std::uint32_t a) const { return x < scratch->edgeX(a); }
+        };
+
+        using Status = std::pmr::set<std::uint32_t, EdgeLess>;
+
+        static double cross(const Vertex& o, const Vertex& a, const Vertex& b) noexcept {
+            return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+        }
+
+        /**
+         * @brief a number that grows with the angle of a direction from -pi to pi, like atan2
+         * but without any trigonometry
+        */
+        static double pseudoAngle(const double dx, const double dy) noexcept {
+            double sum = std::abs(dx) + std::abs(dy);
+            if (sum == 0.0) return 0.0;
+            double p = dx / sum;
+            return dy < 0.0 ? p - 1.0 : 1.0 - p;
+        }
+
+        /**
+         * @brief the sweep order, downward and left to right along a row, which is the same as
+         * sweeping a very slightly rotated outline in which no two vertices share a height
+        */
+        bool above(const std::uint32_t a, const std::uint32_t b) const noexcept {
+            return pts[a].y > pts[b].y || (pts[a].y == pts[b].y && pts[a].x < pts[b].x);
+        }
+
+        std::uint32_t nextOf(const std::uint32_t i) const noexcept {
+            return i + 1 == pts.size() ? 0 : i + 1;
+        }
+
+        std::uint32_t prevOf(const std::uint32_t i) const noexcept {
+            return i == 0 ? (std::uint32_t)pts.size() - 1 : i - 1;
+        }
+
+        /**
+         * @brief the x of edge e, from vertex e down to the next vertex, at the sweep height
+         * @details an edge in the status always runs downward, and a level one from left to right,
+         * so its x along the sweep row is that of its left end
+        */
+        double edgeX(const std::uint32_t e) const noexcept {
+            const Vertex& a = pts[e];
+            const Vertex& b = pts[nextOf(e)];
+            if (a.y == b.y) return a.x;
+            return a.x + (sweepY - a.y) * (b.x - a.x) / (b.y - a.y);
+        }
+
+        bool edgeLess(const std::uint32_t a, const std::uint32_t b) const noexcept {
+            if (a == b) return false;
+            double xa = edgeX(a);
+            double xb = edgeX(b);
+            if (xa != xb) return xa < xb;
+
+            //edges leaving the same point are ordered by where they head below it
+            auto spread = [&](const std::uint32_t e) {
+                const Vertex& u = pts[e];
+                const Vertex& l = pts[nextOf(e)];
+                if (u.y == l.y) return std::numeric_limits<double>::infinity();
+                return (l.x - u.x) / (u.y - l.y);
+            };
+            double sa = spread(a);
+            double sb = spread(b);
+            if (sa != sb) return sa < sb;
+            return a < b;
+        }
+
+        /**
+         * @brief copies the outline in counter clockwise order
+         * @param points the outline
+         * @param reversed true if the outline is clockwise
+        */
+        template<typename T>
+        void load(const std::vector<Point2<T>>& points, const bool reversed) {
+            const size_t n = points.size();
+            pts.resize(n);
+            for (size_t i = 0; i < n; i++) {
+                const Point2<T>& p = points[reversed ? n - 1 - i : i];
+                pts[i] = Vertex{ (double)p.x, (double)p.y };
+            }
+        }
+
+        /**
+         * @brief twice the area of the loaded outline
+        */
+        double doubleArea() const noexcept {
+            double sum = 0.0;
+            for (std::uint32_t i = 0; i < pts.size(); i++) {
+                const Vertex& a = pts[i];
+                const Vertex& b = pts[nextOf(i)];
+                sum += a.x * b.y - a.y * b.x;
+            }
+            return sum;
+        }
+
+        /**
+         * @brief appends a triangle wound counter clockwise, the stack of the sweep meets its
+         * corners in an order that depends on the chain they came from
+        */
+        void emit(std::vector<Triangle>& out, std::uint32_t a, std::uint32_t b, std::uint32_t c) const {
+            if (cross(pts[a], pts[b], pts[c]) < 0.0) std::swap(b, c);
+            out.push_back(Triangle{ a, b, c });
+        }
+
+        void diagonal(const std::uint32_t a, const std::uint32_t b) {
+            if (a == b || nextOf(a) == b || nextOf(b) == a) return;
+            diagonals.push_back({ a, b });
+        }
+
+        /**
+         * @brief splits the loaded outline into y monotone pieces with the plane sweep of
+         * Lee and Preparata, then triangulates every piece with a stack in linear time
+         * @details O(n log n) overall. Outlines that break the sweep, such as ones with repeated
+         * or touching vertices, make it give up rather than produce overlapping triangles
+         * @param out receives the triangles, counter clockwise
+         * @return false if the sweep gave up
+        */
+        bool monotone(std::vector<Triangle>& out) {
+            out.clear();
+            diagonals.clear();
+            const std::uint32_t n = (std::uint32_t)pts.size();
+
+            //sorting the coordinates along with the indices keeps the comparisons in cache
+            order.resize(n);
+            for (std::uint32_t i = 0; i < n; i++) {
+                order[i] = Event{ pts[i].y, pts[i].x, i };
+            }
+            std::sort(order.begin(), order.end(), [](const Event& a, const Event& b) {
+                return a.y > b.y || (a.y == b.y && a.x < b.x);
+            });
+
+            kind.resize(n);
+            for (std::uint32_t i = 0; i < n; i++) {
+                std::uint32_t prev = prevOf(i);
+                std::uint32_t next = nextOf(i);
+                bool convex = cross(pts[prev], pts[i], pts[next]) > 0.0;
+                if (above(i, prev) && above(i, next)) kind[i] = convex ? Start : Split;
+                else if (above(prev, i) && above(next, i)) kind[i] = convex ? End : Merge;
+                else kind[i] = Regular;
+            }
+
+            helper.resize(n);
+            where.resize(n);
+            inStatus.assign(n, 0);
+            status.clear();
+
+            auto insert = [&](const std::uint32_t e) {
+                auto [it, added] = status.insert(e);
+                where[e] = it;
+                inStatus[e] = 1;
+                helper[e] = e;
+                return added;
+            };
+            auto erase = [&](const std::uint32_t e, const std::uint32_t v) {
+                if (!inStatus[e]) return false;
+                if (kind[helper[e]] == Merge) diagonal(v, helper[e]);
+                status.erase(where[e]);
+                inStatus[e] = 0;
+                return true;
+            };
+            //the edge directly left of v takes v as its helper
+            auto left = [&](const std::uint32_t v) {
+                auto it = status.lower_bound(pts[v].x);
+                if (it == status.begin()) return false;
+                std::uint32_t e = *--it;
+                if (kind[helper[e]] == Merge || kind[v] == Split) diagonal(v, helper[e]);
+                helper[e] = v;
+                return true;
+            };
+
+            bool ok = true;
+            for (const Event& event : order) {
+                const std::uint32_t v = event.vertex;
+                sweepY = event.y;
+                std::uint32_t prev = prevOf(v);
+                switch (kind[v]) {
+                case Start:
+                    ok = insert(v);
+                    break;
+                case End:
+                    ok = erase(prev, v);
+                    break;
+                case Split:
+                    ok = left(v) && insert(v);
+                    break;
+                case Merge:
+                    ok = erase(prev, v) && left(v);
+                    break;
+                case Regular:
+                    //the outline runs downward here when the interior lies right of v
+                    ok = above(prev, v) ? erase(prev, v) && insert(v) : left(v);
+                    break;
+                }
+                if (!ok) break;
+            }
+            status.clear();
+            if (!ok) return false;
+
+            return splitPieces() && triangulatePieces(out);
+        }
+
+        /**
+         * @brief walks the faces the diagonals cut the outline into
+         * @details every vertex lists its outline and diagonal neighbours counter clockwise by
+         * angle, and a face is followed by turning as far clockwise as possible at each vertex
+        */
+        bool splitPieces() {
+            const std::uint32_t n = (std::uint32_t)pts.size();
+            offsets.assign(n + 1, 2);
+            offsets[n] = 0;
+            for (const auto& [a, b] : diagonals) {
+                offsets[a]++;
+                offsets[b]++;
+            }
+            std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), 0u);
+
+            neighbours.resize(offsets[n]);
+            fill.assign(offsets.begin(), offsets.end() - 1);
+            for (std::uint32_t i = 0; i < n; i++) {
+                neighbours[fill[i]++] = nextOf(i);
+                neighbours[fill[i]++] = prevOf(i);
+            }
+            for (const auto& [a, b] : diagonals) {
+                neighbours[fill[a]++] = b;
+                neighbours[fill[b]++] = a;
+            }
+            for (std::uint32_t i = 0; i < n; i++) {
+                if (offsets[i + 1] - offsets[i] == 2) continue;
+                const Vertex& o = pts[i];
+                std::sort(neighbours.begin() + offsets[i], neighbours.begin() + offsets[i + 1], [&](std::uint32_t a, std::uint32_t b) {
+                    return pseudoAngle(pts[a].x - o.x, pts[a].y - o.y) < pseudoAngle(pts[b].x - o.x, pts[b].y - o.y);
+                });
+            }
+
+            pieceStarts.clear();
+            pieceVertices.clear();
+            visited.assign(offsets[n], 0);
+            for (std::uint32_t v = 0; v < n; v++) {
+                for (std::uint32_t h = offsets[v]; h < offsets[v + 1]; h++) {
+                    //the outline backward is the outside
+                    if (visited[h] || (neighbours[h] == prevOf(v) && neighbours[h] != nextOf(v))) continue;
+
+                    pieceStarts.push_back((std::uint32_t)pieceVertices.size());
+                    std::uint32_t from = v;
+                    std::uint32_t edge = h;
+                    while (!visited[edge]) {
+                        visited[edge] = 1;
+                        pieceVertices.push_back(from);
+                        if (pieceVertices.size() > offsets[n]) return false;
+
+                        std::uint32_t to = neighbours[edge];
+                        std::uint32_t first = offsets[to];
+                        std::uint32_t back = first;
+                        while (back < offsets[to + 1] && neighbours[back] != from) back++;
+                        if (back == offsets[to + 1]) return false;
+                        edge = back == first ? offsets[to + 1] - 1 : back - 1;
+                        from = to;
+                    }
+                    if (edge != h) return false;
+                }
+            }
+            pieceStarts.push_back((std::uint32_t)pieceVertices.size());
+            return true;
+        }
+
+        /**
+         * @brief triangulates every y monotone piece by merging its two chains from the top down,
+         * cutting off every corner a stack of waiting vertices can see
+        */
+        bool triangulatePieces(std::vector<Triangle>& out) {
+            for (size_t p = 0; p + 1 < pieceStarts.size(); p++) {
+                const std::uint32_t* face = pieceVertices.data() + pieceStarts[p];
+                const std::uint32_t k = pieceStarts[p + 1] - pieceStarts[p];
+                if (k < 3) return false;
+
+                std::uint32_t top = 0;
+                std::uint32_t bottom = 0;
+                for (std::uint32_t i = 1; i < k; i++) {
+                    if (above(face[i], face[top])) top = i;
+                    if (above(face[bottom], face[i])) bottom = i;
+                }
+
+                //counter clockwise from the top runs down the left chain
+                chain.resize(k);
+                for (std::uint32_t i = top, left = 1; ; i = i + 1 == k ? 0 : i + 1) {
+                    if (i == bottom) left = 0;
+                    chain[i] = (std::uint8_t)left;
+                    if ((i + 1 == k ? 0 : i + 1) == top) break;
+                }
+
+                sorted.resize(k);
+                std::iota(sorted.begin(), sorted.end(), 0u);
+                std::sort(sorted.begin(), sorted.end(), [&](std::uint32_t a, std::uint32_t b) { return above(face[a], face[b]); });
+
+                stack.clear();
+                stack.push_back(sorted[0]);
+                stack.push_back(sorted[1]);
+                for (std::uint32_t j = 2; j + 1 < k; j++) {
+                    std::uint32_t u = sorted[j];
+                    if (chain[u] != chain[stack.back()]) {
+                        while (stack.size() > 1) {
+                            std::uint32_t a = stack.back();
+                            stack.pop_back();
+                            emit(out, face[u], face[a], face[stack.back()]);
+                        }
+                        stack.clear();
+                        stack.push_back(sorted[j - 1]);
+                    }
+                    else {
+                        std::uint32_t last = stack.back();
+                        stack.pop_back();
+                        const double side = chain[u] ? 1.0 : -1.0;
+                        while (!stack.empty() &&
+                            side * cross(pts[face[u]], pts[face[stack.back()]], pts[face[last]]) > 0.0) {
+                            emit(out, face[u], face[last], face[stack.back()]);
+                            last = stack.back();
+                            stack.pop_back();
+                        }
+                        stack.push_back(last);
+                    }
+                    stack.push_back(u);
+                }
+                std::uint32_t u = sorted[k - 1];
+                while (stack.size() > 1) {
+                    std::uint32_t a = stack.back();
+                    stack.pop_back();
+                    emit(out, face[u], face[a], face[stack.back()]);
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief checks that there are n - 2 triangles whose areas add up to that of the loaded outline
+         * @details catches a sweep that lost or repeated part of the outline. It can't rule out
+         * overlapping triangles, emit winds every triangle counter clockwise, so a wrong one
+         * still adds area instead of cancelling it, and overlaps can balance out a gap
+        */
+        bool covers(const std::vector<Triangle>& triangles) const {
+            if (triangles.size() + 2 != pts.size()) return false;
+            double sum = 0.0;
+            double scale = 0.0;
+            for (const Triangle& t : triangles) {
+                double a = cross(pts[t[0]], pts[t[1]], pts[t[2]]);
+                sum += a;
+                scale += std::abs(a);
+            }
+            double whole = doubleArea();
+            return std::abs(sum - whole) <= 1e-9 * std::max(scale, std::abs(whole));
+        }
+
+        /**
+         * @brief clips ears off the loaded outline until one triangle is left, in O(n^2)
+         * @details an ear is a convex corner whose triangle holds no other reflex vertex. When
+         * none is left, as on self touching outlines, the next convex corner is clipped anyway
+         * so that there are always n - 2 triangles
+         * @param out receives the triangles, counter clockwise
+        */
+        void earClip(std::vector<Triangle>& out) {
+            out.clear();
+            const std::uint32_t n = (std::uint32_t)pts.size();
+            ringNext.resize(n);
+            ringPrev.resize(n);
+            for (std::uint32_t i = 0; i < n; i++) {
+                ringNext[i] = nextOf(i);
+                ringPrev[i] = prevOf(i);
+            }
+
+            auto corner = [&](const std::uint32_t i) { return cross(pts[ringPrev[i]], pts[i], pts[ringNext[i]]); };
+            auto isEar = [&](const std::uint32_t i) {
+                const Vertex& a = pts[ringPrev[i]];
+                const Vertex& b = pts[i];
+                const Vertex& c = pts[ringNext[i]];
+                if (cross(a, b, c) <= 0.0) return false;
+                for (std::uint32_t p = ringNext[ringNext[i]]; p != ringPrev[i]; p = ringNext[p]) {
+                    const Vertex& q = pts[p];
+                    if ((q.x == a.x && q.y == a.y) || (q.x == c.x && q.y == c.y) || corner(p) > 0.0) continue;
+                    if (cross(a, b, q) >= 0.0 && cross(b, c, q) >= 0.0 && cross(c, a, q) >= 0.0) return false;
+                }
+                return true;
+            };
+
+            std::uint32_t remaining = n;
+            std::uint32_t i = 0;
+            std::uint32_t misses = 0;
+            while (remaining > 3) {
+                //after a full turn without an ear, fall back to any convex corner, then to any
+                bool take = isEar(i) || (misses >= remaining && corner(i) >= 0.0) || misses >= 2 * remaining;
+                if (!take) {
+                    i = ringNext[i];
+                    misses++;
+                    continue;
+                }
+                emit(out, ringPrev[i], i, ringNext[i]);
+                ringNext[ringPrev[i]] = ringNext[i];
+                ringPrev[ringNext[i]] = ringPrev[i];
+                i = ringPrev[i];
+                remaining--;
+                misses = 0;
+            }
+            emit(out, ringPrev[i], i, ringNext[i]);
+        }
+
+        /**
+         * @brief merges triangles into convex pieces with the Hertel-Mehlhorn algorithm
+         * @details every diagonal whose removal leaves both of its ends convex is removed, in one
+         * pass over a half edge mesh of the triangles. The pieces are left in pieceStarts and
+         * pieceVertices, counter clockwise
+        */
+        void mergeConvex(const std::vector<Triangle>& triangles) {
+            const std::uint32_t m = (std::uint32_t)triangles.size() * 3;
+            origin.resize(m);
+            heNext.resize(m);
+            hePrev.resize(m);
+            twin.assign(m, none);
+            keys.resize(m);
+            for (std::uint32_t t = 0; t < triangles.size(); t++) {
+                for (std::uint32_t k = 0; k < 3; k++) {
+                    std::uint32_t h = 3 * t + k;
+                    std::uint32_t a = triangles[t][k];
+                    std::uint32_t b = triangles[t][(k + 1) % 3];
+                    origin[h] = a;
+                    heNext[h] = 3 * t + (k + 1) % 3;
+                    hePrev[h] = 3 * t + (k + 2) % 3;
+                    keys[h] = { ((std::uint64_t)std::min(a, b) << 32) | std::max(a, b), h };
+                }
+            }
+            std::sort(keys.begin(), keys.end());
+            for (std::uint32_t i = 0; i + 1 < m; i++) {
+                if (keys[i].first == keys[i + 1].first) {
+                    twin[keys[i].second] = keys[i + 1].second;
+                    twin[keys[i + 1].second] = keys[i].second;
+                    i++;
+                }
+            }
+
+            //the corner at the end of in and the start of out, convex or straight
+            auto convex = [&](const std::uint32_t in, const std::uint32_t out) {
+                const Vertex& a = pts[origin[in]];
+                const Vertex& b = pts[origin[out]];
+                const Vertex& c = pts[origin[heNext[out]]];
+                double turn = cross(a, b, c);
+                return turn > 0.0 || (turn == 0.0 && (b.x - a.x) * (c.x - b.x) + (b.y - a.y) * (c.y - b.y) > 0.0);
+            };
+
+            visited.assign(m, 0);
+            for (std::uint32_t h = 0; h < m; h++) {
+                std::uint32_t t = twin[h];
+                if (t == none || t < h) continue;
+                if (!convex(hePrev[h], heNext[t]) || !convex(hePrev[t], heNext[h])) continue;
+
+                heNext[hePrev[h]] = heNext[t];
+                hePrev[heNext[t]] = hePrev[h];
+                heNext[hePrev[t]] = heNext[h];
+                hePrev[heNext[h]] = hePrev[t];
+                visited[h] = 1;
+                visited[t] = 1;
+            }
+
+            pieceStarts.clear();
+            pieceVertices.clear();
+            for (std::uint32_t h = 0; h < m; h++) {
+                if (visited[h]) continue;
+                pieceStarts.push_back((std::uint32_t)pieceVertices.size());
+                for (std::uint32_t e = h; !visited[e]; e = heNext[e]) {
+                    visited[e] = 1;
+                    pieceVertices.push_back(origin[e]);
+                }
+            }
+            pieceStarts.push_back((std::uint32_t)pieceVertices.size());
+        }
+
+        //the outline, counter clockwise
+        std::vector<Vertex> pts;
+
+        //monotone sweep
+        double sweepY = 0.0;
+        std::vector<Event> order;
+        std::vector<Kind> kind;
+        std::vector<std::uint32_t> helper;
+        std::vector<Status::iterator> where;
+        std::vector<std::uint8_t> inStatus;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> diagonals;
+        std::pmr::unsynchronized_pool_resource pool;
+        Status status;
+
+        //pieces, as runs of vertices
+        std::vector<std::uint32_t> offsets;
+        std::vector<std::uint32_t> fill;
+        std::vector<std::uint32_t> neighbours;
+        std::vector<std::uint8_t> visited;
+        std::vector<std::uint32_t> pieceStarts;
+        std::vector<std::uint32_t> pieceVertices;
+
+        //monotone pieces
+        std::vector<std::uint8_t> chain;
+        std::vector<std::uint32_t> sorted;
+        std::vector<std::uint32_t> stack;
+
+        //ear clipping
+        std::vector<std::uint32_t> ringNext;
+        std::vector<std::uint32_t> ringPrev;
+
+        //convex decomposition
+        std::vector<Triangle> triangles;
+        std::vector<std::uint32_t> origin;
+        std::vector<std::uint32_t> heNext;
+        std::vector<std::uint32_t> hePrev;
+        std::vector<std::uint32_t> twin;
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> keys;
+    };
+
+    /**
+     * @brief A simple polygon in 2 Dimensional space, which unlike Poly2 may be concave
+     * @details the outline may wind either way but must not cross itself. Instead of
+     * collision tests, a SimplePoly2 offers triangulation, for rendering, and decomposition
+     * into convex Poly2's, for everything Poly2 already supports. Every operation takes a
+     * SimplePoly2Scratch, so that a level full of outlines can be processed without allocating
+     * @tparam T Underlying data type of the coordinates
+    */
+    template<typename T>
+    class SimplePoly2
+    {
+    public:
+
+        /**
+         * @brief the corners of one triangle, as indices into getPoints
+        */
+        using Triangle = SimplePoly2Scratch::Triangle;
+
+        /**
+         * @brief the working memory type of triangulate and decompose
+        */
+        using Scratch = SimplePoly2Scratch;
+
+        /**
+         * @brief Constructs a SimplePoly2 from its outline
+         * @param points the corners, in order around the outline, at least 3
+        */
+        explicit SimplePoly2(std::vector<Point2<T>> points) : points(std::move(points)) {
+            if (this->points.size() < 3) throw std::length_error("SimplePoly2 needs at least 3 points");
+            double sum = 0.0;
+            for (size_t i = 0; i < this->points.size(); i++) {
+                const Point2<T>& a = this->points[i];
+                const Point2<T>& b = this->points[(i + 1) % this->points.size()];
+                sum += (double)a.x * (double)b.y - (double)a.y * (double)b.x;
+            }
+            doubleArea = std::abs(sum);
+            reversed = sum < 0.0;
+        }
+
+        /**
+         * @brief Constructs a SimplePoly2 from an initializer list, ex:
+         *
+         *           SimplePoly2({Point2<T>(0,0), Point2<T>(2, 0), Point2<T>(1, 1), Point2<T>(2, 2), Point2<T>(0, 2)});
+         *
+         * @param list the corners, in order around the outline, at least 3
+        */
+        explicit SimplePoly2(const std::initializer_list<Point2<T>>& list)
+            : SimplePoly2(std::vector<Point2<T>>(list)) {}
+
+        /**
+         * @brief Read only access to the outline
+         * @return a reference to the points of the SimplePoly2
+        */
+        const std::vector<Point2<T>>& getPoints() const noexcept {
+            return points;
+        }
+
+        /**
+         * @brief The number of points in the outline
+        */
+        size_t size() const noexcept {
+            return points.size();
+        }
+
+        /**
+         * @brief The area enclosed by the outline
+        */
+        T area() const {
+            return (T)(doubleArea * 0.5);
+        }
+
+        /**
+         * @brief Checks the winding of the outline
+         * @return true if the outline runs clockwise in a y up frame
+        */
+        bool isClockwise() const noexcept {
+            return reversed;
+        }
+
+        /**
+         * @brief Triangulates the SimplePoly2 in O(n log n)
+         * @details the outline is swept into y monotone pieces, which are triangulated in linear
+         * time. When the sweep fails, or its triangles do not add up to the area of the outline, as
+         * can happen on outlines that repeat or touch vertices, it falls back to ear clipping. There
+         * are always size() - 2 triangles, wound the same way as the outline
+         * @param out receives the triangles, emptied first
+         * @param scratch working memory
+        */
+        void triangulate(std::vector<Triangle>& out, Scratch& scratch) const {
+            scratch.load(points, reversed);
+            if (!scratch.monotone(out) || !scratch.covers(out)) {
+                scratch.earClip(out);
+            }
+            toOutline(out);
+        }
+
+        /**
+         * @brief Triangulates the SimplePoly2 in O(n log n)
+         * @return size() - 2 triangles, wound the same way as the outline
+        */
+        std::vector<Triangle> triangulate() const {
+            Scratch scratch;
+            std::vector<Triangle> out;
+            triangulate(out, scratch);
+            return out;
+        }
+
+        /**
+         * @brief Triangulates the SimplePoly2 by ear clipping alone, in O(n^2)
+         * @details slower than triangulate on large outlines, but does not depend on the sweep
+         * @param out receives the triangles, emptied first
+         * @param scratch working memory
+        */
+        void triangulateEarClipping(std::vector<Triangle>& out, Scratch& scratch) const {
+            scratch.load(points, reversed);
+            scratch.earClip(out);
+            toOutline(out);
+        }
+
+        /**
+         * @brief Decomposes the SimplePoly2 into convex Poly2's
+         * @details the triangulation is merged back together with the Hertel-Mehlhorn
+         * algorithm, which gives at most four times the fewest pieces possible, and in practice
+         * close to it, in linear time after triangulating. Every piece is wound the same way as
+         * the outline and refilled through Poly2::refill, so out keeps both its Poly2's and their
+         * point storage across calls
+         * @param out receives the pieces, resized to their number
+         * @param scratch working memory
+        */
+        void decompose(std::vector<Poly2<T>>& out, Scratch& scratch) const {
+            scratch.load(points, reversed);
+            auto& triangles = scratch.triangles;
+            if (!scratch.monotone(triangles) || !scratch.covers(triangles)) {
+                scratch.earClip(triangles);
+            }
+            scratch.mergeConvex(triangles);
+
+            const size_t n = points.size();
+            const size_t count = scratch.pieceStarts.size() - 1;
+            out.resize(count);
+            for (size_t p = 0; p < count; p++) {
+                out[p].refill(trustedConvex, [&](typename Poly2<T>::PointStorage& piece) {
+                    for (std::uint32_t v = scratch.pieceStarts[p]; v < scratch.pieceStarts[p + 1]; v++) {
+                        std::uint32_t i = scratch.pieceVertices[v];
+                        piece.push_back(points[reversed ? n - 1 - i : i]);
+                    }
+                    if (reversed) {
+                        std::reverse(piece.begin(), piece.end());
+                    }
+                });
+            }
+        }
+
+        /**
+         * @brief Decomposes the SimplePoly2 into convex Poly2's
+         * @return the pieces, wound the same way as the outline
+        */
+        std::vector<Poly2<T>> decompose() const {
+            Scratch scratch;
+            std::vector<Poly2<T>> out;
+            decompose(out, scratch);
+            return out;
+        }
+
+    private:
+
+        /**
+         * @brief maps counter clockwise triangles of the scratch outline back onto the points
+        */
+        void toOutline(std::vector<Triangle>& triangles) const {
+            if (!reversed) return;
+            const std::uint32_t last = (std::uint32_t)points.size() - 1;
+            for (Triangle& t : triangles) {
+                t = Triangle{ last - t[0], last - t[2], last - t[1] };
+            }
+        }
+
+        std::vector<Point2<T>> points;
+        double doubleArea = 0.0;
+        bool reversed = false;
+    };
+}
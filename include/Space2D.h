@@ -8,14 +8,31 @@
 #include "LinearType.h"
 
 #include "S2DMath.h"
+#include "S2DTrig.h"
+#include "Rot2.h"
 
 #include "Mat3.h"
+#include "Affine2.h"
 #include "Point2.h"
 #include "Vec2.h"
 #include "Dim2.h"
 #include "NormVec2.h"
 #include "Rect2.h"
 #include "Poly2.h"
+#include "FixedPoly2.h"
+#include "PointBuffer2.h"
+#include "S2DCollision.h"
+#include "S2DGJK.h"
+#include "AABBTree2.h"
+#include "SpatialHash2.h"
+#include "LooseQuadtree2.h"
+#include "SweepAndPrune2.h"
+#include "PackedHilbertRTree2.h"
+#include "Ray2.h"
+#include "S2DHull.h"
+#include "S2DClip.h"
+#include "S2DMinkowski.h"
+#include "SimplePoly2.h"
 
 namespace Space2D {
 
@@ -25,25 +42,61 @@ namespace Space2D {
     using Vec2f = Vec2<float>;
     using Dim2f = Dim2<float>;
     using NormVec2f = NormVec2<float>;
+    using Rot2f = Rot2<float>;
     using Rect2f = Rect2<float>;
     using Poly2f = Poly2<float>;
+    using Tri2f = Tri2<float>;
+    using Quad2f = Quad2<float>;
+    using PointBuffer2f = PointBuffer2<float>;
+    using AABBTree2f = AABBTree2<float>;
+    using SpatialHash2f = SpatialHash2<float>;
+    using LooseQuadtree2f = LooseQuadtree2<float>;
+    using SweepAndPrune2f = SweepAndPrune2<float>;
+    using PackedHilbertRTree2f = PackedHilbertRTree2<float>;
+    using Ray2f = Ray2<float>;
+    using SimplePoly2f = SimplePoly2<float>;
     using Mat3f = Mat3<float>;
+    using Affine2f = Affine2<float>;
 
     using Point2p = Point2<Pixels>;
     using Vec2p = Vec2<Pixels>;
     using Dim2p = Dim2<Pixels>;
     using NormVec2p = NormVec2<Pixels>;
+    using Rot2p = Rot2<Pixels>;
     using Rect2p = Rect2<Pixels>;
     using Poly2p = Poly2<Pixels>;
+    using Tri2p = Tri2<Pixels>;
+    using Quad2p = Quad2<Pixels>;
+    using PointBuffer2p = PointBuffer2<Pixels>;
+    using AABBTree2p = AABBTree2<Pixels>;
+    using SpatialHash2p = SpatialHash2<Pixels>;
+    using LooseQuadtree2p = LooseQuadtree2<Pixels>;
+    using SweepAndPrune2p = SweepAndPrune2<Pixels>;
+    using PackedHilbertRTree2p = PackedHilbertRTree2<Pixels>;
+    using Ray2p = Ray2<Pixels>;
+    using SimplePoly2p = SimplePoly2<Pixels>;
     using Mat3p = Mat3<Pixels>;
+    using Affine2p = Affine2<Pixels>;
 
     using Point2m = Point2<Meters>;
     using Vec2m = Vec2<Meters>;
     using Dim2m = Dim2<Meters>;
     using NormVec2m = NormVec2<Meters>;
+    using Rot2m = Rot2<Meters>;
     using Rect2m = Rect2<Meters>;
     using Poly2m = Poly2<Meters>;
+    using Tri2m = Tri2<Meters>;
+    using Quad2m = Quad2<Meters>;
+    using PointBuffer2m = PointBuffer2<Meters>;
+    using AABBTree2m = AABBTree2<Meters>;
+    using SpatialHash2m = SpatialHash2<Meters>;
+    using LooseQuadtree2m = LooseQuadtree2<Meters>;
+    using SweepAndPrune2m = SweepAndPrune2<Meters>;
+    using PackedHilbertRTree2m = PackedHilbertRTree2<Meters>;
+    using Ray2m = Ray2<Meters>;
+    using SimplePoly2m = SimplePoly2<Meters>;
     using Mat3m = Mat3<Meters>;
+    using Affine2m = Affine2<Meters>;
 }
 
 //alias for Space2D
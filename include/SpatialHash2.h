@@ -0,0 +1,502 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "S2DCallback.h"
+
+/**
+ * @brief the most cells an item may cover before SpatialHash2 keeps it in a plain list instead
+*/
+#ifndef S2D_HASH_MAX_ITEM_CELLS
+#define S2D_HASH_MAX_ITEM_CELLS 256
+#endif
+
+namespace Space2D {
+
+    template<typename T>
+    class Point2;
+    template<typename T>
+    class Rect2;
+
+    /**
+     * @brief Uniform grid spatial hash over Rect2 bounded items
+     * @details The plane is divided into square cells of a fixed size, and every item is
+     * recorded in each cell its bounds overlap. Cells are not stored explicitly; instead a
+     * single flat open addressing table holds one slot per (cell, item) pair, keyed on the
+     * integer cell coordinates and probed linearly, so a lookup is a short scan over
+     * contiguous memory rather than a walk down a bucket list.
+     *
+     * Insert, remove and update cost O(cells covered), which is O(1) when the cell size
+     * is chosen close to the typical item size; items much larger than a cell should go
+     * in an AABBTree2 instead. An item covering more than S2D_HASH_MAX_ITEM_CELLS cells is
+     * not spread over the table at all, it is kept in a list every query checks, and a query
+     * region covering more cells than there are items scans the items instead of the cells.
+     * Coordinates too far out for a 32 bit cell coordinate share the outermost cells.
+     *
+     * clear() is O(1): every slot is stamped with the epoch it was written in, and clearing
+     * simply starts a new epoch, so clearing and reinserting everything every frame only
+     * pays for the inserts
+     * @tparam T Underlying data type of the coordinates
+     * @tparam Data the user data stored with each item
+    */
+    template<typename T, typename Data = size_t>
+    class SpatialHash2
+    {
+    public:
+
+        /**
+         * @brief index of an item, valid until the item is removed or the hash is cleared
+        */
+        using ItemId = std::uint32_t;
+
+        /**
+         * @brief Constructs an empty SpatialHash2
+         * @param cellSize the width and height of each grid cell
+         * @param expectedItems the number of items to reserve room for
+        */
+        explicit SpatialHash2(const T& cellSize, const size_t expectedItems = 0)
+            : cellSize(cellSize), invCellSize(1.0 / static_cast<double>(cellSize)) {
+            if (!(cellSize > (T)0.0)) throw std::logic_error("SpatialHash2 cell size must be positive");
+            reserve(expectedItems);
+        }
+
+        /**
+         * @brief Reserves room for items, each assumed to cover about one cell
+         * @param count the number of items to reserve room for
+        */
+        void reserve(const size_t count) {
+            items.reserve(count);
+            size_t needed = minCapacity;
+            while (needed < count * 2) needed *= 2;
+            if (needed > slots.size()) rehash(needed);
+        }
+
+        /**
+         * @brief Inserts an item
+         * @param bounds the bounds of the item
+         * @param data the user data to store with the item
+         * @return the id of the new item
+        */
+        ItemId insert(const Rect2<T>& bounds, const Data& data = Data()) {
+            ItemId id;
+            if (freeList.empty()) {
+                if (items.size() >= std::numeric_limits<ItemId>::max()) throw std::length_error("SpatialHash2 is full");
+                id = static_cast<ItemId>(items.size());
+                items.emplace_back();
+            }
+            else {
+                id = freeList.back();
+                freeList.pop_back();
+            }
+
+            Item& item = items[id];
+            item.bounds = bounds;
+            item.data = data;
+            item.cells = cellRange(bounds);
+            item.alive = true;
+            link(id);
+            itemCount++;
+            return id;
+        }
+
+        /**
+         * @brief Inserts a point item
+         * @param p the position of the item
+         * @param data the user data to store with the item
+         * @return the id of the new item
+        */
+        ItemId insert(const Point2<T>& p, const Data& data = Data()) {
+            return insert(Rect2<T>(p, p), data);
+        }
+
+        /**
+         * @brief Removes an item, its id may be reused by later items
+         * @param id the id of the item to remove
+        */
+        void remove(const ItemId id) {
+            if (!isItem(id)) throw std::out_of_range("SpatialHash2 item does not exist");
+            unlink(id);
+            items[id].alive = false;
+            freeList.push_back(id);
+            itemCount--;
+        }
+
+        /**
+         * @brief Moves an item to new bounds
+         * @details the table is only touched if the item now covers different cells
+         * @param id the id of the item to move
+         * @param bounds the new bounds of the item
+        */
+        void update(const ItemId id, const Rect2<T>& bounds) {
+            if (!isItem(id)) throw std::out_of_range("SpatialHash2 item does not exist");
+            Item& item = items[id];
+            CellRange cells = cellRange(bounds);
+            if (!(cells == item.cells)) {
+                unlink(id);
+                item.cells = cells;
+                link(id);
+            }
+            item.bounds = bounds;
+        }
+
+        /**
+         * @brief Moves a point item to a new position
+         * @param id the id of the item to move
+         * @param p the new position of the item
+        */
+        void update(const ItemId id, const Point2<T>& p) {
+            update(id, Rect2<T>(p, p));
+        }
+
+        /**
+         * @brief Removes every item in O(1), keeping the allocated storage
+         * @details item ids from before the clear must not be used afterwards
+        */
+        void clear() noexcept {
+            items.clear();
+            freeList.clear();
+            oversized.clear();
+            itemCount = 0;
+            usedSlots = 0;
+            epoch++;
+            if (epoch == 0) {
+                //the stamps wrapped around, so stale slots could look current again
+                for (auto& slot : slots) {
+                    slot.epoch = 0;
+                }
+                epoch = 1;
+            }
+        }
+
+        /**
+         * @brief Returns the bounds of an item
+         * @param id the id of the item
+         * @return the bounds of the item
+        */
+        const Rect2<T>& getBounds(const ItemId id) const {
+            if (!isItem(id)) throw std::out_of_range("SpatialHash2 item does not exist");
+            return items[id].bounds;
+        }
+
+        /**
+         * @brief Access the user data of an item
+         * @param id the id of the item
+         * @return a read only reference to the user data
+        */
+        const Data& getData(const ItemId id) const {
+            if (!isItem(id)) throw std::out_of_range("SpatialHash2 item does not exist");
+            return items[id].data;
+        }
+
+        /**
+         * @brief Access the user data of an item
+         * @param id the id of the item
+         * @return a read and write reference to the user data
+        */
+        Data& getData(const ItemId id) {
+            if (!isItem(id)) throw std::out_of_range("SpatialHash2 item does not exist");
+            return items[id].data;
+        }
+
+        /**
+         * @brief Returns the number of items
+         * @return the number of items
+        */
+        size_t size() const noexcept {
+            return itemCount;
+        }
+
+        /**
+         * @brief Checks if the hash holds no items
+         * @return true if there are no items
+        */
+        bool empty() const noexcept {
+            return itemCount == 0;
+        }
+
+        /**
+         * @brief Returns the cell size
+         * @return the width and height of each cell
+        */
+        const T& getCellSize() const noexcept {
+            return cellSize;
+        }
+
+        /**
+         * @brief Reports every item whose bounds overlap the region
+         * @details an item covering several cells is reported once
+         * @param region the region to query
+         * @param callback invoked with the id of each overlapping item, may return false to stop the query
+        */
+        template<typename Callback>
+        void query(const Rect2<T>& region, Callback&& callback) const {
+            forEachCandidate(region, [&](const ItemId id) {
+                if (!items[id].bounds.intersects(region)) return true;
+                return detail::invokeContinue(callback, id);
+            });
+        }
+
+        /**
+         * @brief Reports every item whose bounds come within radius of the center
+         * @param center the center of the query circle
+         * @param radius the radius of the query circle
+         * @param callback invoked with the id of each item in range, may return false to stop the query
+        */
+        template<typename Callback>
+        void queryRadius(const Point2<T>& center, const T& radius, Callback&& callback) const {
+            Rect2<T> region(Point2<T>(center.x - radius, center.y - radius), Point2<T>(center.x + radius, center.y + radius));
+            const T radiusSq = radius * radius;
+
+            forEachCandidate(region, [&](const ItemId id) {
+                const Rect2<T>& b = items[id].bounds;
+                T dx = center.x < b.min.x ? b.min.x - center.x : (center.x > b.max.x ? center.x - b.max.x : (T)0.0);
+                T dy = center.y < b.min.y ? b.min.y - center.y : (center.y > b.max.y ? center.y - b.max.y : (T)0.0);
+                if (dx * dx + dy * dy > radiusSq) return true;
+                return detail::invokeContinue(callback, id);
+            });
+        }
+
+        /**
+         * @brief Reports every item whose bounds contain the point, including their faces
+         * @param p the point to query
+         * @param callback invoked with the id of each item, may return false to stop the query
+        */
+        template<typename Callback>
+        void queryPoint(const Point2<T>& p, Callback&& callback) const {
+            query(Rect2<T>(p, p), std::forward<Callback>(callback));
+        }
+
+    private:
+
+        /**
+         * @brief an inclusive range of cell coordinates
+        */
+        struct CellRange {
+            std::int32_t minX = 0;
+            std::int32_t minY = 0;
+            std::int32_t maxX = -1;
+            std::int32_t maxY = -1;
+
+            bool operator==(const CellRange& other) const noexcept {
+                return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+            }
+        };
+
+        struct Item {
+            Rect2<T> bounds;
+            Data data = Data();
+            CellRange cells;
+
+            /**
+             * @brief the position of the item in the oversized list, or notOversized if it is in the table
+            */
+            std::uint32_t oversizedAt = notOversized;
+            bool alive = false;
+        };
+
+        /**
+         * @brief one (cell, item) entry of the table, empty unless its epoch is the current one
+        */
+        struct Slot {
+            std::int32_t cx = 0;
+            std::int32_t cy = 0;
+            ItemId item = 0;
+            std::uint32_t epoch = 0;
+        };
+
+        static constexpr size_t minCapacity = 16;
+        static constexpr std::uint32_t notOversized = std::numeric_limits<std::uint32_t>::max();
+
+        bool isItem(const ItemId id) const noexcept {
+            return id < items.size() && items[id].alive;
+        }
+
+        /**
+         * @brief the cell coordinate of a position, clamped to the range of int32_t before the cast
+         * @details NaN goes to the lowest cell
+        */
+        std::int32_t cellCoord(const T& v) const noexcept {
+            const double c = std::floor(static_cast<double>(v) * invCellSize);
+            if (!(c > (double)std::numeric_limits<std::int32_t>::min())) return std::numeric_limits<std::int32_t>::min();
+            if (c >= (double)std::numeric_limits<std::int32_t>::max()) return std::numeric_limits<std::int32_t>::max();
+            return static_cast<std::int32_t>(c);
+        }
+
+        /**
+         * @brief checks if a range covers more than limit cells, without overflowing for huge ranges
+        */
+        static bool coversMore(const CellRange& r, const std::uint64_t limit) noexcept {
+            const std::uint64_t w = (std::uint64_t)((std::int64_t)r.maxX - r.minX + 1);
+            const std::uint64_t h = (std::uint64_t)((std::int64_t)r.maxY - r.minY + 1);
+            return w > limit || h > limit || w * h > limit;
+        }
+
+        CellRange cellRange(const Rect2<T>& r) const noexcept {
+            return CellRange{ cellCoord(r.min.x), cellCoord(r.min.y), cellCoord(r.max.x), cellCoord(r.max.y) };
+        }
+
+        static size_t hashCell(const std::int32_t cx, const std::int32_t cy) noexcept {
+            std::uint64_t key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+            key *= 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(key >> 32);
+        }
+
+        size_t mask() const noexcept {
+            return slots.size() - 1;
+        }
+
+        /**
+         * @brief records an item in the cells it covers, or in the oversized list if it covers too many
+        */
+        void link(const ItemId id) {
+            Item& item = items[id];
+            if (coversMore(item.cells, S2D_HASH_MAX_ITEM_CELLS)) {
+                item.oversizedAt = static_cast<std::uint32_t>(oversized.size());
+                oversized.push_back(id);
+            }
+            else {
+                item.oversizedAt = notOversized;
+                addSlots(id, item.cells);
+            }
+        }
+
+        void unlink(const ItemId id) noexcept {
+            Item& item = items[id];
+            if (item.oversizedAt != notOversized) {
+                const ItemId last = oversized.back();
+                oversized[item.oversizedAt] = last;
+                items[last].oversizedAt = item.oversizedAt;
+                oversized.pop_back();
+                item.oversizedAt = notOversized;
+            }
+            else {
+                removeSlots(id, item.cells);
+            }
+        }
+
+        //the cell loops count in 64 bits, so a range ending at the largest cell coordinate stops
+        void addSlots(const ItemId id, const CellRange& cells) {
+            for (std::int64_t cy = cells.minY; cy <= cells.maxY; cy++) {
+                for (std::int64_t cx = cells.minX; cx <= cells.maxX; cx++) {
+                    if ((usedSlots + 1) * 2 > slots.size()) {
+                        rehash(std::max(minCapacity, slots.size() * 2));
+                    }
+                    placeSlot(Slot{ (std::int32_t)cx, (std::int32_t)cy, id, epoch });
+                    usedSlots++;
+                }
+            }
+        }
+
+        void placeSlot(const Slot& slot) noexcept {
+            size_t i = hashCell(slot.cx, slot.cy) & mask();
+            while (slots[i].epoch == epoch) {
+                i = (i + 1) & mask();
+            }
+            slots[i] = slot;
+        }
+
+        void removeSlots(const ItemId id, const CellRange& cells) noexcept {
+            for (std::int64_t cy = cells.minY; cy <= cells.maxY; cy++) {
+                for (std::int64_t cx = cells.minX; cx <= cells.maxX; cx++) {
+                    size_t i = hashCell((std::int32_t)cx, (std::int32_t)cy) & mask();
+                    while (slots[i].epoch == epoch) {
+                        if (slots[i].item == id && slots[i].cx == cx && slots[i].cy == cy) {
+                            eraseSlot(i);
+                            break;
+                        }
+                        i = (i + 1) & mask();
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief empties a slot, shifting later entries of the probe run back so no lookup stops early
+        */
+        void eraseSlot(size_t i) noexcept {
+            size_t j = i;
+            while (true) {
+                j = (j + 1) & mask();
+                if (slots[j].epoch != epoch) break;
+
+                size_t home = hashCell(slots[j].cx, slots[j].cy) & mask();
+                bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+                if (!stays) {
+                    slots[i] = slots[j];
+                    i = j;
+                }
+            }
+            slots[i].epoch = 0;
+            usedSlots--;
+        }
+
+        void rehash(const size_t capacity) {
+            std::vector<Slot> old = std::move(slots);
+            slots.assign(capacity, Slot());
+            for (const auto& slot : old) {
+                if (slot.epoch == epoch) {
+                    placeSlot(slot);
+                }
+            }
+        }
+
+        /**
+         * @brief visits every item recorded in a cell overlapping the region, once per item, and every oversized item
+         * @details an item is only visited from the first cell shared by the item and the region,
+         * which avoids duplicates without any per query state. A region covering more cells than
+         * there are items visits every item instead
+        */
+        template<typename Visit>
+        void forEachCandidate(const Rect2<T>& region, Visit&& visit) const {
+            if (itemCount == 0) return;
+            CellRange range = cellRange(region);
+
+            if (coversMore(range, items.size())) {
+                for (size_t id = 0; id < items.size(); id++) {
+                    if (items[id].alive && !visit(static_cast<ItemId>(id))) return;
+                }
+                return;
+            }
+
+            for (const ItemId id : oversized) {
+                if (!visit(id)) return;
+            }
+
+            for (std::int64_t cy = range.minY; cy <= range.maxY; cy++) {
+                for (std::int64_t cx = range.minX; cx <= range.maxX; cx++) {
+                    size_t i = hashCell((std::int32_t)cx, (std::int32_t)cy) & mask();
+                    while (slots[i].epoch == epoch) {
+                        const Slot& slot = slots[i];
+                        i = (i + 1) & mask();
+                        if (slot.cx != cx || slot.cy != cy) continue;
+
+                        const CellRange& cells = items[slot.item].cells;
+                        if (cx != std::max(cells.minX, range.minX) || cy != std::max(cells.minY, range.minY)) continue;
+
+                        if (!visit(slot.item)) return;
+                    }
+                }
+            }
+        }
+
+        T cellSize;
+        double invCellSize;
+
+        std::vector<Item> items;
+        std::vector<ItemId> freeList;
+        std::vector<ItemId> oversized;
+        std::vector<Slot> slots;
+
+        size_t itemCount = 0;
+        size_t usedSlots = 0;
+
+        /**
+         * @brief the stamp of the current generation of slots, 0 is never current
+        */
+        std::uint32_t epoch = 1;
+    };
+}
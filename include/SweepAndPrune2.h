@@ -0,0 +1,430 @@
+#pragma once
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include "S2DCallback.h"
+
+namespace Space2D {
+
+    template<typename T>
+    class Rect2;
+
+    /**
+     * @brief Sweep and prune broadphase over Rect2 bounded proxies
+     * @details The min and max of every proxy are kept as endpoints in an array sorted along x,
+     * and optionally a second array sorted along y. Objects that move coherently only shift their
+     * endpoints a few places each frame, so update() re-sorts the arrays with an insertion sort,
+     * which costs close to O(n) for small motions. Every swap of a min past a max, or a max past
+     * a min, is exactly a change in whether two intervals overlap, so the set of overlapping
+     * pairs is kept up to date from the swaps alone, and reported as add and remove events.
+     *
+     * With Axes::XY a pair is in the set when the proxies' bounds intersect, touching faces
+     * included. With Axes::X only the x intervals are compared, which is cheaper to maintain
+     * but leaves the y test to the narrowphase
+     * @tparam T Underlying data type of the coordinates
+     * @tparam Data the user data stored with each proxy
+    */
+    template<typename T, typename Data = size_t>
+    class SweepAndPrune2
+    {
+    public:
+
+        /**
+         * @brief index of a proxy, valid until the update after it is destroyed
+        */
+        using ProxyId = std::uint32_t;
+
+        /**
+         * @brief the axes the endpoints are sorted along
+        */
+        enum class Axes {
+            X,
+            XY
+        };
+
+        /**
+         * @brief Constructs an empty SweepAndPrune2
+         * @param axes the axes to sort along and compare intervals on
+        */
+        explicit SweepAndPrune2(const Axes axes = Axes::XY) noexcept
+            : axisCount(axes == Axes::XY ? 2 : 1) {}
+
+        /**
+         * @brief Adds a proxy, its pairs are reported by the next update
+         * @param bounds the bounds of the proxy
+         * @param data the user data to store with the proxy
+         * @return the id of the new proxy
+        */
+        ProxyId createProxy(const Rect2<T>& bounds, const Data& data = Data()) {
+            ProxyId id;
+            if (freeList.empty()) {
+                if (proxies.size() >= maxProxies) throw std::length_error("SweepAndPrune2 is full");
+                id = static_cast<ProxyId>(proxies.size());
+                proxies.emplace_back();
+            }
+            else {
+                id = freeList.back();
+                freeList.pop_back();
+            }
+
+            Proxy& proxy = proxies[id];
+            proxy.bounds = bounds;
+            proxy.data = data;
+            proxy.alive = true;
+
+            //the new endpoints start at the end of each array, the next update sorts them into place
+            for (size_t axis = 0; axis < axisCount; axis++) {
+                endpoints[axis].push_back(Endpoint{ lower(bounds, axis), id << 1 });
+                endpoints[axis].push_back(Endpoint{ upper(bounds, axis), (id << 1) | 1 });
+            }
+            pendingCreated++;
+            proxyCount++;
+            return id;
+        }
+
+        /**
+         * @brief Removes a proxy, its pairs are reported as removed by the next update
+         * @param id the id of the proxy
+        */
+        void destroyProxy(const ProxyId id) {
+            if (!isProxy(id)) throw std::out_of_range("SweepAndPrune2 proxy does not exist");
+            proxies[id].alive = false;
+            destroyed.push_back(id);
+            proxyCount--;
+        }
+
+        /**
+         * @brief Moves a proxy, the pairs change on the next update
+         * @param id the id of the proxy
+         * @param bounds the new bounds of the proxy
+        */
+        void moveProxy(const ProxyId id, const Rect2<T>& bounds) {
+            if (!isProxy(id)) throw std::out_of_range("SweepAndPrune2 proxy does not exist");
+            proxies[id].bounds = bounds;
+        }
+
+        /**
+         * @brief Returns the bounds of a proxy
+         * @param id the id of the proxy
+         * @return the bounds of the proxy
+        */
+        const Rect2<T>& getBounds(const ProxyId id) const {
+            if (!isProxy(id)) throw std::out_of_range("SweepAndPrune2 proxy does not exist");
+            return proxies[id].bounds;
+        }
+
+        /**
+         * @brief Access the user data of a proxy
+         * @param id the id of the proxy
+         * @return a read only reference to the user data
+        */
+        const Data& getData(const ProxyId id) const {
+            if (!isProxy(id)) throw std::out_of_range("SweepAndPrune2 proxy does not exist");
+            return proxies[id].data;
+        }
+
+        /**
+         * @brief Access the user data of a proxy
+         * @param id the id of the proxy
+         * @return a read and write reference to the user data
+        */
+        Data& getData(const ProxyId id) {
+            if (!isProxy(id)) throw std::out_of_range("SweepAndPrune2 proxy does not exist");
+            return proxies[id].data;
+        }
+
+        /**
+         * @brief Returns the number of live proxies
+         * @return the number of proxies
+        */
+        size_t size() const noexcept {
+            return proxyCount;
+        }
+
+        /**
+         * @brief Returns the number of overlapping pairs as of the last update
+         * @return the number of pairs
+        */
+        size_t pairCount() const noexcept {
+            return pairs.size();
+        }
+
+        /**
+         * @brief Reports whether the pair of two proxies is currently in the overlap set
+         * @details the overlap set only changes in update(), so moves since then are not seen.
+         * The order of a and b does not matter
+         * @param a the first proxy
+         * @param b the second proxy
+         * @return true if a and b overlapped as of the last update
+        */
+        bool isOverlapping(const ProxyId a, const ProxyId b) const {
+            return pairs.count(pairKey(a, b)) != 0;
+        }
+
+        /**
+         * @brief Re-sorts the endpoints incrementally and reports the pairs that changed
+         * @details falls back to rebuild() when many proxies were created since the last update,
+         * since sorting each of them in from the end of the arrays would cost O(n) apiece.
+         * The callbacks must not modify the SweepAndPrune2
+         * @param onAdd invoked with the ids of each pair that started overlapping
+         * @param onRemove invoked with the ids of each pair that stopped overlapping,
+         * including pairs of destroyed proxies
+        */
+        template<typename OnAdd, typename OnRemove>
+        void update(OnAdd&& onAdd, OnRemove&& onRemove) {
+            removeDestroyed(onRemove);
+
+            if (pendingCreated * 8 > proxyCount) {
+                rebuild(onAdd, onRemove);
+                return;
+            }
+            pendingCreated = 0;
+
+            for (size_t axis = 0; axis < axisCount; axis++) {
+                refreshValues(axis);
+                insertionSort(endpoints[axis], onAdd, onRemove);
+            }
+        }
+
+        /**
+         * @brief Updates without reporting the pairs that changed
+        */
+        void update() {
+            update([](ProxyId, ProxyId) {}, [](ProxyId, ProxyId) {});
+        }
+
+        /**
+         * @brief Fully re-sorts the endpoints and recomputes the pair set with a sweep
+         * @details gives the same result as update(), in O(n log n) regardless of how far
+         * the proxies moved
+         * @param onAdd invoked with the ids of each pair that started overlapping
+         * @param onRemove invoked with the ids of each pair that stopped overlapping
+        */
+        template<typename OnAdd, typename OnRemove>
+        void rebuild(OnAdd&& onAdd, OnRemove&& onRemove) {
+            removeDestroyed(onRemove);
+            pendingCreated = 0;
+
+            for (size_t axis = 0; axis < axisCount; axis++) {
+                refreshValues(axis);
+                std::sort(endpoints[axis].begin(), endpoints[axis].end(),
+                    [](const Endpoint& a, const Endpoint& b) { return before(a, b); });
+            }
+
+            std::unordered_set<std::uint64_t> fresh;
+            fresh.reserve(pairs.size());
+            active.clear();
+            for (const auto& e : endpoints[0]) {
+                ProxyId id = e.proxy();
+                if (e.isMax()) {
+                    //the active list is short, so a linear search beats anything cleverer
+                    auto it = std::find(active.begin(), active.end(), id);
+                    *it = active.back();
+                    active.pop_back();
+                    continue;
+                }
+                for (ProxyId other : active) {
+                    if (axisCount == 1 || overlapsOn(id, other, 1)) fresh.insert(pairKey(id, other));
+                }
+                active.push_back(id);
+            }
+
+            for (std::uint64_t key : fresh) {
+                if (!pairs.count(key)) onAdd(keyFirst(key), keySecond(key));
+            }
+            for (std::uint64_t key : pairs) {
+                if (!fresh.count(key)) onRemove(keyFirst(key), keySecond(key));
+            }
+            pairs = std::move(fresh);
+        }
+
+        /**
+         * @brief Rebuilds without reporting the pairs that changed
+        */
+        void rebuild() {
+            rebuild([](ProxyId, ProxyId) {}, [](ProxyId, ProxyId) {});
+        }
+
+        /**
+         * @brief Reports every overlapping pair as of the last update
+         * @param callback invoked with the ids of each pair, may return false to stop
+        */
+        template<typename Callback>
+        void queryPairs(Callback&& callback) const {
+            for (std::uint64_t key : pairs) {
+                if (!detail::invokeContinue(callback, keyFirst(key), keySecond(key))) return;
+            }
+        }
+
+    private:
+
+        struct Proxy {
+            Rect2<T> bounds;
+            Data data = Data();
+            bool alive = false;
+        };
+
+        /**
+         * @brief a min or max of one proxy along one axis
+        */
+        struct Endpoint {
+            T value;
+
+            /**
+             * @brief the proxy id shifted left once, with the low bit set for a max
+            */
+            std::uint32_t packed;
+
+            ProxyId proxy() const noexcept {
+                return packed >> 1;
+            }
+
+            bool isMax() const noexcept {
+                return packed & 1;
+            }
+        };
+
+        static constexpr size_t maxProxies = std::numeric_limits<ProxyId>::max() >> 1;
+
+        /**
+         * @brief sort order of the endpoints, a min sorts before a max of the same value so touching intervals overlap
+        */
+        static bool before(const Endpoint& a, const Endpoint& b) noexcept {
+            if (a.value < b.value) return true;
+            if (b.value < a.value) return false;
+            return !a.isMax() && b.isMax();
+        }
+
+        static T lower(const Rect2<T>& r, const size_t axis) noexcept {
+            return axis == 0 ? r.min.x : r.min.y;
+        }
+
+        static T upper(const Rect2<T>& r, const size_t axis) noexcept {
+            return axis == 0 ? r.max.x : r.max.y;
+        }
+
+        static std::uint64_t pairKey(const ProxyId a, const ProxyId b) noexcept {
+            return a < b ? (static_cast<std::uint64_t>(a) << 32) | b : (static_cast<std::uint64_t>(b) << 32) | a;
+        }
+
+        static ProxyId keyFirst(const std::uint64_t key) noexcept {
+            return static_cast<ProxyId>(key >> 32);
+        }
+
+        static ProxyId keySecond(const std::uint64_t key) noexcept {
+            return static_cast<ProxyId>(key & 0xFFFFFFFFu);
+        }
+
+        bool isProxy(const ProxyId id) const noexcept {
+            return id < proxies.size() && proxies[id].alive;
+        }
+
+        bool overlapsOn(const ProxyId a, const ProxyId b, const size_t axis) const noexcept {
+            const Rect2<T>& ra = proxies[a].bounds;
+            const Rect2<T>& rb = proxies[b].bounds;
+            return !(upper(ra, axis) < lower(rb, axis) || upper(rb, axis) < lower(ra, axis));
+        }
+
+        bool overlaps(const ProxyId a, const ProxyId b) const noexcept {
+            for (size_t axis = 0; axis < axisCount; axis++) {
+                if (!overlapsOn(a, b, axis)) return false;
+            }
+            return true;
+        }
+
+        void refreshValues(const size_t axis) noexcept {
+            for (auto& e : endpoints[axis]) {
+                const Rect2<T>& r = proxies[e.proxy()].bounds;
+                e.value = e.isMax() ? upper(r, axis) : lower(r, axis);
+            }
+        }
+
+        /**
+         * @brief sorts one axis, turning each swap that changes an interval overlap into a pair event
+         * @details the pair is checked against the final bounds on every axis, so a pair only
+         * changes once per update no matter how many axes it moved on
+        */
+        template<typename OnAdd, typename OnRemove>
+        void insertionSort(std::vector<Endpoint>& sweep, OnAdd& onAdd, OnRemove& onRemove) {
+            for (size_t i = 1; i < sweep.size(); i++) {
+                Endpoint e = sweep[i];
+                size_t j = i;
+                while (j > 0 && before(e, sweep[j - 1])) {
+                    const Endpoint& f = sweep[j - 1];
+                    if (!e.isMax() && f.isMax()) {
+                        ProxyId a = e.proxy();
+                        ProxyId b = f.proxy();
+                        if (overlaps(a, b) && pairs.insert(pairKey(a, b)).second) {
+                            onAdd(std::min(a, b), std::max(a, b));
+                        }
+                    }
+                    else if (e.isMax() && !f.isMax()) {
+                        ProxyId a = e.proxy();
+                        ProxyId b = f.proxy();
+                        if (!overlaps(a, b) && pairs.erase(pairKey(a, b))) {
+                            onRemove(std::min(a, b), std::max(a, b));
+                        }
+                    }
+                    sweep[j] = f;
+                    j--;
+                }
+                sweep[j] = e;
+            }
+        }
+
+        /**
+         * @brief drops the endpoints and pairs of destroyed proxies and frees their ids
+        */
+        template<typename OnRemove>
+        void removeDestroyed(OnRemove& onRemove) {
+            if (destroyed.empty()) return;
+
+            for (size_t axis = 0; axis < axisCount; axis++) {
+                auto& sweep = endpoints[axis];
+                sweep.erase(std::remove_if(sweep.begin(), sweep.end(),
+                    [&](const Endpoint& e) { return !proxies[e.proxy()].alive; }), sweep.end());
+            }
+
+            for (auto it = pairs.begin(); it != pairs.end();) {
+                ProxyId a = keyFirst(*it);
+                ProxyId b = keySecond(*it);
+                if (!proxies[a].alive || !proxies[b].alive) {
+                    onRemove(a, b);
+                    it = pairs.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+
+            freeList.insert(freeList.end(), destroyed.begin(), destroyed.end());
+            destroyed.clear();
+        }
+
+        size_t axisCount;
+
+        std::vector<Proxy> proxies;
+        std::vector<ProxyId> freeList;
+
+        /**
+         * @brief proxies destroyed since the last update, their ids are freed once their endpoints are gone
+        */
+        std::vector<ProxyId> destroyed;
+        std::vector<Endpoint> endpoints[2];
+        /**
+         * @brief the overlap set, the pairKey of every pair overlapping as of the last update
+        */
+        std::unordered_set<std::uint64_t> pairs;
+
+        /**
+         * @brief the proxies whose interval contains the sweep position during rebuild
+        */
+        std::vector<ProxyId> active;
+
+        size_t proxyCount = 0;
+        size_t pendingCreated = 0;
+    };
+}
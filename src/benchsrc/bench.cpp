@@ -0,0 +1,1407 @@
+#include <vector>
+#include <random>
+#include "Space2D.h"
+#include "benchmark/benchmark.h"
+#ifdef _SFML_ENABLED
+#include "SFML\Graphics.hpp"
+#endif
+
+
+using namespace s2d;
+
+namespace {
+
+	std::vector<Point2f> randomPoints(const size_t count, const unsigned int seed = 42) {
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+		std::vector<Point2f> points;
+		points.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			points.push_back(Point2f(dist(gen), dist(gen)));
+		}
+		return points;
+	}
+
+	Mat3f benchMatrix() {
+		Mat3f m;
+		m.translate(Vec2f(5, 8));
+		m.scale(2, 3);
+		m.rotate(60_deg);
+		return m;
+	}
+}
+
+static void BM_Mat3TransformPerPoint(benchmark::State& state) {
+	const auto m = benchMatrix();
+	auto points = randomPoints((size_t)state.range(0));
+	std::vector<Point2f> out(points.size());
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < points.size(); i++) {
+			out[i] = m.transform(points[i]);
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Mat3TransformPerPoint)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+static void BM_Mat3TransformBatch(benchmark::State& state) {
+	const auto m = benchMatrix();
+	PointBuffer2f points(randomPoints((size_t)state.range(0)));
+	PointBuffer2f out;
+
+	for (auto _ : state) {
+		m.transformBatch(points, out);
+		benchmark::DoNotOptimize(out.xData());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Mat3TransformBatch)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+namespace {
+
+	//the builder chain as it was implemented before the direct pre/post multiply paths:
+	//translate inverted the whole matrix, and every builder ran a full 3x3 product
+	Mat3f legacyBuilderChain(const Mat3f& start, const Vec2f& trans, const Radians rad, const float s) {
+		Mat3f m = start;
+		auto transVecInv = m.inverse().transform(trans);
+		m *= Mat3f(1, 0, transVecInv.x, 0, 1, transVecInv.y, 0, 0, 1);
+
+		float cosval = s2d::cos(rad);
+		float sinval = s2d::sin(rad);
+		m *= Mat3f(cosval, -sinval, 0, sinval, cosval, 0);
+
+		m *= Mat3f(s, 0, 0, 0, s, 0);
+		return m;
+	}
+}
+
+static void BM_Mat3BuilderChainLegacy(benchmark::State& state) {
+	Mat3f start(1, 0.5f, -2, 0.25f, 2, 7);
+	Vec2f trans(5, 8);
+	Radians rad = 30_deg;
+	float s = 2.0f;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(start);
+		benchmark::DoNotOptimize(trans);
+		auto m = legacyBuilderChain(start, trans, rad, s);
+		benchmark::DoNotOptimize(m);
+	}
+}
+BENCHMARK(BM_Mat3BuilderChainLegacy);
+
+static void BM_Mat3BuilderChain(benchmark::State& state) {
+	Mat3f start(1, 0.5f, -2, 0.25f, 2, 7);
+	Vec2f trans(5, 8);
+	Radians rad = 30_deg;
+	float s = 2.0f;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(start);
+		benchmark::DoNotOptimize(trans);
+		Mat3f m = start;
+		m.translate(trans).rotate(rad).scale(s, s);
+		benchmark::DoNotOptimize(m);
+	}
+}
+BENCHMARK(BM_Mat3BuilderChain);
+
+namespace {
+
+	//a set of random convex polygons, each a regular n-gon with a random center and radius
+	std::vector<Poly2f> randomPolygons(const size_t count, const size_t sides = 6, const unsigned int seed = 42) {
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> pos(-1000.0f, 1000.0f);
+		std::uniform_real_distribution<float> radius(1.0f, 50.0f);
+		std::vector<Poly2f> polys;
+		polys.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			Point2f center(pos(gen), pos(gen));
+			float r = radius(gen);
+			Poly2f::PointStorage points(sides);
+			for (size_t j = 0; j < sides; j++) {
+				float angle = 6.2831853f * (float)j / (float)sides;
+				points[j] = Point2f(center.x + r * std::cos(angle), center.y + r * std::sin(angle));
+			}
+			polys.push_back(Poly2f(trustedConvex, std::move(points)));
+		}
+		return polys;
+	}
+}
+
+//translation that rebuilds every polygon through the checked constructor, as operator+ used to
+static void BM_Poly2TranslateChecked(benchmark::State& state) {
+	auto polys = randomPolygons((size_t)state.range(0));
+	std::vector<Poly2f> out(polys.size());
+	Vec2f offset(3, -4);
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < polys.size(); i++) {
+			Poly2f::PointStorage points(polys[i].size());
+			for (size_t j = 0; j < polys[i].size(); j++) {
+				points[j] = polys[i][j] + offset;
+			}
+			out[i] = Poly2f(points);
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Poly2TranslateChecked)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+static void BM_Poly2Translate(benchmark::State& state) {
+	auto polys = randomPolygons((size_t)state.range(0));
+	std::vector<Poly2f> out(polys.size());
+	Vec2f offset(3, -4);
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < polys.size(); i++) {
+			out[i] = polys[i] + offset;
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Poly2Translate)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+//transformation that rebuilds every polygon through the checked constructor, as Mat3::transform used to
+static void BM_Poly2TransformChecked(benchmark::State& state) {
+	const auto m = benchMatrix();
+	auto polys = randomPolygons((size_t)state.range(0));
+	std::vector<Poly2f> out(polys.size());
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < polys.size(); i++) {
+			Poly2f::PointStorage points(polys[i].size());
+			for (size_t j = 0; j < polys[i].size(); j++) {
+				points[j] = m.transform(polys[i][j]);
+			}
+			out[i] = Poly2f(points);
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Poly2TransformChecked)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+static void BM_Poly2Transform(benchmark::State& state) {
+	const auto m = benchMatrix();
+	auto polys = randomPolygons((size_t)state.range(0));
+	std::vector<Poly2f> out(polys.size());
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < polys.size(); i++) {
+			out[i] = m.transform(polys[i]);
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Poly2Transform)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+//a broadphase step: every polygon moves, then reports its AABB
+static void BM_Poly2MoveAndAABB(benchmark::State& state) {
+	auto polys = randomPolygons((size_t)state.range(0));
+	std::vector<Rect2f> boxes(polys.size());
+	Vec2f step(0.5f, -0.25f);
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < polys.size(); i++) {
+			polys[i] += step;
+			boxes[i] = polys[i].getAABB();
+		}
+		benchmark::DoNotOptimize(boxes.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Poly2MoveAndAABB)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+namespace {
+
+	//random convex pairs close enough together that roughly half of them overlap
+	std::vector<std::pair<Poly2f, Poly2f>> randomPolygonPairs(const size_t count, const unsigned int seed = 42) {
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> pos(-30.0f, 30.0f);
+		std::uniform_real_distribution<float> radius(5.0f, 20.0f);
+		std::uniform_real_distribution<float> phase(0.0f, 6.2831853f);
+		std::uniform_int_distribution<size_t> sides(3, 8);
+
+		auto makePoly = [&]() {
+			Point2f center(pos(gen), pos(gen));
+			float r = radius(gen);
+			float start = phase(gen);
+			size_t n = sides(gen);
+			Poly2f::PointStorage points(n);
+			for (size_t j = 0; j < n; j++) {
+				float angle = start + 6.2831853f * (float)j / (float)n;
+				points[j] = Point2f(center.x + r * std::cos(angle), center.y + r * std::sin(angle));
+			}
+			return Poly2f(trustedConvex, std::move(points));
+		};
+
+		std::vector<std::pair<Poly2f, Poly2f>> pairs;
+		pairs.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			Poly2f a = makePoly();
+			Poly2f b = makePoly();
+			pairs.emplace_back(std::move(a), std::move(b));
+		}
+		return pairs;
+	}
+}
+
+static void BM_CollidePoly(benchmark::State& state) {
+	auto pairs = randomPolygonPairs((size_t)state.range(0));
+	size_t hits = 0;
+
+	for (auto _ : state) {
+		for (const auto& [a, b] : pairs) {
+			auto m = collide(a, b);
+			hits += m.colliding;
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.counters["hit_rate"] = (double)hits / (double)(state.iterations() * state.range(0));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CollidePoly)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+
+static void BM_OverlapsPoly(benchmark::State& state) {
+	auto pairs = randomPolygonPairs((size_t)state.range(0));
+
+	for (auto _ : state) {
+		for (const auto& [a, b] : pairs) {
+			benchmark::DoNotOptimize(overlaps(a, b));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OverlapsPoly)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+
+static void BM_CollidePolyRect(benchmark::State& state) {
+	auto pairs = randomPolygonPairs((size_t)state.range(0));
+	std::vector<Rect2f> rects;
+	rects.reserve(pairs.size());
+	for (const auto& pair : pairs) {
+		rects.push_back(pair.second.getAABB());
+	}
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < pairs.size(); i++) {
+			auto m = collide(pairs[i].first, rects[i]);
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CollidePolyRect)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+
+namespace {
+
+	Poly2f regularPolygon(const Point2f& center, const float radius, const size_t sides, const float phase = 0.0f) {
+		Poly2f::PointStorage points(sides);
+		for (size_t j = 0; j < sides; j++) {
+			float angle = phase + 6.2831853f * (float)j / (float)sides;
+			points[j] = Point2f(center.x + radius * std::cos(angle), center.y + radius * std::sin(angle));
+		}
+		return Poly2f(trustedConvex, std::move(points));
+	}
+}
+
+//two large polygons drifting past each other, the query each frame sees a slightly moved pair
+static void BM_LargePolySAT(benchmark::State& state) {
+	const size_t sides = (size_t)state.range(0);
+	Poly2f a = regularPolygon(Point2f(0, 0), 10, sides);
+	Poly2f b = regularPolygon(Point2f(-30, 5), 10, sides, 0.1f);
+	size_t frame = 0;
+
+	for (auto _ : state) {
+		Poly2f moved = b + Vec2f(0.05f * (float)(frame++ % 1200), 0);
+		benchmark::DoNotOptimize(collide(a, moved));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LargePolySAT)->RangeMultiplier(4)->Range(8, 512);
+
+static void BM_LargePolyGJK(benchmark::State& state) {
+	const size_t sides = (size_t)state.range(0);
+	Poly2f a = regularPolygon(Point2f(0, 0), 10, sides);
+	Poly2f b = regularPolygon(Point2f(-30, 5), 10, sides, 0.1f);
+	size_t frame = 0;
+
+	for (auto _ : state) {
+		Poly2f moved = b + Vec2f(0.05f * (float)(frame++ % 1200), 0);
+		benchmark::DoNotOptimize(epaPenetration(a, moved));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LargePolyGJK)->RangeMultiplier(4)->Range(8, 512);
+
+static void BM_LargePolyGJKWarm(benchmark::State& state) {
+	const size_t sides = (size_t)state.range(0);
+	Poly2f a = regularPolygon(Point2f(0, 0), 10, sides);
+	Poly2f b = regularPolygon(Point2f(-30, 5), 10, sides, 0.1f);
+	SimplexCache2<float> cache;
+	size_t frame = 0;
+
+	for (auto _ : state) {
+		Poly2f moved = b + Vec2f(0.05f * (float)(frame++ % 1200), 0);
+		benchmark::DoNotOptimize(epaPenetration(a, moved, cache));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LargePolyGJKWarm)->RangeMultiplier(4)->Range(8, 512);
+
+namespace {
+
+	//count boxes scattered with a constant density, so the number of overlaps grows linearly with the count
+	std::vector<Rect2f> randomBoxes(const size_t count, const unsigned int seed = 42) {
+		std::mt19937 gen(seed);
+		float side = std::sqrt((float)count) * 8.0f;
+		std::uniform_real_distribution<float> pos(0.0f, side);
+		std::uniform_real_distribution<float> ext(0.5f, 3.0f);
+		std::vector<Rect2f> boxes;
+		boxes.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			float x = pos(gen);
+			float y = pos(gen);
+			boxes.push_back(Rect2f(x, y, x + ext(gen), y + ext(gen)));
+		}
+		return boxes;
+	}
+}
+
+static void BM_BruteForcePairs(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+
+	for (auto _ : state) {
+		size_t pairs = 0;
+		for (size_t i = 0; i < boxes.size(); i++) {
+			for (size_t j = i + 1; j < boxes.size(); j++) {
+				pairs += boxes[i].intersects(boxes[j]);
+			}
+		}
+		benchmark::DoNotOptimize(pairs);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BruteForcePairs)->RangeMultiplier(10)->Range(1000, 10000)->Unit(benchmark::kMillisecond);
+
+static void BM_AABBTreeBuild(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+
+	for (auto _ : state) {
+		AABBTree2f tree;
+		for (size_t i = 0; i < boxes.size(); i++) {
+			tree.createProxy(boxes[i], i);
+		}
+		benchmark::DoNotOptimize(tree.height());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AABBTreeBuild)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+//one simulation step: every object moves a little, then the overlapping pairs are enumerated
+static void BM_AABBTreeStep(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	AABBTree2f tree;
+	std::vector<AABBTree2f::NodeId> ids;
+	ids.reserve(boxes.size());
+	for (size_t i = 0; i < boxes.size(); i++) {
+		ids.push_back(tree.createProxy(boxes[i], i));
+	}
+
+	std::mt19937 gen(3);
+	std::uniform_real_distribution<float> step(-0.05f, 0.05f);
+	std::vector<Vec2f> velocity(boxes.size());
+	for (auto& v : velocity) {
+		v = Vec2f(step(gen), step(gen));
+	}
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < boxes.size(); i++) {
+			boxes[i] += velocity[i];
+			tree.moveProxy(ids[i], boxes[i], velocity[i]);
+		}
+		size_t pairs = 0;
+		tree.queryPairs([&](auto, auto) { pairs++; });
+		benchmark::DoNotOptimize(pairs);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AABBTreeStep)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_AABBTreeRegionQuery(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	AABBTree2f tree;
+	for (size_t i = 0; i < boxes.size(); i++) {
+		tree.createProxy(boxes[i], i);
+	}
+	auto regions = randomBoxes(1024, 9);
+	float side = std::sqrt((float)boxes.size()) * 8.0f / std::sqrt(1024.0f) / 8.0f;
+	for (auto& r : regions) {
+		r = Rect2f(r.min.x * side, r.min.y * side, r.min.x * side + 20.0f, r.min.y * side + 20.0f);
+	}
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (const auto& r : regions) {
+			tree.query(r, [&](auto) { hits++; });
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * (int64_t)regions.size());
+}
+BENCHMARK(BM_AABBTreeRegionQuery)->RangeMultiplier(10)->Range(1000, 1000000);
+
+//clear and reinsert everything, as a per frame rebuild would
+static void BM_SpatialHashRebuild(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	SpatialHash2f hash(4.0f, boxes.size());
+
+	for (auto _ : state) {
+		hash.clear();
+		for (size_t i = 0; i < boxes.size(); i++) {
+			hash.insert(boxes[i], i);
+		}
+		benchmark::DoNotOptimize(hash.size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpatialHashRebuild)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_SpatialHashUpdate(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	SpatialHash2f hash(4.0f, boxes.size());
+	std::vector<SpatialHash2f::ItemId> ids;
+	ids.reserve(boxes.size());
+	for (size_t i = 0; i < boxes.size(); i++) {
+		ids.push_back(hash.insert(boxes[i], i));
+	}
+
+	std::mt19937 gen(3);
+	std::uniform_real_distribution<float> step(-0.05f, 0.05f);
+	std::vector<Vec2f> velocity(boxes.size());
+	for (auto& v : velocity) {
+		v = Vec2f(step(gen), step(gen));
+	}
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < boxes.size(); i++) {
+			boxes[i] += velocity[i];
+			hash.update(ids[i], boxes[i]);
+		}
+		benchmark::DoNotOptimize(hash.size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpatialHashUpdate)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_SpatialHashRegionQuery(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	SpatialHash2f hash(4.0f, boxes.size());
+	for (size_t i = 0; i < boxes.size(); i++) {
+		hash.insert(boxes[i], i);
+	}
+	auto regions = randomBoxes(1024, 9);
+	float side = std::sqrt((float)boxes.size()) * 8.0f / std::sqrt(1024.0f) / 8.0f;
+	for (auto& r : regions) {
+		r = Rect2f(r.min.x * side, r.min.y * side, r.min.x * side + 20.0f, r.min.y * side + 20.0f);
+	}
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (const auto& r : regions) {
+			hash.query(r, [&](auto) { hits++; });
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * (int64_t)regions.size());
+}
+BENCHMARK(BM_SpatialHashRegionQuery)->RangeMultiplier(10)->Range(1000, 1000000);
+
+namespace {
+
+	//1024 20x20 regions spread over the area covered by randomBoxes(count)
+	std::vector<Rect2f> queryRegions(const size_t count) {
+		std::mt19937 gen(9);
+		float side = std::sqrt((float)count) * 8.0f;
+		std::uniform_real_distribution<float> pos(0.0f, side);
+		std::vector<Rect2f> regions;
+		for (size_t i = 0; i < 1024; i++) {
+			float x = pos(gen);
+			float y = pos(gen);
+			regions.push_back(Rect2f(x, y, x + 20.0f, y + 20.0f));
+		}
+		return regions;
+	}
+}
+
+static void BM_BruteForceRegionQuery(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	auto regions = queryRegions(boxes.size());
+	std::vector<uint32_t> out(4096);
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (const auto& r : regions) {
+			size_t found = 0;
+			for (size_t i = 0; i < boxes.size(); i++) {
+				if (boxes[i].intersects(r) && found < out.size()) out[found++] = (uint32_t)i;
+			}
+			hits += found;
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * (int64_t)regions.size());
+}
+BENCHMARK(BM_BruteForceRegionQuery)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_LooseQuadtreeBuild(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	LooseQuadtree2f tree;
+
+	for (auto _ : state) {
+		tree.build(boxes);
+		benchmark::DoNotOptimize(tree.nodeCount());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LooseQuadtreeBuild)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_LooseQuadtreeRegionQuery(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	auto regions = queryRegions(boxes.size());
+	LooseQuadtree2f tree;
+	tree.build(boxes);
+	std::vector<LooseQuadtree2f::ItemId> out(4096);
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (const auto& r : regions) {
+			hits += tree.query(r, out);
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * (int64_t)regions.size());
+}
+BENCHMARK(BM_LooseQuadtreeRegionQuery)->RangeMultiplier(10)->Range(10000, 1000000);
+
+static void BM_LooseQuadtreeNearest(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	auto regions = queryRegions(boxes.size());
+	LooseQuadtree2f tree;
+	tree.build(boxes);
+
+	for (auto _ : state) {
+		size_t sum = 0;
+		for (const auto& r : regions) {
+			sum += tree.nearest(r.min);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * (int64_t)regions.size());
+}
+BENCHMARK(BM_LooseQuadtreeNearest)->RangeMultiplier(10)->Range(10000, 1000000);
+
+namespace {
+
+	//one frame of coherent motion: every box moves a little, then the broadphase updates
+	template<typename Update>
+	void sweepAndPruneFrames(benchmark::State& state, Update&& update) {
+		auto boxes = randomBoxes((size_t)state.range(0));
+		SweepAndPrune2f sap;
+		std::vector<SweepAndPrune2f::ProxyId> ids;
+		ids.reserve(boxes.size());
+		for (size_t i = 0; i < boxes.size(); i++) {
+			ids.push_back(sap.createProxy(boxes[i], i));
+		}
+		sap.update();
+
+		std::mt19937 gen(3);
+		std::uniform_real_distribution<float> step(-0.05f, 0.05f);
+		std::vector<Vec2f> velocity(boxes.size());
+		for (auto& v : velocity) {
+			v = Vec2f(step(gen), step(gen));
+		}
+
+		for (auto _ : state) {
+			for (size_t i = 0; i < boxes.size(); i++) {
+				boxes[i] += velocity[i];
+				sap.moveProxy(ids[i], boxes[i]);
+			}
+			size_t events = 0;
+			update(sap, [&](auto, auto) { events++; });
+			benchmark::DoNotOptimize(events);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+}
+
+static void BM_SweepAndPruneStep(benchmark::State& state) {
+	sweepAndPruneFrames(state, [](auto& sap, auto&& count) { sap.update(count, count); });
+}
+BENCHMARK(BM_SweepAndPruneStep)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_SweepAndPruneFullSort(benchmark::State& state) {
+	sweepAndPruneFrames(state, [](auto& sap, auto&& count) { sap.rebuild(count, count); });
+}
+BENCHMARK(BM_SweepAndPruneFullSort)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_HilbertRTreeBuild(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+
+	for (auto _ : state) {
+		PackedHilbertRTree2f tree(boxes);
+		benchmark::DoNotOptimize(tree.getBounds());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HilbertRTreeBuild)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+//restoring a serialized tree, as when loading a map from disk
+static void BM_HilbertRTreeLoad(benchmark::State& state) {
+	auto buffer = PackedHilbertRTree2f(randomBoxes((size_t)state.range(0))).serialize();
+
+	for (auto _ : state) {
+		auto tree = PackedHilbertRTree2f::deserialize(buffer);
+		benchmark::DoNotOptimize(tree.getBounds());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HilbertRTreeLoad)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_HilbertRTreeRegionQuery(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	auto regions = queryRegions(boxes.size());
+	PackedHilbertRTree2f tree(boxes);
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (const auto& r : regions) {
+			tree.query(r, [&](auto) { hits++; });
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * (int64_t)regions.size());
+}
+BENCHMARK(BM_HilbertRTreeRegionQuery)->RangeMultiplier(10)->Range(10000, 1000000);
+
+static void BM_HilbertRTreeRayQuery(benchmark::State& state) {
+	auto boxes = randomBoxes((size_t)state.range(0));
+	auto regions = queryRegions(boxes.size());
+	PackedHilbertRTree2f tree(boxes);
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (const auto& r : regions) {
+			tree.rayQuery(r.min, Vec2f(1.0f, 0.5f), 50.0f, [&](auto) { hits++; });
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * (int64_t)regions.size());
+}
+BENCHMARK(BM_HilbertRTreeRayQuery)->RangeMultiplier(10)->Range(10000, 1000000);
+
+namespace {
+
+	std::vector<Ray2f> randomRays(const size_t count, const float side, const unsigned int seed = 31) {
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> pos(0.0f, side);
+		std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+		std::vector<Ray2f> rays;
+		rays.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			float a = angle(gen);
+			rays.push_back(Ray2f(Point2f(pos(gen), pos(gen)), NormVec2f(std::cos(a), std::sin(a))));
+		}
+		return rays;
+	}
+}
+
+//one ray against every rect, one cast at a time
+static void BM_RayCastRects(benchmark::State& state) {
+	auto rects = randomBoxes((size_t)state.range(0));
+	Ray2f ray = randomRays(1, std::sqrt((float)rects.size()) * 8.0f)[0];
+	std::vector<RayHit2<float>> out(rects.size());
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < rects.size(); i++) {
+			out[i] = ray.cast(rects[i], 1000.0f);
+		}
+		benchmark::DoNotOptimize(out.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RayCastRects)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+static void BM_RayCastRectsBatch(benchmark::State& state) {
+	auto rects = randomBoxes((size_t)state.range(0));
+	Ray2f ray = randomRays(1, std::sqrt((float)rects.size()) * 8.0f)[0];
+	std::vector<RayHit2<float>> out(rects.size());
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(ray.castBatch(rects, 1000.0f, out));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RayCastRectsBatch)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+//many rays against one rect, as for line of sight checks against a single target
+static void BM_RayCastRaysBatch(benchmark::State& state) {
+	auto rays = randomRays((size_t)state.range(0), 100.0f);
+	Rect2f target(40, 40, 60, 60);
+	std::vector<RayHit2<float>> out(rays.size());
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Ray2f::castBatch(rays, target, 200.0f, out));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RayCastRaysBatch)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+static void BM_RayCastPoly(benchmark::State& state) {
+	auto polys = randomPolygons((size_t)state.range(0));
+	Ray2f ray(Point2f(-100, -100), NormVec2f(1, 1));
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (const auto& poly : polys) {
+			hits += ray.cast(poly, 1000.0f).hit;
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RayCastPoly)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+
+namespace {
+
+	std::vector<Point2f> containsQueries(const size_t count) {
+		std::mt19937 gen(23);
+		std::uniform_real_distribution<float> pos(-12.0f, 12.0f);
+		std::vector<Point2f> points(count);
+		for (auto& p : points) {
+			p = Point2f(pos(gen), pos(gen));
+		}
+		return points;
+	}
+}
+
+//one at a time through the fan binary search
+static void BM_PolyContains(benchmark::State& state) {
+	Poly2f poly = regularPolygon(Point2f(0, 0), 10, (size_t)state.range(0));
+	std::vector<Point2f> points = containsQueries(4096);
+
+	for (auto _ : state) {
+		size_t count = 0;
+		for (const Point2f& p : points) {
+			count += poly.contains(p);
+		}
+		benchmark::DoNotOptimize(count);
+	}
+	state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PolyContains)->RangeMultiplier(4)->Range(4, 1024);
+
+static void BM_PolyContainsBatch(benchmark::State& state) {
+	Poly2f poly = regularPolygon(Point2f(0, 0), 10, (size_t)state.range(0));
+	std::vector<Point2f> points = containsQueries(4096);
+	std::vector<std::uint8_t> out(points.size());
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(poly.contains(std::span<const Point2f>(points), std::span<std::uint8_t>(out)));
+	}
+	state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PolyContainsBatch)->RangeMultiplier(4)->Range(4, 1024);
+
+namespace {
+
+	//uniform in a disc, so the hull keeps growing with the cloud
+	std::vector<Point2f> hullCloud(const size_t count) {
+		std::mt19937 gen(31);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		std::vector<Point2f> points(count);
+		for (auto& p : points) {
+			float r = 1000.0f * std::sqrt(unit(gen));
+			float angle = 6.2831853f * unit(gen);
+			p = Point2f(r * std::cos(angle), r * std::sin(angle));
+		}
+		return points;
+	}
+}
+
+//the second argument is the thread count, 0 for one per hardware thread, timed by the wall clock
+static void BM_ConvexHull(benchmark::State& state) {
+	std::vector<Point2f> points = hullCloud((size_t)state.range(0));
+	const unsigned threads = (unsigned)state.range(1);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(convexHull(std::span<const Point2f>(points), threads));
+	}
+	state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_ConvexHull)->ArgsProduct({ { 1000, 10000, 100000, 1000000, 10000000 }, { 1, 0 } })->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+static void BM_QuickHull(benchmark::State& state) {
+	std::vector<Point2f> points = hullCloud((size_t)state.range(0));
+	const unsigned threads = (unsigned)state.range(1);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(quickHull(std::span<const Point2f>(points), threads));
+	}
+	state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_QuickHull)->ArgsProduct({ { 1000, 10000, 100000, 1000000, 10000000 }, { 1, 0 } })->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+//a sprite sliding across the view, clipped into the same Poly2 every frame
+static void BM_ClipPolyRect(benchmark::State& state) {
+	Poly2f sprite = regularPolygon(Point2f(0, 0), 10, (size_t)state.range(0));
+	Rect2f view(0, 0, 100, 100);
+	Poly2f out;
+	size_t frame = 0;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(clip(sprite + Vec2f(0.1f * (float)(frame++ % 1200), 50), view, out));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ClipPolyRect)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_IntersectPoly(benchmark::State& state) {
+	const size_t sides = (size_t)state.range(0);
+	Poly2f a = regularPolygon(Point2f(0, 0), 10, sides);
+	Poly2f b = regularPolygon(Point2f(-30, 5), 10, sides, 0.1f);
+	Poly2f out;
+	size_t frame = 0;
+
+	for (auto _ : state) {
+		Poly2f moved = b + Vec2f(0.05f * (float)(frame++ % 1200), 0);
+		benchmark::DoNotOptimize(intersect(a, moved, out));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IntersectPoly)->RangeMultiplier(4)->Range(8, 512);
+
+static void BM_MinkowskiSum(benchmark::State& state) {
+	const size_t sides = (size_t)state.range(0);
+	Poly2f a = regularPolygon(Point2f(0, 0), 10, sides);
+	Poly2f b = regularPolygon(Point2f(-30, 5), 4, sides, 0.1f);
+	Poly2f out;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(minkowskiSum(a, b, out));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MinkowskiSum)->RangeMultiplier(4)->Range(4, 1024);
+
+//a level's worth of obstacles given a rounded margin, the second argument is the thread count
+static void BM_InflateBatch(benchmark::State& state) {
+	std::mt19937 gen(47);
+	std::uniform_real_distribution<float> pos(-1000.0f, 1000.0f);
+	std::vector<Poly2f> obstacles;
+	for (int64_t i = 0; i < state.range(0); i++) {
+		obstacles.push_back(regularPolygon(Point2f(pos(gen), pos(gen)), 5, 3 + (size_t)(i % 6)));
+	}
+	std::vector<Poly2f> out(obstacles.size());
+
+	for (auto _ : state) {
+		inflateBatch(std::span<const Poly2f>(obstacles), 2.0f, std::span<Poly2f>(out), 16, (unsigned)state.range(1));
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * obstacles.size());
+}
+BENCHMARK(BM_InflateBatch)->ArgsProduct({ { 1000, 10000, 100000 }, { 1, 0 } })->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+namespace {
+
+	//a jagged star shaped outline, like a cave wall, with both spikes and notches everywhere
+	std::vector<Point2f> caveOutline(const size_t count) {
+		std::mt19937 gen(53);
+		std::uniform_real_distribution<float> radius(300.0f, 1000.0f);
+		std::vector<Point2f> points(count);
+		for (size_t i = 0; i < count; i++) {
+			float r = radius(gen);
+			float angle = 6.2831853f * (float)i / (float)count;
+			points[i] = Point2f(r * std::cos(angle), r * std::sin(angle));
+		}
+		return points;
+	}
+}
+
+static void BM_SimplePolyTriangulate(benchmark::State& state) {
+	SimplePoly2f cave(caveOutline((size_t)state.range(0)));
+	SimplePoly2f::Scratch scratch;
+	std::vector<SimplePoly2f::Triangle> triangles;
+
+	for (auto _ : state) {
+		cave.triangulate(triangles, scratch);
+		benchmark::DoNotOptimize(triangles.data());
+	}
+	state.SetItemsProcessed(state.iterations() * cave.size());
+}
+BENCHMARK(BM_SimplePolyTriangulate)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SimplePolyEarClipping(benchmark::State& state) {
+	SimplePoly2f cave(caveOutline((size_t)state.range(0)));
+	SimplePoly2f::Scratch scratch;
+	std::vector<SimplePoly2f::Triangle> triangles;
+
+	for (auto _ : state) {
+		cave.triangulateEarClipping(triangles, scratch);
+		benchmark::DoNotOptimize(triangles.data());
+	}
+	state.SetItemsProcessed(state.iterations() * cave.size());
+}
+BENCHMARK(BM_SimplePolyEarClipping)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SimplePolyDecompose(benchmark::State& state) {
+	SimplePoly2f cave(caveOutline((size_t)state.range(0)));
+	SimplePoly2f::Scratch scratch;
+	std::vector<Poly2f> pieces;
+
+	for (auto _ : state) {
+		cave.decompose(pieces, scratch);
+		benchmark::DoNotOptimize(pieces.data());
+	}
+	state.SetItemsProcessed(state.iterations() * cave.size());
+}
+BENCHMARK(BM_SimplePolyDecompose)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+namespace {
+
+	//the primitives run over this many inputs per iteration, so a loop of them is timed rather than one call
+	constexpr size_t primitiveBatch = 1024;
+
+	template<typename T>
+	std::vector<Point2<T>> typedPoints(const size_t count, const unsigned int seed = 42) {
+		std::vector<Point2<T>> points;
+		points.reserve(count);
+		for (const Point2f& p : randomPoints(count, seed)) {
+			points.push_back(Point2<T>((T)p.x, (T)p.y));
+		}
+		return points;
+	}
+
+	template<typename T>
+	std::vector<Vec2<T>> typedVecs(const size_t count, const unsigned int seed = 43) {
+		std::vector<Vec2<T>> vecs;
+		vecs.reserve(count);
+		for (const Point2f& p : randomPoints(count, seed)) {
+			vecs.push_back(Vec2<T>((T)p.x, (T)p.y));
+		}
+		return vecs;
+	}
+
+	template<typename T>
+	std::vector<Rect2<T>> typedRects(const size_t count, const unsigned int seed = 44) {
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> size(1.0f, 100.0f);
+		std::vector<Rect2<T>> rects;
+		rects.reserve(count);
+		for (const Point2f& p : randomPoints(count, seed)) {
+			rects.push_back(Rect2<T>((T)p.x, (T)p.y, (T)(p.x + size(gen)), (T)(p.y + size(gen))));
+		}
+		return rects;
+	}
+
+	template<typename T>
+	Mat3<T> typedMatrix() {
+		Mat3<T> m;
+		m.translate(Vec2<T>((T)5.0f, (T)8.0f));
+		m.scale((T)2.0f, (T)3.0f);
+		m.rotate(60_deg);
+		return m;
+	}
+}
+
+template<typename T>
+static void BM_Vec2Arithmetic(benchmark::State& state) {
+	auto a = typedVecs<T>(primitiveBatch, 1);
+	auto b = typedVecs<T>(primitiveBatch, 2);
+	std::vector<Vec2<T>> out(primitiveBatch);
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			out[i] = (a[i] + b[i]) * (T)0.5f - b[i];
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+template<typename T>
+static void BM_Vec2DotCross(benchmark::State& state) {
+	auto a = typedVecs<T>(primitiveBatch, 1);
+	auto b = typedVecs<T>(primitiveBatch, 2);
+
+	for (auto _ : state) {
+		T sum = (T)0.0f;
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			sum += a[i].dot(b[i]) + a[i].cross(b[i]);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+template<typename T>
+static void BM_Point2Arithmetic(benchmark::State& state) {
+	auto points = typedPoints<T>(primitiveBatch);
+	auto vecs = typedVecs<T>(primitiveBatch);
+	std::vector<Point2<T>> out(primitiveBatch);
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			out[i] = points[i] + vecs[i] - vecs[primitiveBatch - 1 - i];
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+template<typename T>
+static void BM_NormVec2Construct(benchmark::State& state) {
+	auto vecs = typedVecs<T>(primitiveBatch);
+	std::vector<NormVec2<T>> out(primitiveBatch);
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			out[i] = NormVec2<T>(vecs[i].x, vecs[i].y);
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+//the argument picks the builder, named in the label
+template<typename T>
+static void BM_Mat3Builder(benchmark::State& state) {
+	static const char* names[] = { "translate", "rotate", "scale", "shear", "reflX", "linRefl", "orthProj" };
+	const Mat3<T> start = typedMatrix<T>();
+	const Vec2<T> v((T)3.0f, (T)-2.0f);
+	const Point2<T> c((T)1.0f, (T)4.0f);
+	const int64_t builder = state.range(0);
+	state.SetLabel(names[builder]);
+
+	for (auto _ : state) {
+		Mat3<T> m = start;
+		benchmark::DoNotOptimize(m);
+		switch (builder) {
+		case 0: m.translate(v); break;
+		case 1: m.rotate(30_deg, c); break;
+		case 2: m.scale((T)2.0f, (T)3.0f, c); break;
+		case 3: m.shear((T)0.5f, (T)0.25f, c); break;
+		case 4: m.reflX(); break;
+		case 5: m.linRefl(v, c); break;
+		case 6: m.orthProj(v, c); break;
+		}
+		benchmark::DoNotOptimize(m);
+	}
+}
+
+//the argument picks the transform overload, named in the label
+template<typename T>
+static void BM_Mat3Transform(benchmark::State& state) {
+	static const char* names[] = { "Point2", "Vec2", "NormVec2", "Dim2", "Rect2", "Poly2" };
+	Mat3<T> m = typedMatrix<T>();
+	auto points = typedPoints<T>(primitiveBatch);
+	auto vecs = typedVecs<T>(primitiveBatch);
+	auto rects = typedRects<T>(primitiveBatch);
+	std::vector<NormVec2<T>> norms;
+	std::vector<Dim2<T>> dims;
+	std::vector<Poly2<T>> polys;
+	for (size_t i = 0; i < primitiveBatch; i++) {
+		norms.push_back(NormVec2<T>(vecs[i].x, vecs[i].y));
+		dims.push_back(Dim2<T>(vecs[i].x, vecs[i].y));
+		polys.push_back(Poly2<T>(rects[i]));
+	}
+	const int64_t overload = state.range(0);
+	state.SetLabel(names[overload]);
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			switch (overload) {
+			case 0: benchmark::DoNotOptimize(m.transform(points[i])); break;
+			case 1: benchmark::DoNotOptimize(m.transform(vecs[i])); break;
+			case 2: benchmark::DoNotOptimize(m.transform(norms[i])); break;
+			case 3: benchmark::DoNotOptimize(m.transform(dims[i])); break;
+			case 4: benchmark::DoNotOptimize(m.transform(rects[i])); break;
+			case 5: benchmark::DoNotOptimize(m.transform(polys[i])); break;
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+template<typename T>
+static void BM_Mat3Inverse(benchmark::State& state) {
+	Mat3<T> m = typedMatrix<T>();
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(m);
+		benchmark::DoNotOptimize(m.inverse());
+	}
+}
+
+//the argument picks what is computed on a freshly built Poly2, so nothing comes from the cache
+template<typename T>
+static void BM_Poly2Metrics(benchmark::State& state) {
+	static const char* names[] = { "trusted", "checked", "area", "centroid", "AABB" };
+	std::vector<std::vector<Point2<T>>> outlines;
+	for (const Poly2f& poly : randomPolygons(primitiveBatch, 8)) {
+		std::vector<Point2<T>> outline;
+		for (const Point2f& p : poly.getPoints()) {
+			outline.push_back(Point2<T>((T)p.x, (T)p.y));
+		}
+		outlines.push_back(std::move(outline));
+	}
+	const int64_t metric = state.range(0);
+	state.SetLabel(names[metric]);
+
+	for (auto _ : state) {
+		for (const auto& outline : outlines) {
+			if (metric == 1) {
+				benchmark::DoNotOptimize(Poly2<T>(outline));
+				continue;
+			}
+			Poly2<T> poly(trustedConvex, outline);
+			switch (metric) {
+			case 0: benchmark::DoNotOptimize(poly); break;
+			case 2: benchmark::DoNotOptimize(poly.area()); break;
+			case 3: benchmark::DoNotOptimize(poly.centroid()); break;
+			case 4: benchmark::DoNotOptimize(poly.getAABB()); break;
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+template<typename T>
+static void BM_Rect2Intersects(benchmark::State& state) {
+	auto rects = typedRects<T>(primitiveBatch);
+	const Rect2<T> query((T)-200.0f, (T)-200.0f, (T)200.0f, (T)200.0f);
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (const Rect2<T>& r : rects) {
+			hits += query.intersects(r);
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+template<typename T>
+static void BM_Rect2Contains(benchmark::State& state) {
+	auto rects = typedRects<T>(primitiveBatch);
+	auto points = typedPoints<T>(primitiveBatch);
+	const Rect2<T> query((T)-500.0f, (T)-500.0f, (T)500.0f, (T)500.0f);
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			hits += query.contains(points[i]) + query.contains(rects[i]);
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+//every primitive is timed with plain floats and with both unit types, whose wrappers should cost nothing
+#define S2D_BENCH_UNITS(bench, ...) \
+	BENCHMARK_TEMPLATE(bench, float)__VA_ARGS__; \
+	BENCHMARK_TEMPLATE(bench, Pixels)__VA_ARGS__; \
+	BENCHMARK_TEMPLATE(bench, Meters)__VA_ARGS__
+
+S2D_BENCH_UNITS(BM_Vec2Arithmetic);
+S2D_BENCH_UNITS(BM_Vec2DotCross);
+S2D_BENCH_UNITS(BM_Point2Arithmetic);
+S2D_BENCH_UNITS(BM_NormVec2Construct);
+S2D_BENCH_UNITS(BM_Mat3Builder, ->DenseRange(0, 6));
+S2D_BENCH_UNITS(BM_Mat3Transform, ->DenseRange(0, 5));
+S2D_BENCH_UNITS(BM_Mat3Inverse);
+S2D_BENCH_UNITS(BM_Poly2Metrics, ->DenseRange(0, 4));
+S2D_BENCH_UNITS(BM_Rect2Intersects);
+S2D_BENCH_UNITS(BM_Rect2Contains);
+
+//a unit conversion should cost the same single multiply as scaling a float by hand
+static void BM_PixelsToMetersFloat(benchmark::State& state) {
+	std::vector<float> in(primitiveBatch);
+	std::vector<float> out(primitiveBatch);
+	for (size_t i = 0; i < primitiveBatch; i++) {
+		in[i] = (float)i;
+	}
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			out[i] = in[i] * (1.0f / S2D_PIXEL_TO_METER);
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+BENCHMARK(BM_PixelsToMetersFloat);
+
+static void BM_PixelsToMeters(benchmark::State& state) {
+	std::vector<Pixels> in(primitiveBatch);
+	std::vector<Meters> out(primitiveBatch);
+	for (size_t i = 0; i < primitiveBatch; i++) {
+		in[i] = Pixels((float)i);
+	}
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			out[i] = in[i];
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+BENCHMARK(BM_PixelsToMeters);
+
+static void BM_DegreesToRadians(benchmark::State& state) {
+	std::vector<Degrees> in(primitiveBatch);
+	std::vector<Radians> out(primitiveBatch);
+	for (size_t i = 0; i < primitiveBatch; i++) {
+		in[i] = Degrees((float)(i % 360));
+	}
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			out[i] = in[i];
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+BENCHMARK(BM_DegreesToRadians);
+
+namespace {
+
+	std::vector<Radians> spriteAngles(const size_t count, const unsigned int seed = 45) {
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> dist(-6.2831853f, 6.2831853f);
+		std::vector<Radians> angles(count);
+		for (auto& a : angles) {
+			a = Radians(dist(gen));
+		}
+		return angles;
+	}
+}
+
+//the rotation of every sprite in a frame, one angle at a time and as a batch
+template<TrigPrecision P>
+static void BM_SinCos(benchmark::State& state) {
+	auto angles = spriteAngles(primitiveBatch);
+
+	for (auto _ : state) {
+		float sum = 0.0f;
+		for (const Radians& a : angles) {
+			const SinCos sc = sincos<P>(a);
+			sum += sc.sin + sc.cos;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+template<TrigPrecision P>
+static void BM_SinCosBatch(benchmark::State& state) {
+	auto angles = spriteAngles(primitiveBatch);
+	std::vector<float> sines(primitiveBatch);
+	std::vector<float> cosines(primitiveBatch);
+
+	for (auto _ : state) {
+		sincos<P>(std::span<const Radians>(angles), sines, cosines);
+		benchmark::DoNotOptimize(sines.data());
+		benchmark::DoNotOptimize(cosines.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+template<TrigPrecision P>
+static void BM_Mat3RotateSprites(benchmark::State& state) {
+	auto angles = spriteAngles(primitiveBatch);
+	std::vector<Mat3f> out(primitiveBatch);
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			const SinCos sc = sincos<P>(angles[i]);
+			out[i] = Mat3f(sc.cos, -sc.sin, 0.0f, sc.sin, sc.cos, 0.0f, 0.0f, 0.0f, 1.0f);
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+
+#define S2D_BENCH_TRIG(bench) \
+	BENCHMARK_TEMPLATE(bench, TrigPrecision::exact); \
+	BENCHMARK_TEMPLATE(bench, TrigPrecision::polynomial); \
+	BENCHMARK_TEMPLATE(bench, TrigPrecision::table)
+
+S2D_BENCH_TRIG(BM_SinCos);
+S2D_BENCH_TRIG(BM_SinCosBatch);
+S2D_BENCH_TRIG(BM_Mat3RotateSprites);
+
+//a frame of spinning sprites, kept as angles and rebuilt through sin/cos, or kept as Rot2 and integrated
+static void BM_SpriteSpinAngle(benchmark::State& state) {
+	auto angles = spriteAngles(primitiveBatch);
+	auto spins = spriteAngles(primitiveBatch, 46);
+	std::vector<Mat3f> out(primitiveBatch);
+	const float dt = 1.0f / 60.0f;
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			angles[i] = Radians(angles[i].get() + spins[i].get() * dt);
+			const SinCos sc = sincos(angles[i]);
+			out[i] = Mat3f(sc.cos, -sc.sin, 0.0f, sc.sin, sc.cos, 0.0f, 0.0f, 0.0f, 1.0f);
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+BENCHMARK(BM_SpriteSpinAngle);
+
+static void BM_SpriteSpinRot2(benchmark::State& state) {
+	auto angles = spriteAngles(primitiveBatch);
+	auto spins = spriteAngles(primitiveBatch, 46);
+	std::vector<Rot2f> rots;
+	rots.reserve(primitiveBatch);
+	for (const Radians& a : angles) {
+		rots.emplace_back(a);
+	}
+	std::vector<Mat3f> out(primitiveBatch);
+	const float dt = 1.0f / 60.0f;
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < primitiveBatch; i++) {
+			rots[i].integrate(spins[i].get() * dt);
+			out[i] = rots[i].toMat3();
+		}
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * primitiveBatch);
+}
+BENCHMARK(BM_SpriteSpinRot2);
@@ -0,0 +1,355 @@
+#pragma once
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <random>
+#include <future>
+#include <thread>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+#include "Space2D.h"
+
+namespace Space2D::driver {
+
+	/**
+	 * @brief how the bodies are spread over the world
+	*/
+	enum class Distribution {
+		Uniform,
+		Clustered,
+		Gaussian
+	};
+
+	/**
+	 * @brief The settings of a stress run, read from the command line
+	*/
+	struct StressOptions {
+		size_t objects = 10000;
+		unsigned threads = 0;
+		size_t frames = 600;
+		size_t warmup = 30;
+		float polyFraction = 0.5f;
+		float world = 10000.0f;
+		Distribution distribution = Distribution::Uniform;
+		unsigned seed = 42;
+		bool help = false;
+
+		/**
+		 * @brief Parses --name value pairs
+		 * @details throws std::invalid_argument on an unknown flag or a bad value
+		*/
+		static StressOptions parse(const int argc, char* argv[]) {
+			StressOptions options;
+			for (int i = 1; i < argc; i++) {
+				std::string flag = argv[i];
+				if (flag == "--help" || flag == "-h") {
+					options.help = true;
+					continue;
+				}
+				if (i + 1 >= argc) throw std::invalid_argument("missing value for " + flag);
+				std::string value = argv[++i];
+
+				if (flag == "--objects") options.objects = std::stoull(value);
+				else if (flag == "--threads") options.threads = (unsigned)std::stoul(value);
+				else if (flag == "--frames") options.frames = std::stoull(value);
+				else if (flag == "--warmup") options.warmup = std::stoull(value);
+				else if (flag == "--poly-fraction") options.polyFraction = std::stof(value);
+				else if (flag == "--world") options.world = std::stof(value);
+				else if (flag == "--seed") options.seed = (unsigned)std::stoul(value);
+				else if (flag == "--distribution") {
+					if (value == "uniform") options.distribution = Distribution::Uniform;
+					else if (value == "clustered") options.distribution = Distribution::Clustered;
+					else if (value == "gaussian") options.distribution = Distribution::Gaussian;
+					else throw std::invalid_argument("unknown distribution " + value);
+				}
+				else throw std::invalid_argument("unknown flag " + flag);
+			}
+			if (options.frames == 0) throw std::invalid_argument("--frames must be at least 1");
+			if (options.polyFraction < 0.0f || options.polyFraction > 1.0f) throw std::invalid_argument("--poly-fraction must be within [0, 1]");
+			if (options.threads == 0) {
+				options.threads = std::max(1u, std::thread::hardware_concurrency());
+			}
+			return options;
+		}
+
+		static void usage(std::ostream& os) {
+			os << "Space2D_DRIVER, a headless stress test of the Space2D per frame pipeline\n"
+				<< "  --objects N          bodies to simulate (10000)\n"
+				<< "  --threads N          threads for the parallel stages, 0 for one per hardware thread (0)\n"
+				<< "  --frames N           frames to time (600)\n"
+				<< "  --warmup N           frames to run before timing (30)\n"
+				<< "  --poly-fraction F    share of the bodies that are Poly2's rather than Rect2's (0.5)\n"
+				<< "  --world F            side length of the square world (10000)\n"
+				<< "  --distribution D     uniform, clustered or gaussian (uniform)\n"
+				<< "  --seed N             random seed (42)\n";
+		}
+	};
+
+	/**
+	 * @brief The latencies of one pipeline stage over every timed frame
+	*/
+	class StageStats {
+	public:
+
+		explicit StageStats(std::string name) : name(std::move(name)) {}
+
+		void record(const std::chrono::nanoseconds elapsed, const size_t items) {
+			samples.push_back(elapsed.count());
+			itemCount += items;
+		}
+
+		/**
+		 * @brief the nearest rank percentile, in microseconds
+		*/
+		double percentile(const double p) const {
+			if (samples.empty()) return 0.0;
+			std::vector<std::int64_t> sorted = samples;
+			size_t rank = (size_t)std::ceil(p / 100.0 * (double)sorted.size());
+			rank = std::clamp<size_t>(rank, 1, sorted.size());
+			std::nth_element(sorted.begin(), sorted.begin() + (rank - 1), sorted.end());
+			return (double)sorted[rank - 1] / 1000.0;
+		}
+
+		/**
+		 * @brief the items processed per second over all timed frames
+		*/
+		double throughput() const {
+			std::int64_t total = 0;
+			for (std::int64_t s : samples) total += s;
+			return total == 0 ? 0.0 : (double)itemCount * 1e9 / (double)total;
+		}
+
+		void report(std::ostream& os) const {
+			os << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(1)
+				<< std::setw(12) << percentile(50.0)
+				<< std::setw(12) << percentile(99.0)
+				<< std::setw(12) << percentile(100.0)
+				<< std::setw(16) << std::setprecision(0) << throughput() << "\n";
+		}
+
+		static void header(std::ostream& os) {
+			os << std::left << std::setw(14) << "stage" << std::right
+				<< std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::setw(12) << "max us"
+				<< std::setw(16) << "items/s" << "\n";
+		}
+
+	private:
+		std::string name;
+		std::vector<std::int64_t> samples;
+		size_t itemCount = 0;
+	};
+
+	/**
+	 * @brief Runs fn over [0, count) in one contiguous chunk per thread, the calling thread taking the first
+	*/
+	template<typename Fn>
+	void parallelFor(const size_t count, const unsigned threads, Fn&& fn) {
+		const size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, count));
+		std::vector<std::future<void>> pending;
+		for (size_t c = 1; c < chunks; c++) {
+			pending.push_back(std::async(std::launch::async, [&fn, count, chunks, c] {
+				fn(count * c / chunks, count * (c + 1) / chunks);
+			}));
+		}
+		fn(0, count / chunks);
+		for (auto& part : pending) {
+			part.get();
+		}
+	}
+
+	/**
+	 * @brief A moving, spinning body, either a convex Poly2 or a Rect2
+	*/
+	struct Body {
+		bool isPoly = false;
+		Poly2f local;
+		Poly2f world;
+		Rect2f box;
+		Dim2f halfSize;
+		Point2f position;
+		Vec2f velocity;
+		float angle = 0.0f;
+		float spin = 0.0f;
+	};
+
+	/**
+	 * @brief The simulated world, advanced one frame at a time through the timed stages
+	 * @details each frame moves every body, rebuilds the world Poly2's through Mat3 transforms,
+	 * refreshes their AABB's, finds the overlapping bounds with a SweepAndPrune2 broadphase
+	 * and tests every candidate pair with SAT
+	*/
+	class StressWorld {
+	public:
+
+		explicit StressWorld(const StressOptions& options) : options(options) {
+			std::mt19937 gen(options.seed);
+			std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+			std::normal_distribution<float> normal(0.0f, 1.0f);
+
+			const float half = options.world * 0.5f;
+			std::vector<Point2f> clusters(16);
+			for (auto& c : clusters) {
+				c = Point2f((unit(gen) - 0.5f) * options.world * 0.8f, (unit(gen) - 0.5f) * options.world * 0.8f);
+			}
+
+			auto place = [&]() {
+				switch (options.distribution) {
+				case Distribution::Clustered: {
+					const Point2f& c = clusters[gen() % clusters.size()];
+					return Point2f(c.x + normal(gen) * options.world * 0.02f, c.y + normal(gen) * options.world * 0.02f);
+				}
+				case Distribution::Gaussian:
+					return Point2f(normal(gen) * options.world * 0.15f, normal(gen) * options.world * 0.15f);
+				default:
+					return Point2f((unit(gen) - 0.5f) * options.world, (unit(gen) - 0.5f) * options.world);
+				}
+			};
+
+			bodies.resize(options.objects);
+			for (size_t i = 0; i < bodies.size(); i++) {
+				Body& body = bodies[i];
+				Point2f p = place();
+				body.position = Point2f(std::clamp(p.x, -half, half), std::clamp(p.y, -half, half));
+				body.velocity = Vec2f((unit(gen) - 0.5f) * 10.0f, (unit(gen) - 0.5f) * 10.0f);
+				body.spin = (unit(gen) - 0.5f) * 0.1f;
+				float size = 2.0f + unit(gen) * 18.0f;
+				body.isPoly = unit(gen) < options.polyFraction;
+
+				if (body.isPoly) {
+					size_t sides = 3 + gen() % 6;
+					Poly2f::PointStorage points(sides);
+					for (size_t j = 0; j < sides; j++) {
+						float a = 6.2831853f * (float)j / (float)sides;
+						points[j] = Point2f(size * std::cos(a), size * std::sin(a));
+					}
+					body.local = Poly2f(trustedConvex, std::move(points));
+				}
+				else {
+					body.halfSize = Dim2f(size, size * (0.5f + unit(gen)));
+				}
+			}
+
+			transform(0, bodies.size());
+			bounds(0, bodies.size());
+			for (size_t i = 0; i < bodies.size(); i++) {
+				proxies.push_back(broadphase.createProxy(aabb(bodies[i]), i));
+			}
+			broadphase.update();
+		}
+
+		/**
+		 * @brief Runs one frame, recording each stage when stats is not null
+		*/
+		void step(std::vector<StageStats>* stats) {
+			using clock = std::chrono::steady_clock;
+			const size_t n = bodies.size();
+			const unsigned threads = options.threads;
+
+			auto timed = [&](const size_t stage, const size_t items, auto&& work) {
+				auto start = clock::now();
+				work();
+				if (stats) (*stats)[stage].record(clock::now() - start, items);
+			};
+
+			timed(0, n, [&] { parallelFor(n, threads, [&](size_t first, size_t last) { transform(first, last); }); });
+			timed(1, n, [&] { parallelFor(n, threads, [&](size_t first, size_t last) { bounds(first, last); }); });
+			timed(2, n, [&] {
+				for (size_t i = 0; i < n; i++) {
+					broadphase.moveProxy(proxies[i], aabb(bodies[i]));
+				}
+				broadphase.update();
+				pairs.clear();
+				broadphase.queryPairs([&](auto a, auto b) {
+					pairs.push_back({ broadphase.getData(a), broadphase.getData(b) });
+				});
+			});
+
+			timed(3, pairs.size(), [&] {
+				const size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, pairs.size()));
+				std::vector<std::future<size_t>> pending;
+				auto narrow = [&](size_t first, size_t last) {
+					size_t count = 0;
+					for (size_t i = first; i < last; i++) {
+						count += overlapping(bodies[pairs[i].first], bodies[pairs[i].second]);
+					}
+					return count;
+				};
+				for (size_t c = 1; c < chunks; c++) {
+					pending.push_back(std::async(std::launch::async, narrow, pairs.size() * c / chunks, pairs.size() * (c + 1) / chunks));
+				}
+				contacts = narrow(0, pairs.size() / chunks);
+				for (auto& part : pending) {
+					contacts += part.get();
+				}
+			});
+		}
+
+		size_t pairCount() const noexcept {
+			return pairs.size();
+		}
+
+		size_t contactCount() const noexcept {
+			return contacts;
+		}
+
+	private:
+
+		static Rect2f aabb(const Body& body) {
+			return body.isPoly ? body.world.getAABB() : body.box;
+		}
+
+		static bool overlapping(const Body& a, const Body& b) {
+			if (a.isPoly && b.isPoly) return overlaps(a.world, b.world);
+			if (a.isPoly) return overlaps(a.world, b.box);
+			if (b.isPoly) return overlaps(a.box, b.world);
+			return a.box.intersects(b.box);
+		}
+
+		/**
+		 * @brief moves the bodies, bouncing off the edges of the world, and places their shapes
+		*/
+		void transform(const size_t first, const size_t last) {
+			const float half = options.world * 0.5f;
+			for (size_t i = first; i < last; i++) {
+				Body& body = bodies[i];
+				body.position = body.position + body.velocity;
+				if (body.position.x < -half || body.position.x > half) body.velocity.x = -body.velocity.x;
+				if (body.position.y < -half || body.position.y > half) body.velocity.y = -body.velocity.y;
+				body.angle += body.spin;
+
+				if (body.isPoly) {
+					Mat3f m;
+					m.rotate(Radians(body.angle));
+					m.pretranslate(Vec2f(body.position.x, body.position.y));
+					body.world = m.transform(body.local);
+				}
+				else {
+					body.box = Rect2f(body.position.x - body.halfSize.x, body.position.y - body.halfSize.y,
+						body.position.x + body.halfSize.x, body.position.y + body.halfSize.y);
+				}
+			}
+		}
+
+		/**
+		 * @brief fills the cached AABB and face normals, so the narrowphase threads only read the Poly2's
+		*/
+		void bounds(const size_t first, const size_t last) {
+			for (size_t i = first; i < last; i++) {
+				if (!bodies[i].isPoly) continue;
+				bodies[i].world.getAABB();
+				bodies[i].world.getFaceNormals();
+			}
+		}
+
+		StressOptions options;
+		std::vector<Body> bodies;
+		SweepAndPrune2<float> broadphase;
+		std::vector<SweepAndPrune2<float>::ProxyId> proxies;
+		std::vector<std::pair<size_t, size_t>> pairs;
+		size_t contacts = 0;
+	};
+}
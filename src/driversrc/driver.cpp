@@ -1,5 +1,52 @@
 #include <iostream>
+#include "StressHarness.h"
+
+using namespace Space2D::driver;
 
 int main(int argc, char* argv[]) {
-	std::cout << "Space2D_DRIVER\n";
-}
\ No newline at end of file
+	StressOptions options;
+	try {
+		options = StressOptions::parse(argc, argv);
+	}
+	catch (const std::exception& e) {
+		std::cerr << e.what() << "\n\n";
+		StressOptions::usage(std::cerr);
+		return 1;
+	}
+	if (options.help) {
+		StressOptions::usage(std::cout);
+		return 0;
+	}
+
+	static const char* distributions[] = { "uniform", "clustered", "gaussian" };
+	std::cout << "Space2D_DRIVER: " << options.objects << " bodies (" << options.polyFraction * 100.0f << "% Poly2), "
+		<< distributions[(int)options.distribution] << ", " << options.threads << " threads, "
+		<< options.frames << " frames after " << options.warmup << " warmup\n";
+
+	StressWorld world(options);
+	for (size_t i = 0; i < options.warmup; i++) {
+		world.step(nullptr);
+	}
+
+	std::vector<StageStats> stats{ StageStats("transform"), StageStats("aabb"), StageStats("broadphase"), StageStats("narrowphase") };
+	size_t pairs = 0;
+	size_t contacts = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < options.frames; i++) {
+		world.step(&stats);
+		pairs += world.pairCount();
+		contacts += world.contactCount();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << "\n";
+	StageStats::header(std::cout);
+	for (const StageStats& stage : stats) {
+		stage.report(std::cout);
+	}
+	std::cout << "\n" << std::fixed << std::setprecision(1)
+		<< "frames/s " << (double)options.frames / elapsed.count()
+		<< ", candidate pairs/frame " << (double)pairs / (double)options.frames
+		<< ", contacts/frame " << (double)contacts / (double)options.frames << "\n";
+	return 0;
+}
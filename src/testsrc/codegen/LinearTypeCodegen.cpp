@@ -0,0 +1,112 @@
+//compiled to assembly only, by cmake/CompareCodegen.cmake, and never linked into Space2D_TEST
+//each s2d_codegen_<case>_<units> function must compile to the same instructions as
+//s2d_codegen_<case>_float, showing the unit types cost nothing over plain float
+#include <cstddef>
+#include "Space2D.h"
+
+using namespace Space2D;
+
+static_assert(sizeof(Pixels) == sizeof(float) && sizeof(Vec2p) == sizeof(Vec2f), "unit types must add no storage");
+static_assert(Pixels::conversionFactor<std::ratio<S2D_PIXEL_TO_METER, 1>> == 1.0f / S2D_PIXEL_TO_METER);
+
+namespace {
+
+	template<typename T>
+	void vecArithmetic(Vec2<T>* out, const Vec2<T>* a, const Vec2<T>* b, const size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = (a[i] + b[i]) * (T)0.5f - b[i];
+		}
+	}
+
+	template<typename T>
+	void vecDotCross(T* out, const Vec2<T>* a, const Vec2<T>* b, const size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = a[i].dot(b[i]) + a[i].cross(b[i]);
+		}
+	}
+
+	template<typename T>
+	void pointOffset(Point2<T>* out, const Point2<T>* p, const Vec2<T>* v, const size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = p[i] + v[i];
+		}
+	}
+
+	template<typename T>
+	size_t rectContains(const Rect2<T>& r, const Point2<T>* p, const size_t n) {
+		size_t hits = 0;
+		for (size_t i = 0; i < n; i++) {
+			hits += r.contains(p[i]);
+		}
+		return hits;
+	}
+
+	template<typename T>
+	size_t rectIntersects(const Rect2<T>& r, const Rect2<T>* b, const size_t n) {
+		size_t hits = 0;
+		for (size_t i = 0; i < n; i++) {
+			hits += r.intersects(b[i]);
+		}
+		return hits;
+	}
+}
+
+#define S2D_CODEGEN_UNITS(CASE) CASE(float, float) CASE(pixels, Pixels) CASE(meters, Meters)
+
+#define S2D_CODEGEN_VEC_ARITHMETIC(suffix, T) \
+	void s2d_codegen_vec_arithmetic_##suffix(Vec2<T>* out, const Vec2<T>* a, const Vec2<T>* b, const size_t n) { \
+		vecArithmetic(out, a, b, n); \
+	}
+
+#define S2D_CODEGEN_VEC_DOT_CROSS(suffix, T) \
+	void s2d_codegen_vec_dot_cross_##suffix(T* out, const Vec2<T>* a, const Vec2<T>* b, const size_t n) { \
+		vecDotCross(out, a, b, n); \
+	}
+
+#define S2D_CODEGEN_POINT_OFFSET(suffix, T) \
+	void s2d_codegen_point_offset_##suffix(Point2<T>* out, const Point2<T>* p, const Vec2<T>* v, const size_t n) { \
+		pointOffset(out, p, v, n); \
+	}
+
+#define S2D_CODEGEN_RECT_CONTAINS(suffix, T) \
+	size_t s2d_codegen_rect_contains_##suffix(const Rect2<T>& r, const Point2<T>* p, const size_t n) { \
+		return rectContains(r, p, n); \
+	}
+
+#define S2D_CODEGEN_RECT_INTERSECTS(suffix, T) \
+	size_t s2d_codegen_rect_intersects_##suffix(const Rect2<T>& r, const Rect2<T>* b, const size_t n) { \
+		return rectIntersects(r, b, n); \
+	}
+
+extern "C" {
+	S2D_CODEGEN_UNITS(S2D_CODEGEN_VEC_ARITHMETIC)
+	S2D_CODEGEN_UNITS(S2D_CODEGEN_VEC_DOT_CROSS)
+	S2D_CODEGEN_UNITS(S2D_CODEGEN_POINT_OFFSET)
+	S2D_CODEGEN_UNITS(S2D_CODEGEN_RECT_CONTAINS)
+	S2D_CODEGEN_UNITS(S2D_CODEGEN_RECT_INTERSECTS)
+
+	//a conversion must be the one multiply by the folded ratio
+	void s2d_codegen_pixels_to_meters_float(float* out, const float* in, const size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = in[i] * (1.0f / S2D_PIXEL_TO_METER);
+		}
+	}
+
+	void s2d_codegen_pixels_to_meters_units(Meters* out, const Pixels* in, const size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = in[i];
+		}
+	}
+
+	void s2d_codegen_degrees_to_radians_float(float* out, const float* in, const size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = in[i] * (float)(3.14159265358979323846L / 180.0L);
+		}
+	}
+
+	void s2d_codegen_degrees_to_radians_units(Radians* out, const Degrees* in, const size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = in[i];
+		}
+	}
+}
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <map>
 #include <functional>
+#include <random>
+#include <set>
 #include <cassert>
 #include "Space2D.h"
 #include "gtest/gtest.h"
@@ -578,6 +580,15 @@ TEST(RectTest, RectOps) {
 	ASSERT_FALSE(intr1.intersects(intr3));
 }
 
+TEST(RectTest, RectBounds) {
+	Rect2f r1(0, 0, 4, 2);
+	ASSERT_TRUE(r1.contains(Rect2f(1, 1, 2, 2)));
+	ASSERT_TRUE(r1.contains(r1));
+	ASSERT_FALSE(r1.contains(Rect2f(1, 1, 5, 2)));
+	ASSERT_EQ(r1.combine(Rect2f(-1, 1, 2, 3)), Rect2f(-1, 0, 4, 3));
+	ASSERT_EQ(r1.perimeter(), 12);
+}
+
 TEST(PolyTest, PolyConstructor) {
 	Poly2f p1;
 	std::vector<Point2f> vec1({ Point2f(), Point2f(0, 1), Point2f(1,1) });
@@ -717,6 +728,317 @@ TEST(PolyTest, PolyOps) {
 	}
 }
 
+TEST(PolyTest, PolyInlineStorage) {
+	InlineVec<int, 4> v1{ 1, 2, 3 };
+	ASSERT_EQ(v1.size(), 3);
+	ASSERT_FALSE(v1.onHeap());
+
+	v1.push_back(4);
+	ASSERT_FALSE(v1.onHeap());
+	v1.push_back(5);
+	ASSERT_TRUE(v1.onHeap());
+	ASSERT_EQ(v1, (InlineVec<int, 4>{ 1, 2, 3, 4, 5 }));
+
+	v1.resize(2);
+	ASSERT_FALSE(v1.onHeap());
+	ASSERT_EQ(v1, (InlineVec<int, 4>{ 1, 2 }));
+	v1.resize(3);
+	ASSERT_EQ(v1[2], 0);
+	ASSERT_THROW(v1.at(3), std::out_of_range);
+
+	//moving takes the heap storage and leaves the source empty and usable
+	InlineVec<int, 4> v2{ 1, 2, 3, 4, 5, 6 };
+	InlineVec<int, 4> v3(std::move(v2));
+	ASSERT_EQ(v3, (InlineVec<int, 4>{ 1, 2, 3, 4, 5, 6 }));
+	ASSERT_EQ(v2.size(), 0);
+	v2.push_back(7);
+	ASSERT_EQ(v2, (InlineVec<int, 4>{ 7 }));
+	v2 = std::move(v3);
+	ASSERT_EQ(v2.size(), 6);
+	ASSERT_EQ(v2[5], 6);
+	ASSERT_EQ(v3.size(), 0);
+	ASSERT_EQ(v3.begin(), v3.end());
+
+	//a 12-gon spills over the inline storage, and has to behave exactly like a small polygon
+	std::vector<Point2f> circle;
+	for (int i = 0; i < 12; i++) {
+		Radians ang = Radians((float)(2.0 * Pi * i / 12.0));
+		circle.push_back(Point2f(10.0f * s2d::cos(ang), 10.0f * s2d::sin(ang)));
+	}
+
+	Poly2f p1(circle);
+	ASSERT_EQ(p1.size(), 12);
+	ASSERT_EQ(p1[11], circle[11]);
+	ASSERT_EQ(p1.centroid(), Point2f(0, 0));
+
+	Poly2f p2 = p1 + Vec2f(1, 2);
+	ASSERT_EQ(p2[5], circle[5] + Vec2f(1, 2));
+
+	Mat3f m1;
+	m1.translate(Vec2f(1, 2));
+	ASSERT_EQ(m1.transform(p1), p2);
+	Poly2f moved(std::move(p2));
+	ASSERT_EQ(moved.size(), 12);
+	ASSERT_EQ(p2.size(), 0);
+
+	Poly2f p3(Rect2f(0, 0, 5, 4));
+	Poly2f p4 = p3;
+	p4 += Vec2f(1, 1);
+	ASSERT_EQ(p3, Poly2f(Rect2f(0, 0, 5, 4)));
+	ASSERT_EQ(p4, Poly2f(Rect2f(1, 1, 6, 5)));
+}
+
+TEST(PolyTest, PolyTrustedConvex) {
+	std::vector<Point2f> vec1({ Point2f(), Point2f(0, 1), Point2f(1, 1) });
+	Poly2f p1(trustedConvex, vec1);
+	Poly2f p2(trustedConvex, { Point2f(), Point2f(0, 1), Point2f(1, 1) });
+	Poly2f p3(trustedConvex, Poly2f::PointStorage{ Point2f(), Point2f(0, 1), Point2f(1, 1) });
+
+	ASSERT_EQ(p1, Poly2f(vec1));
+	ASSERT_EQ(p2, p1);
+	ASSERT_EQ(p3, p1);
+
+	//the trusted path really skips the check, the caller takes responsibility
+	ASSERT_NO_THROW(Poly2f(trustedConvex, { Point2f(0, 0), Point2f(0, 1), Point2f(1, 1), Point2f(0.3f, 0.7f) }));
+	ASSERT_THROW(Poly2f({ Point2f(0, 0), Point2f(0, 1), Point2f(1, 1), Point2f(0.3f, 0.7f) }), std::logic_error);
+
+	//derived polygons skip the check but are still correct
+	Poly2f p4 = p1 + Vec2f(2, 3);
+	ASSERT_EQ(p4, Poly2f(2, 3, 2, 4, 3, 4));
+	ASSERT_EQ(p4.area(), p1.area());
+
+	Mat3f m1;
+	m1.reflX();
+	Poly2f p5 = m1.transform(p1);
+	ASSERT_EQ(p5.area(), p1.area());
+}
+
+TEST(PolyTest, PolyCachedValues) {
+	Poly2f p1(Rect2f(0, 0, 4, 2));
+	ASSERT_EQ(p1.area(), 8);
+	ASSERT_EQ(p1.centroid(), Point2f(2, 1));
+	ASSERT_EQ(p1.getAABB(), Rect2f(0, 0, 4, 2));
+	ASSERT_EQ(p1.getFaceNormal(0), NormVec2f(1, 0));
+	ASSERT_EQ(p1.getFaceNormals().size(), 4);
+
+	//reads through the mutable accessors keep the cached values
+	Point2f read = p1[1];
+	read = p1.at(2);
+	for (auto& p : p1) {
+		read = p;
+	}
+	ASSERT_EQ(read, Point2f(4, 0));
+	ASSERT_EQ(p1.area(), 8);
+	ASSERT_EQ(p1.getAABB(), Rect2f(0, 0, 4, 2));
+
+	//real mutation through them is picked up
+	p1[2] = Point2f(4, 4);
+	p1[1] = Point2f(0, 4);
+	ASSERT_EQ(p1.area(), 16);
+	ASSERT_EQ(p1.centroid(), Point2f(2, 2));
+	ASSERT_EQ(p1.getAABB(), Rect2f(0, 0, 4, 4));
+	ASSERT_EQ(p1.getFaceVec(0), Vec2f(0, 4));
+
+	//even by less than epsilon
+	p1[2].x = 4.0000005f;
+	ASSERT_EQ(p1.getAABB().max.x, 4.0000005f);
+	p1[2].x = 4.0f;
+	ASSERT_EQ(p1.getAABB().max.x, 4.0f);
+
+	//translation moves the cached values along with the points
+	p1 += Vec2f(1, -1);
+	ASSERT_EQ(p1.getAABB(), Rect2f(1, -1, 5, 3));
+	ASSERT_EQ(p1.centroid(), Point2f(3, 1));
+	ASSERT_EQ(p1.area(), 16);
+	Poly2f p2 = p1 - NormVec2f(0, 1);
+	ASSERT_EQ(p2.getAABB(), Rect2f(1, -2, 5, 2));
+	ASSERT_EQ(p2.getFaceNormals(), p1.getFaceNormals());
+	p2.moveCenterTo(0, 0);
+	ASSERT_EQ(p2.getAABB(), Rect2f(-2, -2, 2, 2));
+
+	//a mutation that breaks convexity still throws on the next convexity sensitive query
+	p1[1] = Point2f(4, 1);
+	ASSERT_THROW(p1.area(), std::logic_error);
+	ASSERT_THROW(p1.centroid(), std::logic_error);
+
+	//and the pending check carries over to translated and transformed copies
+	Poly2f square(Rect2f(0, 0, 2, 2));
+	square[1] = Point2f(1.5f, 1);
+	Mat3f m1;
+	m1.rotate(30_deg);
+	Affine2f a1;
+	a1.translate(Vec2f(1, 1));
+	ASSERT_THROW((square + Vec2f(1, 1)).area(), std::logic_error);
+	ASSERT_THROW(m1.transform(square).area(), std::logic_error);
+	ASSERT_THROW(a1.transform(square).centroid(), std::logic_error);
+	square[1] = Point2f(0, 2);
+	ASSERT_EQ((square + Vec2f(1, 1)).area(), 4);
+}
+
+TEST(PolyTest, PolyContains) {
+	//Rect built Poly2's wind clockwise, the literal one below counter clockwise
+	Poly2f cw(Rect2f(0, 0, 4, 2));
+	Poly2f ccw{ { 0, 0 }, { 4, 0 }, { 6, 3 }, { 2, 5 }, { -1, 3 } };
+
+	ASSERT_TRUE(cw.contains(Point2f(2, 1)));
+	ASSERT_TRUE(cw.contains(Point2f(0.1f, 1.9f)));
+	ASSERT_FALSE(cw.contains(Point2f(5, 1)));
+	ASSERT_FALSE(cw.contains(Point2f(2, -1)));
+
+	ASSERT_TRUE(ccw.contains(Point2f(2, 2)));
+	ASSERT_TRUE(ccw.contains(Point2f(5, 3)));
+	ASSERT_TRUE(ccw.contains(Point2f(0, 3)));
+	ASSERT_FALSE(ccw.contains(Point2f(-1, 1)));
+	ASSERT_FALSE(ccw.contains(Point2f(6, 5)));
+
+	//like Rect2, faces and corners are not within
+	ASSERT_FALSE(cw.contains(Point2f(0, 0)));
+	ASSERT_FALSE(cw.contains(Point2f(2, 0)));
+	ASSERT_FALSE(cw.contains(Point2f(4, 1)));
+	ASSERT_FALSE(ccw.contains(Point2f(2, 5)));
+	ASSERT_FALSE(ccw.contains(Point2f(2, 0)));
+	ASSERT_FALSE(ccw.contains(Point2f(5, 1.5f)));
+	ASSERT_FALSE(ccw.contains(Point2f(-0.5f, 1.5f)));
+
+	//diagonals of the fan are within
+	ASSERT_TRUE(ccw.contains(Point2f(1, 2.5f)));
+	ASSERT_TRUE(ccw.contains(Point2f(3, 1.5f)));
+
+	Poly2<double> tri{ { 0, 0 }, { 0, 3 }, { 3, 0 } };
+	ASSERT_TRUE(tri.contains(Point2<double>(1, 1)));
+	ASSERT_FALSE(tri.contains(Point2<double>(1.5, 1.5)));
+
+	//repeated points leave zero length faces that are skipped
+	Poly2f dup{ { 0, 0 }, { 0, 0 }, { 4, 0 }, { 4, 4 }, { 4, 4 }, { 0, 4 }, { 0, 0 } };
+	ASSERT_TRUE(dup.contains(Point2f(1, 1)));
+	ASSERT_TRUE(dup.contains(Point2f(3, 2)));
+	ASSERT_FALSE(dup.contains(Point2f(5, 2)));
+	ASSERT_FALSE(dup.contains(Point2f(0, 2)));
+	Poly2f point{ { 1, 1 }, { 1, 1 }, { 1, 1 } };
+	ASSERT_FALSE(point.contains(Point2f(1, 1)));
+
+	//a mutation that breaks convexity throws like the other convexity sensitive queries
+	cw[1] = Point2f(3, 1);
+	ASSERT_THROW(cw.contains(Point2f(0.5f, 0.5f)), std::logic_error);
+}
+
+TEST(PolyTest, PolyContainsBatch) {
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<float> pos(-12.0f, 12.0f);
+
+	//odd point counts exercise the tails of the vector paths
+	std::vector<Point2f> points(1003);
+	for (auto& p : points) {
+		p = Point2f(pos(gen), pos(gen));
+	}
+	points[0] = Point2f(0, 10);
+	points[1] = Point2f(0, 0);
+
+	std::vector<std::uint8_t> out(points.size());
+	for (size_t sides : { 3, 4, 7, 16, 61, 97 }) {
+		for (bool clockwise : { false, true }) {
+			std::vector<Point2f> corners;
+			for (size_t i = 0; i < sides; i++) {
+				float angle = 2.0f * 3.14159265f * (float)i / (float)sides;
+				corners.push_back(Point2f(10.0f * std::cos(angle), (clockwise ? -10.0f : 10.0f) * std::sin(angle)));
+			}
+			Poly2f poly(corners);
+
+			size_t count = poly.contains(std::span<const Point2f>(points), std::span<std::uint8_t>(out));
+			size_t expected = 0;
+			for (size_t i = 0; i < points.size(); i++) {
+				//the two paths may round a point on the boundary either way, such as point 0 on a corner
+				float nearest = std::numeric_limits<float>::max();
+				for (size_t c = 0; c < sides; c++) {
+					const Point2f& a = corners[c];
+					const Point2f& b = corners[(c + 1) % sides];
+					const float t = std::clamp(((points[i].x - a.x) * (b.x - a.x) + (points[i].y - a.y) * (b.y - a.y)) /
+						((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y)), 0.0f, 1.0f);
+					nearest = std::min(nearest, std::hypot(points[i].x - a.x - t * (b.x - a.x), points[i].y - a.y - t * (b.y - a.y)));
+				}
+				if (nearest > 1e-4f) {
+					ASSERT_EQ(out[i] != 0, poly.contains(points[i])) << sides << " sides, point " << i;
+				}
+				expected += out[i];
+			}
+			ASSERT_EQ(count, expected);
+			ASSERT_GT(count, 0);
+			ASSERT_EQ(out[0], 0);
+			ASSERT_EQ(out[1], 1);
+		}
+	}
+
+	Poly2<double> dpoly(Rect2<double>(-5, -5, 5, 5));
+	std::vector<Point2<double>> dpoints{ Point2<double>(0, 0), Point2<double>(5, 0), Point2<double>(6, 6), Point2<double>(-4.5, 4.5) };
+	std::vector<std::uint8_t> dout(4);
+	ASSERT_EQ(dpoly.contains(std::span<const Point2<double>>(dpoints), std::span<std::uint8_t>(dout)), 2);
+	ASSERT_EQ(dout, std::vector<std::uint8_t>({ 1, 0, 0, 1 }));
+
+	ASSERT_THROW(dpoly.contains(std::span<const Point2<double>>(dpoints), std::span<std::uint8_t>(dout.data(), 3)), std::out_of_range);
+
+	//repeated points leave zero length faces, the batch skips them like contains(Point2)
+	Poly2f dup{ { 0, 0 }, { 0, 0 }, { 4, 0 }, { 4, 4 }, { 4, 4 }, { 0, 4 } };
+	std::vector<Point2f> dupPoints{ Point2f(1, 1), Point2f(3, 2), Point2f(5, 2), Point2f(2, 3.5f), Point2f(2, -1) };
+	std::vector<std::uint8_t> dupOut(dupPoints.size());
+	ASSERT_EQ(dup.contains(std::span<const Point2f>(dupPoints), std::span<std::uint8_t>(dupOut)), 3);
+	ASSERT_EQ(dupOut, std::vector<std::uint8_t>({ 1, 1, 0, 1, 0 }));
+}
+
+TEST(FixedPolyTest, FixedPolyConstructor) {
+	constexpr Tri2f t1(Point2f(0, 0), Point2f(0, 1), Point2f(1, 1));
+	Tri2f t2(std::array<Point2f, 3>{ Point2f(0, 0), Point2f(0, 1), Point2f(1, 1) });
+	Tri2f t3(Poly2f{ { 0, 0 }, { 0, 1 }, { 1, 1 } });
+
+	ASSERT_EQ(t1, t2);
+	ASSERT_EQ(t1, t3);
+	ASSERT_EQ(t1.toPoly2(), Poly2f(0, 0, 0, 1, 1, 1));
+	ASSERT_EQ((Poly2f)t1, Poly2f(0, 0, 0, 1, 1, 1));
+	ASSERT_EQ(t1.get<2>(), Point2f(1, 1));
+	ASSERT_THROW(t1.at(3), std::out_of_range);
+
+	ASSERT_THROW(Quad2f(Poly2f{ { 0, 0 }, { 0, 1 }, { 1, 1 } }), std::logic_error);
+	ASSERT_THROW(Quad2f(Point2f(0, 0), Point2f(0, 1), Point2f(1, 1), Point2f(0.3f, 0.7f)), std::logic_error);
+}
+
+TEST(FixedPolyTest, FixedPolyOps) {
+	//area, centroid and AABB are usable in constant expressions
+	constexpr Quad2f q1(Point2f(1, 2), Point2f(1, 7), Point2f(3, 7), Point2f(3, 2));
+	static_assert(q1.area() == 10.0f);
+	static_assert(q1.getAABB().max.x == 3.0f);
+	constexpr Point2f c1 = q1.centroid();
+	static_assert(c1.x == 2.0f && c1.y == 4.5f);
+
+	Poly2f p1(Rect2f(1, 2, 3, 7));
+	ASSERT_EQ(q1.area(), p1.area());
+	ASSERT_EQ(q1.centroid(), p1.centroid());
+	ASSERT_EQ(q1.getAABB(), Rect2f(1, 2, 3, 7));
+
+	Quad2f q2(Poly2f(Rect2f(0, 0, 5, 6)));
+	Poly2f p2(Rect2f(0, 0, 5, 6));
+	auto normals = q2.getFaceNormals();
+	for (size_t i = 0; i < 4; i++) {
+		ASSERT_EQ(q2.getFaceNormal(i), p2.getFaceNormal(i));
+		ASSERT_EQ(normals[i], p2.getFaceNormal(i));
+		ASSERT_EQ(q2.getFaceVec(i), p2.getFaceVec(i));
+	}
+
+	ASSERT_EQ(q2 + Vec2f(1, 1), Quad2f(Poly2f(Rect2f(1, 1, 6, 7))));
+	q2 -= Vec2f(1, 1);
+	ASSERT_EQ(q2, Quad2f(Poly2f(Rect2f(-1, -1, 4, 5))));
+
+	Mat3f m1;
+	m1.translate(Vec2f(5, 8));
+	m1.scale(2, 2);
+	m1.rotate(60_deg);
+	ASSERT_EQ(m1.transform(q2).toPoly2(), m1.transform(q2.toPoly2()));
+
+	Affine2f a1(m1);
+	ASSERT_EQ(a1.transform(q2), m1.transform(q2));
+
+	Tri2p t1(Point2p(0_px, 0_px), Point2p(0_px, 64_px), Point2p(64_px, 64_px));
+	ASSERT_EQ(t1.area(), 2048_px);
+}
+
 TEST(MatTest, MatConstructor) {
 
 	std::array<float, 9> a1({ 1, 0, 0, 0, 1, 0, 0, 0, 1 });
@@ -793,4 +1115,1728 @@ TEST(MatTest, MatTransformOps) {
 	//ASSERT_EQ(m3, m4);
 
 	ASSERT_GT(m2, m3);
-}
\ No newline at end of file
+}
+TEST(MatTest, MatBuilderOrder) {
+	Mat3f base(1, 0.5f, -2, 0.25f, 2, 7);
+	Point2f p1(3, 2);
+
+	Mat3f tr;
+	tr.getMatrix() = { 1, 0, 0, 0, 1, 0, 5, 8, 1 };
+
+	Mat3f m1 = base;
+	m1.pretranslate(Vec2f(5, 8));
+	ASSERT_EQ(m1.transform(p1), (tr * base).transform(p1));
+
+	Mat3f m2 = base;
+	m2.posttranslate(Vec2f(5, 8));
+	ASSERT_EQ(m2.transform(p1), (base * tr).transform(p1));
+
+	//translate keeps its original meaning of base.inverse() based translation
+	Mat3f m3 = base;
+	m3.translate(Vec2f(5, 8));
+	auto inv = base.inverse().transform(Vec2f(5, 8));
+	ASSERT_EQ(m3.transform(p1), (base * Mat3f(1, 0, inv.x, 0, 1, inv.y)).transform(p1));
+
+	Mat3f rot;
+	rot.rotate(30_deg);
+
+	Mat3f m4 = base;
+	m4.prerotate(30_deg);
+	ASSERT_EQ(m4.transform(p1), (rot * base).transform(p1));
+
+	Mat3f m5 = base;
+	m5.postrotate(30_deg);
+	ASSERT_EQ(m5.transform(p1), (base * rot).transform(p1));
+
+	Point2f bp = base.transform(p1);
+
+	Mat3f m6 = base;
+	m6.prescale(2, 3);
+	ASSERT_EQ(m6.transform(p1), Point2f(2 * bp.x, 3 * bp.y));
+
+	Mat3f m7 = base;
+	m7.postscale(2, 3);
+	ASSERT_EQ(m7.transform(p1), base.transform(Point2f(6, 6)));
+
+	Mat3f m8 = base;
+	m8.preshear(0.5f, 0.25f);
+	ASSERT_EQ(m8.transform(p1), Point2f(bp.x + 0.5f * bp.y, bp.y + 0.25f * bp.x));
+
+	Mat3f m9 = base;
+	m9.postshear(0.5f, 0.25f);
+	ASSERT_EQ(m9.transform(p1), base.transform(Point2f(4, 2.75f)));
+
+	//centered transformations leave the center fixed
+	Point2f c(4, -3);
+	Mat3f m10;
+	m10.rotate(45_deg, c);
+	ASSERT_EQ(m10.transform(c), c);
+	Mat3f m11;
+	m11.scale(2, 5, c);
+	ASSERT_EQ(m11.transform(c), c);
+	Mat3f m12;
+	m12.shear(0.5f, 0.5f, c);
+	ASSERT_EQ(m12.transform(c), c);
+}
+
+TEST(MatTest, MatUnitBuilders) {
+	Mat3f proj;
+	proj.orthProj(Vec2f(1, 0));
+	ASSERT_EQ(proj.transform(Point2f(3, 4)), Point2f(3, 0));
+	Mat3f refl;
+	refl.reflX();
+	ASSERT_EQ(refl.transform(Point2f(3, 4)), Point2f(3, -4));
+
+	//every builder works on the unit types too, and agrees with float
+	Point2p c(Pixels(4.0), Pixels(-3.0));
+	Mat3p mp;
+	mp.rotate(30_deg, c).scale(Pixels(2.0), Pixels(3.0), c).shear(Pixels(0.5), Pixels(0.25), c).reflX();
+	Mat3f mf;
+	mf.rotate(30_deg, Point2f(4, -3)).scale(2, 3, Point2f(4, -3)).shear(0.5f, 0.25f, Point2f(4, -3)).reflX();
+	Point2p tp = mp.transform(Point2p(Pixels(3.0), Pixels(2.0)));
+	ASSERT_EQ(Point2f((float)tp.x, (float)tp.y), mf.transform(Point2f(3, 2)));
+
+	Mat3m mm;
+	mm.orthProj(Vec2m(Meters(1.0), Meters(0.0)));
+	ASSERT_EQ(mm.transform(Point2m(Meters(3.0), Meters(4.0))), Point2m(Meters(3.0), Meters(0.0)));
+}
+
+TEST(PointBufferTest, PointBufferConstructor) {
+	PointBuffer2f b1;
+	PointBuffer2f b2(5);
+	PointBuffer2f b3{ Point2f(1, 2), Point2f(3, 4), Point2f(5, 6) };
+	PointBuffer2f b4(std::vector<Point2f>{ Point2f(1, 2), Point2f(3, 4), Point2f(5, 6) });
+
+	ASSERT_TRUE(b1.empty());
+	ASSERT_EQ(b2.size(), 5);
+	ASSERT_EQ(b2[4], Point2f());
+	ASSERT_EQ(b3, b4);
+	ASSERT_EQ(b3[1], Point2f(3, 4));
+
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(b3.xData()) % simdAlignment, 0);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(b3.yData()) % simdAlignment, 0);
+
+	b3.set(1, Point2f(-1, -2));
+	ASSERT_EQ(b3.toPoints(), std::vector<Point2f>({ Point2f(1, 2), Point2f(-1, -2), Point2f(5, 6) }));
+}
+
+TEST(PointBufferTest, PointBufferTransformBatch) {
+	Mat3f m1;
+	m1.translate(Vec2f(5, 8));
+	m1.scale(2, 3);
+	m1.rotate(60_deg);
+
+	//odd size so the SIMD tail is exercised
+	std::vector<Point2f> points;
+	for (size_t i = 0; i < 37; i++) {
+		points.push_back(Point2f((float)i * 0.5f - 4.0f, 3.0f - (float)i));
+	}
+
+	PointBuffer2f b1(points);
+	PointBuffer2f b2;
+	m1.transformBatch(b1, b2);
+	m1.transformBatch(b1);
+
+	//the compiler may fuse the scalar multiplies and adds where the SIMD path doesn't, within an ulp or two
+	ASSERT_EQ(b1, b2);
+	for (size_t i = 0; i < points.size(); i++) {
+		const Point2f expected = m1.transform(points[i]);
+		ASSERT_NEAR(b1[i].x, expected.x, 1e-6f * (1.0f + std::abs(expected.x))) << i;
+		ASSERT_NEAR(b1[i].y, expected.y, 1e-6f * (1.0f + std::abs(expected.y))) << i;
+	}
+
+	Mat3p m2;
+	m2.translate(Vec2p(64_px, 32_px));
+	PointBuffer2p b3{ Point2p(1_px, 2_px), Point2p(3_px, 4_px) };
+	m2.transformBatch(b3);
+	ASSERT_EQ(b3[0], Point2p(65_px, 34_px));
+	ASSERT_EQ(b3[1], Point2p(67_px, 36_px));
+}
+
+TEST(AffineTest, AffineConstructor) {
+	std::array<float, 6> a1({ 1, 0, 0, 0, 1, 0 });
+	std::array<float, 6> a2({ 1, 2, 3, 4, 5, 6 });
+
+	Affine2f t1;
+	ASSERT_EQ(t1.getMatrix(), a1);
+	Affine2f t2(1, 2, 3, 4, 5, 6);
+	ASSERT_EQ(t2.getMatrix(), a2);
+
+	Mat3f m1(1, 2, 3, 4, 5, 6);
+	ASSERT_EQ(Affine2f(m1), t2);
+	ASSERT_EQ(t2.toMat3(), m1);
+	ASSERT_EQ((Mat3f)t2, m1);
+}
+
+TEST(AffineTest, AffineTransformOps) {
+	Mat3f m1;
+	m1.translate(Vec2f(5, 8));
+	m1.scale(2, 3);
+	m1.rotate(60_deg);
+
+	Affine2f t1;
+	t1.translate(Vec2f(5, 8));
+	t1.scale(2, 3);
+	t1.rotate(60_deg);
+
+	Point2f p1(3, 2);
+	ASSERT_EQ(t1.transform(p1), m1.transform(p1));
+	ASSERT_EQ(t1.transform(Vec2f(3, 5)), m1.transform(Vec2f(3, 5)));
+	ASSERT_EQ(t1.transform(Dim2f(3, 5)), m1.transform(Dim2f(3, 5)));
+	ASSERT_EQ(t1.transform(NormVec2f(3, 5)), m1.transform(NormVec2f(3, 5)));
+
+	Poly2f pl1{ { 0, 0 }, { 0, 1 }, { 1, 1 } };
+	ASSERT_EQ(t1.transform(pl1), m1.transform(pl1));
+
+	Affine2f t2(1, 0.5f, -2, 0.25f, 2, 7);
+	Mat3f m2 = t2.toMat3();
+	ASSERT_EQ((t1 * t2).transform(p1), (m1 * m2).transform(p1));
+	ASSERT_EQ((t1 * t2).transform(p1), t1.transform(t2.transform(p1)));
+
+	Affine2f t3 = t1.inverse();
+	ASSERT_EQ(t3.transform(t1.transform(p1)), p1);
+	ASSERT_EQ(t1.inverse().transform(p1), m1.inverse().transform(p1));
+
+	ASSERT_EQ(Affine2f(0, 0, 1, 0, 0, 1).inverse(), Affine2f());
+
+	Affine2p t4;
+	t4.translate(Vec2p(64_px, 32_px));
+	ASSERT_EQ(t4.transform(Point2p(1_px, 2_px)), Point2p(65_px, 34_px));
+	ASSERT_EQ(t4.inverse().transform(Point2p(65_px, 34_px)), Point2p(1_px, 2_px));
+
+	//rotating, scaling and shearing in Pixels around a center match Mat3
+	Affine2p t5;
+	t5.rotate(90_deg, Point2p(10_px, 10_px));
+	t5.scale(2_px, 3_px, Point2p(1_px, 1_px));
+	t5.shear(0.5_px, 0_px);
+	Mat3p m5;
+	m5.rotate(90_deg, Point2p(10_px, 10_px));
+	m5.scale(2_px, 3_px, Point2p(1_px, 1_px));
+	m5.shear(0.5_px, 0_px);
+	ASSERT_EQ(t5.transform(Point2p(4_px, 6_px)), m5.transform(Point2p(4_px, 6_px)));
+	Affine2p t6;
+	t6.rotate(90_deg, Point2p(10_px, 10_px));
+	ASSERT_EQ(t6.transform(Point2p(12_px, 10_px)), Point2p(10_px, 12_px));
+	Affine2p t7;
+	t7.scale(2_px, 3_px, Point2p(1_px, 1_px));
+	ASSERT_EQ(t7.transform(Point2p(2_px, 2_px)), Point2p(3_px, 4_px));
+}
+
+TEST(CollisionTest, CollidePoly) {
+	Poly2f a(Rect2f(0, 0, 2, 2));
+	Poly2f b(Rect2f(1.5f, 0.5f, 3.5f, 2.5f));
+
+	auto m1 = collide(a, b);
+	ASSERT_TRUE(m1);
+	ASSERT_FLOAT_EQ(m1.depth, 0.5f);
+	ASSERT_EQ(m1.normal, NormVec2f(1, 0));
+	ASSERT_EQ(m1.contactCount, 2);
+	ASSERT_FLOAT_EQ(m1.contacts[0].x, 1.5f);
+	ASSERT_FLOAT_EQ(m1.contacts[1].x, 1.5f);
+	ASSERT_FLOAT_EQ(std::min(m1.contacts[0].y, m1.contacts[1].y), 0.5f);
+	ASSERT_FLOAT_EQ(std::max(m1.contacts[0].y, m1.contacts[1].y), 2.0f);
+
+	//swapping the shapes flips the normal
+	auto m2 = collide(b, a);
+	ASSERT_TRUE(m2);
+	ASSERT_FLOAT_EQ(m2.depth, 0.5f);
+	ASSERT_EQ(m2.normal, NormVec2f(-1, 0));
+
+	//separated on one axis
+	ASSERT_FALSE(collide(a, b + Vec2f(1, 0)));
+	ASSERT_FALSE(overlaps(a, b + Vec2f(1, 0)));
+	ASSERT_TRUE(overlaps(a, b));
+
+	//counter clockwise triangle against a clockwise rectangle
+	Poly2f tri(0, 0, 2, 0, 1, 1);
+	Poly2f box(Rect2f(0.5f, 0.75f, 1.5f, 2));
+	auto m3 = collide(tri, box);
+	ASSERT_TRUE(m3);
+	ASSERT_FLOAT_EQ(m3.depth, 0.25f);
+	ASSERT_EQ(m3.normal, NormVec2f(0, 1));
+	ASSERT_EQ(m3.contactCount, 1);
+	ASSERT_EQ(m3.contacts[0], Point2f(1, 1));
+
+	ASSERT_FALSE(collide(tri, box + Vec2f(0, 0.5f)));
+
+	//corner on corner, the incident face clips down to a single point
+	Poly2f square(Rect2f(0, 0, 4, 4));
+	Poly2f corner(Rect2f(4, 4, 8, 8));
+	auto m4 = collide(square, corner);
+	ASSERT_TRUE(m4);
+	ASSERT_EQ(m4.contactCount, 1);
+	ASSERT_EQ(m4.contacts[0], Point2f(4, 4));
+
+	//an empty Poly2 collides with nothing
+	Poly2f empty(std::move(corner));
+	ASSERT_EQ(corner.size(), 0);
+	ASSERT_FALSE(collide(square, corner));
+	ASSERT_FALSE(collide(corner, square));
+	ASSERT_FALSE(overlaps(square, corner));
+	ASSERT_FALSE(collide(corner, Rect2f(0, 0, 4, 4)));
+	ASSERT_FALSE(overlaps(corner, Rect2f(0, 0, 4, 4)));
+}
+
+TEST(CollisionTest, CollideRect) {
+	Poly2f tri(0, 0, 2, 0, 1, 1);
+	Rect2f r1(0.5f, 0.75f, 1.5f, 2);
+
+	auto m1 = collide(tri, r1);
+	ASSERT_TRUE(m1);
+	ASSERT_FLOAT_EQ(m1.depth, 0.25f);
+	ASSERT_EQ(m1.normal, NormVec2f(0, 1));
+
+	auto m2 = collide(r1, tri);
+	ASSERT_TRUE(m2);
+	ASSERT_FLOAT_EQ(m2.depth, 0.25f);
+	ASSERT_EQ(m2.normal, NormVec2f(0, -1));
+
+	ASSERT_TRUE(overlaps(r1, tri));
+	ASSERT_FALSE(overlaps(tri, Rect2f(3, 0, 4, 1)));
+	ASSERT_FALSE(collide(Rect2f(3, 0, 4, 1), tri));
+
+	//agrees with the Poly2 version
+	auto m3 = collide(tri, Poly2f(r1));
+	ASSERT_EQ(m3.depth, m1.depth);
+	ASSERT_EQ(m3.contactCount, m1.contactCount);
+}
+
+TEST(GjkTest, GjkDistance) {
+	Poly2f a(Rect2f(0, 0, 1, 1));
+	Poly2f b(Rect2f(3, 0.5f, 4, 1.5f));
+
+	auto d1 = gjkDistance(a, b);
+	ASSERT_FALSE(d1.overlapping);
+	ASSERT_FLOAT_EQ(d1.distance, 2.0f);
+	ASSERT_FLOAT_EQ(d1.pointA.x, 1.0f);
+	ASSERT_FLOAT_EQ(d1.pointB.x, 3.0f);
+	ASSERT_FALSE(gjkIntersects(a, b));
+
+	auto d2 = gjkDistance(a, b - Vec2f(2.5f, 0));
+	ASSERT_TRUE(d2.overlapping);
+	ASSERT_EQ(d2.distance, 0.0f);
+	ASSERT_TRUE(gjkIntersects(a, b - Vec2f(2.5f, 0)));
+
+	//corner to corner
+	Poly2f tri(3, 3, 5, 3, 4, 5);
+	auto d3 = gjkDistance(a, tri);
+	ASSERT_FLOAT_EQ(d3.distance, std::sqrt(8.0f));
+	ASSERT_EQ(d3.pointA, Point2f(1, 1));
+	ASSERT_EQ(d3.pointB, Point2f(3, 3));
+
+	//a finely tessellated circle against a square
+	Poly2f::PointStorage circle(256);
+	for (size_t i = 0; i < circle.size(); i++) {
+		float angle = 6.2831853f * (float)i / (float)circle.size();
+		circle[i] = Point2f(10 * std::cos(angle), 10 * std::sin(angle));
+	}
+	Poly2f c1(circle);
+	auto d4 = gjkDistance(c1, Poly2f(Rect2f(12, -1, 14, 1)));
+	ASSERT_NEAR(d4.distance, 2.0f, 1e-4f);
+
+	//the cache warm starts the next query
+	SimplexCache2<float> cache;
+	auto d5 = gjkDistance(c1, Poly2f(Rect2f(12, -1, 14, 1)), cache);
+	ASSERT_NE(cache.count, 0);
+	auto d6 = gjkDistance(c1, Poly2f(Rect2f(12.1f, -0.9f, 14.1f, 1.1f)), cache);
+	ASSERT_NEAR(d6.distance, 2.1f, 1e-4f);
+	ASSERT_LE(d6.iterations, d5.iterations);
+
+	//works with the linear types
+	Poly2p p1(Rect2p(0_px, 0_px, 64_px, 64_px));
+	Poly2p p2(Rect2p(96_px, 0_px, 128_px, 64_px));
+	ASSERT_EQ(gjkDistance(p1, p2).distance, 32_px);
+
+	//the support climb walks across repeated and collinear vertices instead of stopping on them
+	Poly2f plateau{ { 0, 0 }, { 0, 0 }, { 2, 0 }, { 4, 0 }, { 4, 4 }, { 0, 4 } };
+	auto shape = detail::makeGjkShape(plateau);
+	ASSERT_EQ(shape.support(1, 0, 0), 3);
+	ASSERT_EQ(shape.support(1, 0, 1), 3);
+	ASSERT_EQ(shape.support(1, -1, 0), 3);
+	ASSERT_EQ(plateau.getPoints()[shape.support(0, -1, 4)].y, 0.0f);
+	ASSERT_EQ(shape.support(-1, 1, 3), 5);
+	ASSERT_FLOAT_EQ(gjkDistance(plateau, Poly2f(Rect2f(6, 1, 7, 2))).distance, 2.0f);
+}
+
+TEST(GjkTest, EpaPenetration) {
+	Poly2f a(Rect2f(0, 0, 2, 2));
+	Poly2f b(Rect2f(1.5f, 0.5f, 3.5f, 2.5f));
+
+	auto m1 = epaPenetration(a, b);
+	ASSERT_TRUE(m1);
+	ASSERT_NEAR(m1.depth, 0.5f, 1e-5f);
+	ASSERT_NEAR(m1.normal.x, 1.0f, 1e-5f);
+	ASSERT_NEAR(m1.normal.y, 0.0f, 1e-5f);
+	ASSERT_EQ(m1.contactCount, 1);
+
+	//agrees with SAT
+	auto m2 = collide(a, b);
+	ASSERT_NEAR(m1.depth, m2.depth, 1e-5f);
+
+	auto m3 = epaPenetration(b, a);
+	ASSERT_NEAR(m3.normal.x, -1.0f, 1e-5f);
+
+	//identical shapes on top of each other, GJK can finish on a diagonal through the origin
+	auto m4 = epaPenetration(a, a);
+	ASSERT_TRUE(m4);
+	ASSERT_NEAR(m4.depth, 2.0f, 1e-5f);
+
+	ASSERT_FALSE(epaPenetration(a, b + Vec2f(1, 0)));
+
+	//warm started across frames while the shapes keep moving
+	SimplexCache2<float> cache;
+	for (int i = 0; i < 8; i++) {
+		Poly2f moved = b - Vec2f(0.1f * i, 0.05f * i);
+		auto warm = epaPenetration(a, moved, cache);
+		auto sat = collide(a, moved);
+		ASSERT_TRUE(warm);
+		ASSERT_NEAR(warm.depth, sat.depth, 1e-4f);
+	}
+
+	Poly2m p1(Rect2m(0_mtr, 0_mtr, 2_mtr, 2_mtr));
+	Poly2m p2(Rect2m(1_mtr, 1.5_mtr, 3_mtr, 3_mtr));
+	auto m5 = epaPenetration(p1, p2);
+	ASSERT_TRUE(m5);
+	ASSERT_NEAR((float)m5.depth, 0.5f, 1e-5f);
+}
+
+TEST(AABBTreeTest, AABBTreeProxies) {
+	AABBTree2f tree(0.5f);
+	ASSERT_TRUE(tree.empty());
+	ASSERT_EQ(tree.height(), -1);
+
+	auto p1 = tree.createProxy(Rect2f(0, 0, 1, 1), 10);
+	auto p2 = tree.createProxy(Rect2f(5, 5, 6, 6), 20);
+	auto p3 = tree.createProxy(Rect2f(0.5f, 0.5f, 2, 2), 30);
+	ASSERT_EQ(tree.size(), 3);
+	ASSERT_TRUE(tree.validate());
+	ASSERT_EQ(tree.getFatAABB(p1), Rect2f(-0.5f, -0.5f, 1.5f, 1.5f));
+	ASSERT_EQ(tree.getData(p2), 20);
+
+	std::vector<size_t> found;
+	tree.query(Rect2f(1.8f, 1.8f, 3, 3), [&](auto id) { found.push_back(tree.getData(id)); });
+	ASSERT_EQ(found, std::vector<size_t>({ 30 }));
+
+	//moving within the margin leaves the tree alone
+	ASSERT_FALSE(tree.moveProxy(p1, Rect2f(0.25f, 0.25f, 1.25f, 1.25f)));
+	ASSERT_EQ(tree.getFatAABB(p1), Rect2f(-0.5f, -0.5f, 1.5f, 1.5f));
+	ASSERT_TRUE(tree.moveProxy(p1, Rect2f(10, 0, 11, 1), Vec2f(1, 0)));
+	ASSERT_EQ(tree.getFatAABB(p1), Rect2f(9.5f, -0.5f, 15.5f, 1.5f));
+	ASSERT_TRUE(tree.validate());
+
+	tree.destroyProxy(p2);
+	ASSERT_EQ(tree.size(), 2);
+	ASSERT_TRUE(tree.validate());
+	ASSERT_THROW(tree.destroyProxy(p2), std::out_of_range);
+
+	found.clear();
+	tree.query(Rect2f(-100, -100, 100, 100), [&](auto id) { found.push_back(tree.getData(id)); return false; });
+	ASSERT_EQ(found.size(), 1);
+
+	tree.destroyProxy(p1);
+	tree.destroyProxy(p3);
+	ASSERT_TRUE(tree.empty());
+	ASSERT_TRUE(tree.validate());
+}
+
+TEST(AABBTreeTest, AABBTreeQueries) {
+	std::mt19937 gen(7);
+	std::uniform_real_distribution<float> pos(0.0f, 100.0f);
+	std::uniform_real_distribution<float> ext(0.5f, 3.0f);
+
+	AABBTree2f tree(0.0f);
+	std::vector<Rect2f> boxes;
+	std::vector<AABBTree2f::NodeId> ids;
+	for (size_t i = 0; i < 500; i++) {
+		float x = pos(gen);
+		float y = pos(gen);
+		boxes.push_back(Rect2f(x, y, x + ext(gen), y + ext(gen)));
+		ids.push_back(tree.createProxy(boxes.back(), i));
+	}
+	ASSERT_TRUE(tree.validate());
+	ASSERT_LE(tree.height(), 20);
+
+	//overlap pairs agree with brute force
+	std::set<std::pair<size_t, size_t>> expected;
+	for (size_t i = 0; i < boxes.size(); i++) {
+		for (size_t j = i + 1; j < boxes.size(); j++) {
+			if (boxes[i].intersects(boxes[j])) expected.insert({ i, j });
+		}
+	}
+	std::set<std::pair<size_t, size_t>> pairs;
+	tree.queryPairs([&](auto a, auto b) {
+		size_t da = tree.getData(a);
+		size_t db = tree.getData(b);
+		pairs.insert({ std::min(da, db), std::max(da, db) });
+	});
+	ASSERT_EQ(pairs, expected);
+
+	//ray along y = 50 from the left
+	std::set<size_t> hits;
+	tree.rayQuery(Point2f(-10, 50), Vec2f(1, 0), 200.0f, [&](auto id) { hits.insert(tree.getData(id)); });
+	std::set<size_t> expectedHits;
+	for (size_t i = 0; i < boxes.size(); i++) {
+		if (boxes[i].min.y <= 50 && boxes[i].max.y >= 50) expectedHits.insert(i);
+	}
+	ASSERT_EQ(hits, expectedHits);
+
+	//removing half keeps the structure valid
+	for (size_t i = 0; i < ids.size(); i += 2) {
+		tree.destroyProxy(ids[i]);
+	}
+	ASSERT_EQ(tree.size(), 250);
+	ASSERT_TRUE(tree.validate());
+}
+
+TEST(SpatialHashTest, SpatialHashQueries) {
+	std::mt19937 gen(11);
+	std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> ext(0.0f, 6.0f);
+
+	SpatialHash2f hash(4.0f);
+	ASSERT_THROW(SpatialHash2f(0.0f), std::logic_error);
+
+	std::vector<Rect2f> boxes;
+	std::vector<SpatialHash2f::ItemId> ids;
+	for (size_t i = 0; i < 400; i++) {
+		float x = pos(gen);
+		float y = pos(gen);
+		boxes.push_back(Rect2f(x, y, x + ext(gen), y + ext(gen)));
+		ids.push_back(hash.insert(boxes.back(), i));
+	}
+	ASSERT_EQ(hash.size(), 400);
+
+	auto check = [&](const std::vector<bool>& alive) {
+		for (size_t q = 0; q < 20; q++) {
+			float x = pos(gen);
+			float y = pos(gen);
+			Rect2f region(x, y, x + 15.0f, y + 10.0f);
+
+			//every item is reported once, even when it covers several cells
+			std::vector<size_t> found;
+			hash.query(region, [&](auto id) { found.push_back(hash.getData(id)); });
+			std::sort(found.begin(), found.end());
+			ASSERT_TRUE(std::adjacent_find(found.begin(), found.end()) == found.end());
+
+			std::vector<size_t> expected;
+			for (size_t i = 0; i < boxes.size(); i++) {
+				if (alive[i] && boxes[i].intersects(region)) expected.push_back(i);
+			}
+			ASSERT_EQ(found, expected);
+
+			std::set<size_t> inRadius;
+			hash.queryRadius(Point2f(x, y), 8.0f, [&](auto id) { inRadius.insert(hash.getData(id)); });
+			std::set<size_t> expectedRadius;
+			for (size_t i = 0; i < boxes.size(); i++) {
+				float dx = std::max({ boxes[i].min.x - x, 0.0f, x - boxes[i].max.x });
+				float dy = std::max({ boxes[i].min.y - y, 0.0f, y - boxes[i].max.y });
+				if (alive[i] && dx * dx + dy * dy <= 64.0f) expectedRadius.insert(i);
+			}
+			ASSERT_EQ(inRadius, expectedRadius);
+		}
+	};
+
+	std::vector<bool> alive(boxes.size(), true);
+	check(alive);
+
+	//point queries include faces
+	std::set<size_t> atPoint;
+	hash.queryPoint(boxes[0].min, [&](auto id) { atPoint.insert(hash.getData(id)); });
+	ASSERT_TRUE(atPoint.count(0));
+
+	//moving and removing items
+	for (size_t i = 0; i < boxes.size(); i += 3) {
+		boxes[i] = Rect2f(boxes[i].min.x + 7.0f, boxes[i].min.y - 3.0f, boxes[i].max.x + 7.0f, boxes[i].max.y - 3.0f);
+		hash.update(ids[i], boxes[i]);
+	}
+	for (size_t i = 1; i < boxes.size(); i += 3) {
+		hash.remove(ids[i]);
+		alive[i] = false;
+	}
+	ASSERT_THROW(hash.remove(ids[1]), std::out_of_range);
+	check(alive);
+
+	//stopping early
+	size_t visits = 0;
+	hash.query(Rect2f(-60, -60, 60, 60), [&](auto) { visits++; return visits < 5; });
+	ASSERT_EQ(visits, 5);
+
+	//clearing then rebuilding every frame
+	for (size_t frame = 0; frame < 3; frame++) {
+		hash.clear();
+		ASSERT_TRUE(hash.empty());
+		size_t hits = 0;
+		hash.query(Rect2f(-60, -60, 60, 60), [&](auto) { hits++; });
+		ASSERT_EQ(hits, 0);
+
+		for (size_t i = 0; i < boxes.size(); i++) {
+			ids[i] = hash.insert(boxes[i], i);
+			alive[i] = true;
+		}
+		check(alive);
+	}
+}
+
+TEST(SpatialHashTest, SpatialHashHugeBounds) {
+	SpatialHash2f hash(1.0f);
+	auto found = [&](const Rect2f& region) {
+		std::set<size_t> out;
+		hash.query(region, [&](auto id) { out.insert(hash.getData(id)); });
+		return out;
+	};
+
+	//items covering more than S2D_HASH_MAX_ITEM_CELLS cells, or beyond the int32_t cells, go in the oversized list
+	auto small = hash.insert(Rect2f(0.5f, 0.5f, 1.5f, 1.5f), 0);
+	auto world = hash.insert(Rect2f(-1e30f, -1e30f, 1e30f, 1e30f), 1);
+	auto wide = hash.insert(Rect2f(-1000, 3, 1000, 4), 2);
+	auto far = hash.insert(Point2f(3e9f, -3e9f), 3);
+	ASSERT_EQ(found(Rect2f(1, 1, 2, 2)), std::set<size_t>({ 0, 1 }));
+	ASSERT_EQ(found(Rect2f(500, 3.5f, 501, 3.5f)), std::set<size_t>({ 1, 2 }));
+	ASSERT_EQ(found(Rect2f(3e9f, -3e9f, 3e9f, -3e9f)), std::set<size_t>({ 1, 3 }));
+
+	//a query region of billions of cells scans the items instead
+	ASSERT_EQ(found(Rect2f(-1e20f, -1e20f, 1e20f, 1e20f)), std::set<size_t>({ 0, 1, 2, 3 }));
+	size_t inRadius = 0;
+	hash.queryRadius(Point2f(0, 0), 1e10f, [&](auto) { inRadius++; });
+	ASSERT_EQ(inRadius, 4);
+
+	//moving between the table and the list, and removing from the middle of the list
+	hash.update(wide, Rect2f(10, 10, 11, 11));
+	hash.update(small, Rect2f(-5000, 0, 5000, 1));
+	hash.remove(world);
+	ASSERT_EQ(found(Rect2f(10.5f, 10.5f, 10.5f, 10.5f)), std::set<size_t>({ 2 }));
+	ASSERT_EQ(found(Rect2f(-4000, 0.5f, -4000, 0.5f)), std::set<size_t>({ 0 }));
+	hash.remove(small);
+	ASSERT_EQ(found(Rect2f(-4000, 0.5f, -4000, 0.5f)), std::set<size_t>());
+	ASSERT_EQ(found(Rect2f(-1e20f, -1e20f, 1e20f, 1e20f)), std::set<size_t>({ 2, 3 }));
+	hash.remove(far);
+	hash.clear();
+	ASSERT_EQ(found(Rect2f(-1e20f, -1e20f, 1e20f, 1e20f)), std::set<size_t>());
+}
+
+TEST(LooseQuadtreeTest, LooseQuadtreeQueries) {
+	std::mt19937 gen(13);
+	std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> ext(0.1f, 4.0f);
+
+	std::vector<Rect2f> boxes;
+	for (size_t i = 0; i < 2000; i++) {
+		float x = pos(gen);
+		float y = pos(gen);
+		boxes.push_back(Rect2f(x, y, x + ext(gen), y + ext(gen)));
+	}
+	//a few large items that cross every split line
+	boxes.push_back(Rect2f(-90, -5, 90, 5));
+	boxes.push_back(Rect2f(-1, -1, 1, 1));
+
+	LooseQuadtree2f tree;
+	LooseQuadtree2f::ItemId buffer[4096];
+	ASSERT_EQ(tree.query(Rect2f(-10, -10, 10, 10), buffer), 0);
+	ASSERT_EQ(tree.nearest(Point2f(0, 0)), LooseQuadtree2f::nullItem);
+
+	tree.build(boxes);
+	ASSERT_EQ(tree.size(), boxes.size());
+	ASSERT_GT(tree.nodeCount(), 1);
+	ASSERT_EQ(tree.getBounds(7), boxes[7]);
+
+	for (size_t q = 0; q < 50; q++) {
+		float x = pos(gen);
+		float y = pos(gen);
+		Rect2f region(x, y, x + 20.0f, y + 12.0f);
+
+		size_t count = tree.query(region, buffer);
+		std::vector<LooseQuadtree2f::ItemId> found(buffer, buffer + count);
+		std::sort(found.begin(), found.end());
+		std::vector<LooseQuadtree2f::ItemId> expected;
+		for (size_t i = 0; i < boxes.size(); i++) {
+			if (boxes[i].intersects(region)) expected.push_back((LooseQuadtree2f::ItemId)i);
+		}
+		ASSERT_EQ(found, expected);
+
+		//a short buffer still reports the full count
+		ASSERT_EQ(tree.query(region, std::span(buffer, 1)), expected.size());
+
+		Point2f p(x, y);
+		count = tree.queryPoint(p, buffer);
+		found.assign(buffer, buffer + count);
+		std::sort(found.begin(), found.end());
+		expected.clear();
+		for (size_t i = 0; i < boxes.size(); i++) {
+			if (boxes[i].contains(p)) expected.push_back((LooseQuadtree2f::ItemId)i);
+		}
+		ASSERT_EQ(found, expected);
+
+		auto distSq = [&](const Rect2f& b) {
+			float dx = std::max({ b.min.x - x, 0.0f, x - b.max.x });
+			float dy = std::max({ b.min.y - y, 0.0f, y - b.max.y });
+			return dx * dx + dy * dy;
+		};
+		float best = distSq(boxes[0]);
+		for (const auto& b : boxes) {
+			best = std::min(best, distSq(b));
+		}
+		ASSERT_FLOAT_EQ(distSq(boxes[tree.nearest(p)]), best);
+	}
+
+	//an exact distance, here to the center of each item
+	Point2f p(30, 40);
+	auto centerDistSq = [&](LooseQuadtree2f::ItemId id, float) {
+		Point2f c = boxes[id].center();
+		return (c.x - p.x) * (c.x - p.x) + (c.y - p.y) * (c.y - p.y);
+	};
+	LooseQuadtree2f::ItemId nearestCenter = 0;
+	for (LooseQuadtree2f::ItemId i = 0; i < boxes.size(); i++) {
+		if (centerDistSq(i, 0.0f) < centerDistSq(nearestCenter, 0.0f)) nearestCenter = i;
+	}
+	ASSERT_EQ(tree.nearest(p, centerDistSq), nearestCenter);
+
+	//polygons are stored by their bounds
+	std::vector<Poly2f> polys = { Poly2f(Rect2f(0, 0, 2, 2)), Poly2f(Rect2f(5, 5, 8, 6)) };
+	tree.build(polys);
+	ASSERT_EQ(tree.queryPoint(Point2f(6, 5.5f), buffer), 1);
+	ASSERT_EQ(buffer[0], 1);
+}
+
+TEST(SweepAndPruneTest, SweepAndPrunePairs) {
+	using Sap = SweepAndPrune2f;
+	std::mt19937 gen(17);
+	std::uniform_real_distribution<float> pos(0.0f, 60.0f);
+	std::uniform_real_distribution<float> ext(0.5f, 4.0f);
+	std::uniform_real_distribution<float> step(-1.0f, 1.0f);
+
+	for (auto axes : { Sap::Axes::XY, Sap::Axes::X }) {
+		Sap sap(axes);
+		std::vector<Rect2f> boxes;
+		std::vector<Sap::ProxyId> ids;
+		std::vector<bool> alive;
+		for (size_t i = 0; i < 300; i++) {
+			float x = pos(gen);
+			float y = pos(gen);
+			boxes.push_back(Rect2f(x, y, x + ext(gen), y + ext(gen)));
+			ids.push_back(sap.createProxy(boxes.back(), i));
+			alive.push_back(true);
+		}
+
+		//the pairs seen through the events, which must always match the pair set
+		std::set<std::pair<size_t, size_t>> mirror;
+		auto onAdd = [&](auto a, auto b) {
+			auto pair = std::minmax(sap.getData(a), sap.getData(b));
+			ASSERT_TRUE(mirror.insert(pair).second);
+		};
+		auto onRemove = [&](auto a, auto b) {
+			ASSERT_TRUE(mirror.erase(std::minmax(sap.getData(a), sap.getData(b))));
+		};
+
+		auto expected = [&]() {
+			std::set<std::pair<size_t, size_t>> result;
+			for (size_t i = 0; i < boxes.size(); i++) {
+				for (size_t j = i + 1; j < boxes.size(); j++) {
+					if (!alive[i] || !alive[j]) continue;
+					bool overlap = axes == Sap::Axes::XY ? boxes[i].intersects(boxes[j]) :
+						!(boxes[i].max.x < boxes[j].min.x || boxes[j].max.x < boxes[i].min.x);
+					if (overlap) result.insert({ i, j });
+				}
+			}
+			return result;
+		};
+		auto current = [&]() {
+			std::set<std::pair<size_t, size_t>> result;
+			sap.queryPairs([&](auto a, auto b) { result.insert(std::minmax(sap.getData(a), sap.getData(b))); });
+			return result;
+		};
+
+		sap.update(onAdd, onRemove);
+		ASSERT_EQ(current(), expected());
+		ASSERT_EQ(mirror, expected());
+
+		for (size_t frame = 0; frame < 20; frame++) {
+			for (size_t i = 0; i < boxes.size(); i++) {
+				if (!alive[i]) continue;
+				Vec2f v(step(gen), step(gen));
+				boxes[i] += v;
+				sap.moveProxy(ids[i], boxes[i]);
+			}
+			sap.update(onAdd, onRemove);
+			ASSERT_EQ(current(), expected());
+			ASSERT_EQ(mirror, expected());
+		}
+
+		//destroyed proxies report their pairs as removed
+		mirror = current();
+		std::set<std::pair<size_t, size_t>> removed;
+		for (size_t i = 0; i < boxes.size(); i += 4) {
+			sap.destroyProxy(ids[i]);
+			alive[i] = false;
+		}
+		ASSERT_THROW(sap.destroyProxy(ids[0]), std::out_of_range);
+		sap.update([](auto, auto) {}, [&](auto a, auto b) { removed.insert({ std::min(a, b), std::max(a, b) }); });
+		ASSERT_EQ(sap.size(), 225);
+		ASSERT_EQ(current(), expected());
+		for (const auto& pair : removed) {
+			ASSERT_TRUE(!alive[pair.first] || !alive[pair.second]);
+		}
+
+		//a few new proxies are sorted in incrementally
+		for (size_t i = 0; i < 5; i++) {
+			float x = pos(gen);
+			float y = pos(gen);
+			boxes.push_back(Rect2f(x, y, x + 20.0f, y + 20.0f));
+			ids.push_back(sap.createProxy(boxes.back(), boxes.size() - 1));
+			alive.push_back(true);
+		}
+		sap.update();
+		ASSERT_EQ(current(), expected());
+
+		//a full rebuild agrees with the incremental result
+		auto incremental = current();
+		sap.rebuild();
+		ASSERT_EQ(current(), incremental);
+	}
+}
+
+TEST(HilbertRTreeTest, HilbertRTreeQueries) {
+	std::mt19937 gen(19);
+	std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+	std::uniform_real_distribution<float> ext(0.5f, 5.0f);
+
+	std::vector<Poly2f> polys;
+	std::vector<Rect2f> boxes;
+	for (size_t i = 0; i < 3000; i++) {
+		float x = pos(gen);
+		float y = pos(gen);
+		float w = ext(gen);
+		float h = ext(gen);
+		polys.push_back(Poly2f({ Point2f(x, y), Point2f(x + w, y), Point2f(x, y + h) }));
+		boxes.push_back(polys.back().getAABB());
+	}
+
+	PackedHilbertRTree2f empty;
+	size_t none = 0;
+	empty.query(Rect2f(-10, -10, 10, 10), [&](auto) { none++; });
+	ASSERT_EQ(none, 0);
+	ASSERT_THROW(PackedHilbertRTree2f(boxes, 1), std::logic_error);
+
+	PackedHilbertRTree2f tree(polys, 8);
+	ASSERT_EQ(tree.size(), polys.size());
+	ASSERT_EQ(tree.getNodeSize(), 8);
+
+	auto check = [&](const PackedHilbertRTree2f& t) {
+		std::uniform_real_distribution<float> dir(-1.0f, 1.0f);
+		for (size_t q = 0; q < 30; q++) {
+			float x = pos(gen);
+			float y = pos(gen);
+			Rect2f region(x, y, x + 30.0f, y + 15.0f);
+
+			std::vector<uint32_t> found;
+			t.query(region, [&](auto id) { found.push_back(id); });
+			std::sort(found.begin(), found.end());
+			std::vector<uint32_t> expected;
+			for (uint32_t i = 0; i < boxes.size(); i++) {
+				if (boxes[i].intersects(region)) expected.push_back(i);
+			}
+			ASSERT_EQ(found, expected);
+
+			Point2f p(x, y);
+			found.clear();
+			t.queryPoint(p, [&](auto id) { found.push_back(id); });
+			std::sort(found.begin(), found.end());
+			expected.clear();
+			for (uint32_t i = 0; i < boxes.size(); i++) {
+				if (boxes[i].contains(p)) expected.push_back(i);
+			}
+			ASSERT_EQ(found, expected);
+
+			Vec2f d(dir(gen), dir(gen));
+			found.clear();
+			t.rayQuery(p, d, 100.0f, [&](auto id) { found.push_back(id); });
+			std::sort(found.begin(), found.end());
+			expected.clear();
+			for (uint32_t i = 0; i < boxes.size(); i++) {
+				if (boxes[i].intersectsSegment(p, d, 100.0f)) expected.push_back(i);
+			}
+			ASSERT_EQ(found, expected);
+		}
+	};
+	check(tree);
+
+	//a restored tree answers the same queries
+	auto buffer = tree.serialize();
+	auto restored = PackedHilbertRTree2f::deserialize(buffer);
+	ASSERT_EQ(restored.size(), tree.size());
+	ASSERT_EQ(restored.getBounds(), tree.getBounds());
+	check(restored);
+	ASSERT_EQ(PackedHilbertRTree2f::deserialize(empty.serialize()).size(), 0);
+
+	//truncated and corrupted buffers are rejected
+	ASSERT_THROW(PackedHilbertRTree2f::deserialize(std::span(buffer.data(), buffer.size() - 1)), std::logic_error);
+	ASSERT_THROW(PackedHilbertRTree2f::deserialize(std::span(buffer.data(), 10)), std::logic_error);
+	auto corrupted = buffer;
+	corrupted[0] = std::byte{ 'X' };
+	ASSERT_THROW(PackedHilbertRTree2f::deserialize(corrupted), std::logic_error);
+	corrupted = buffer;
+	corrupted[buffer.size() - 1] = std::byte{ 0x7F };
+	ASSERT_THROW(PackedHilbertRTree2f::deserialize(corrupted), std::logic_error);
+	ASSERT_THROW(PackedHilbertRTree2<double>::deserialize(buffer), std::logic_error);
+}
+
+TEST(RayTest, RayCast) {
+	Rect2f box(0, 0, 4, 4);
+
+	auto hit = Ray2f(Point2f(-5, 2), NormVec2f(1, 0)).cast(box, 10.0f);
+	ASSERT_TRUE(hit);
+	ASSERT_FLOAT_EQ(hit.distance, 5.0f);
+	ASSERT_EQ(hit.point, Point2f(0, 2));
+	ASSERT_EQ(hit.normal, box.getFaceNormal(RectFace::Left));
+
+	hit = Ray2f(Point2f(1, 9), NormVec2f(0, -1)).cast(box, 10.0f);
+	ASSERT_FLOAT_EQ(hit.distance, 5.0f);
+	ASSERT_EQ(hit.normal, box.getFaceNormal(RectFace::Down));
+
+	hit = Ray2f(Point2f(-2, -1), NormVec2f(1, 1)).cast(box, 10.0f);
+	ASSERT_EQ(hit.point, Point2f(0, 1));
+	ASSERT_EQ(hit.normal, box.getFaceNormal(RectFace::Left));
+
+	//misses: too short, pointing away, parallel outside the slab
+	ASSERT_FALSE(Ray2f(Point2f(-5, 2), NormVec2f(1, 0)).cast(box, 4.0f));
+	ASSERT_FALSE(Ray2f(Point2f(-5, 2), NormVec2f(-1, 0)).cast(box, 10.0f));
+	ASSERT_FALSE(Ray2f(Point2f(-5, 5), NormVec2f(1, 0)).cast(box, 10.0f));
+
+	//starting inside hits at distance 0
+	hit = Ray2f(Point2f(1, 1), NormVec2f(0, 1)).cast(box, 10.0f);
+	ASSERT_TRUE(hit);
+	ASSERT_FLOAT_EQ(hit.distance, 0.0f);
+	ASSERT_EQ(hit.normal, NormVec2f(0, -1));
+
+	//convex polygons, either winding, agree with the Rect2 they cover
+	std::mt19937 gen(23);
+	std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	Poly2f cw(box);
+	Poly2f ccw({ Point2f(4, 0), Point2f(4, 4), Point2f(0, 4), Point2f(0, 0) });
+	for (size_t i = 0; i < 200; i++) {
+		float a = angle(gen);
+		Ray2f ray(Point2f(pos(gen), pos(gen)), NormVec2f(std::cos(a), std::sin(a)));
+		auto expected = ray.cast(box, 15.0f);
+		for (const auto* poly : { &cw, &ccw }) {
+			auto polyHit = ray.cast(*poly, 15.0f);
+			ASSERT_EQ(polyHit.hit, expected.hit);
+			if (!expected) continue;
+			ASSERT_NEAR(polyHit.distance, expected.distance, 1e-4f);
+			ASSERT_EQ(polyHit.normal, expected.normal);
+		}
+	}
+
+	Poly2f tri({ Point2f(0, 0), Point2f(4, 0), Point2f(0, 4) });
+	hit = Ray2f(Point2f(4, 4), NormVec2f(-1, -1)).cast(tri, 10.0f);
+	ASSERT_NEAR(hit.distance, std::sqrt(8.0f), 1e-5f);
+	ASSERT_EQ(hit.point, Point2f(2, 2));
+	ASSERT_EQ(hit.normal, NormVec2f(1, 1));
+
+	//the unit types cast the same way, one ray at a time and batched
+	Rect2p pbox(0_px, 0_px, 4_px, 4_px);
+	auto phit = Ray2p(Point2p(-5_px, 2_px), NormVec2p(1_px, 0_px)).cast(pbox, 10_px);
+	ASSERT_TRUE(phit);
+	ASSERT_EQ(phit.distance, 5_px);
+	ASSERT_EQ(phit.point, Point2p(0_px, 2_px));
+	ASSERT_EQ(phit.normal, pbox.getFaceNormal(RectFace::Left));
+	std::vector<Rect2p> pboxes{ pbox, Rect2p(10_px, 0_px, 12_px, 4_px), Rect2p(0_px, 5_px, 4_px, 6_px) };
+	std::vector<RayHit2<Pixels>> phits(pboxes.size());
+	ASSERT_EQ(Ray2p(Point2p(-5_px, 2_px), NormVec2p(1_px, 0_px)).castBatch(std::span<const Rect2p>(pboxes), 20_px, std::span<RayHit2<Pixels>>(phits)), 2);
+	ASSERT_EQ(phits[1].distance, 15_px);
+	ASSERT_FALSE(phits[2]);
+	auto mhit = Ray2m(Point2m(1_mtr, 9_mtr), NormVec2m(0_mtr, -1_mtr)).cast(Rect2m(0_mtr, 0_mtr, 4_mtr, 4_mtr), 10_mtr);
+	ASSERT_EQ(mhit.distance, 5_mtr);
+	ASSERT_EQ(mhit.normal, NormVec2m(0_mtr, 1_mtr));
+}
+
+TEST(RayTest, RayCastBatch) {
+	std::mt19937 gen(29);
+	std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> ext(0.5f, 8.0f);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+	//an odd count exercises the scalar tail after the wide loops
+	std::vector<Rect2f> rects;
+	for (size_t i = 0; i < 1003; i++) {
+		float x = pos(gen);
+		float y = pos(gen);
+		rects.push_back(Rect2f(x, y, x + ext(gen), y + ext(gen)));
+	}
+	std::vector<RayHit2<float>> out(rects.size());
+	ASSERT_THROW(Ray2f().castBatch(rects, 1.0f, std::span(out.data(), 3)), std::out_of_range);
+
+	auto same = [](const RayHit2<float>& a, const RayHit2<float>& b) {
+		ASSERT_EQ(a.hit, b.hit);
+		if (!a) return;
+		ASSERT_EQ(a.distance, b.distance);
+		ASSERT_EQ(a.normal, b.normal);
+	};
+
+	std::vector<Ray2f> rays = { Ray2f(Point2f(0, 0), NormVec2f(1, 0)), Ray2f(Point2f(3, -60), NormVec2f(0, 1)) };
+	for (size_t i = 0; i < 20; i++) {
+		float a = angle(gen);
+		rays.push_back(Ray2f(Point2f(pos(gen), pos(gen)), NormVec2f(std::cos(a), std::sin(a))));
+	}
+	for (const auto& ray : rays) {
+		size_t hits = ray.castBatch(rects, 80.0f, out);
+		size_t expectedHits = 0;
+		for (size_t i = 0; i < rects.size(); i++) {
+			auto expected = ray.cast(rects[i], 80.0f);
+			expectedHits += expected.hit;
+			same(out[i], expected);
+		}
+		ASSERT_EQ(hits, expectedHits);
+	}
+
+	//many rays against one Rect2
+	rays.clear();
+	for (size_t i = 0; i < 1003; i++) {
+		float a = angle(gen);
+		rays.push_back(Ray2f(Point2f(pos(gen), pos(gen)), NormVec2f(std::cos(a), std::sin(a))));
+	}
+	rays.push_back(Ray2f(Point2f(-40, 2), NormVec2f(1, 0)));
+	rays.push_back(Ray2f(Point2f(3, 40), NormVec2f(0, -1)));
+	Rect2f target(-5, -3, 7, 6);
+	out.resize(rays.size());
+	size_t hits = Ray2f::castBatch(rays, target, 60.0f, out);
+	size_t expectedHits = 0;
+	for (size_t i = 0; i < rays.size(); i++) {
+		auto expected = rays[i].cast(target, 60.0f);
+		expectedHits += expected.hit;
+		same(out[i], expected);
+	}
+	ASSERT_EQ(hits, expectedHits);
+	ASSERT_GT(hits, 0);
+}
+
+TEST(HullTest, HullBuild) {
+	//interior points, points along the faces and duplicates are all dropped
+	std::vector<Point2f> points{ Point2f(0, 0), Point2f(4, 0), Point2f(4, 4), Point2f(0, 4),
+		Point2f(2, 2), Point2f(1, 3), Point2f(2, 0), Point2f(4, 1), Point2f(0, 2), Point2f(4, 4), Point2f(3, 1) };
+	std::vector<Point2f> expected{ Point2f(0, 0), Point2f(4, 0), Point2f(4, 4), Point2f(0, 4) };
+
+	Poly2f chain = convexHull(std::span<const Point2f>(points));
+	Poly2f quick = quickHull(std::span<const Point2f>(points));
+	ASSERT_EQ(std::vector<Point2f>(chain.getPoints().begin(), chain.getPoints().end()), expected);
+	ASSERT_EQ(std::vector<Point2f>(quick.getPoints().begin(), quick.getPoints().end()), expected);
+
+	//counter clockwise, so the result passes the convexity check and its normals point out
+	ASSERT_NO_THROW(Poly2f{ expected });
+	ASSERT_EQ(chain.area(), 16);
+	ASSERT_EQ(chain.getFaceNormal(0), NormVec2f(0, -1));
+
+	//degenerate inputs
+	ASSERT_EQ(convexHull(std::span<const Point2f>()).size(), 0);
+	ASSERT_EQ(quickHull(std::span<const Point2f>()).size(), 0);
+	std::vector<Point2f> same{ Point2f(1, 1), Point2f(1, 1), Point2f(1, 1) };
+	ASSERT_EQ(convexHull(std::span<const Point2f>(same)).size(), 1);
+	ASSERT_EQ(quickHull(std::span<const Point2f>(same)).size(), 1);
+	std::vector<Point2f> line{ Point2f(2, 2), Point2f(0, 0), Point2f(3, 3), Point2f(1, 1), Point2f(3, 3) };
+	Poly2f chainLine = convexHull(std::span<const Point2f>(line));
+	Poly2f quickLine = quickHull(std::span<const Point2f>(line));
+	ASSERT_EQ(chainLine.size(), 2);
+	ASSERT_EQ(quickLine.size(), 2);
+	ASSERT_EQ(chainLine[0], Point2f(0, 0));
+	ASSERT_EQ(quickLine[1], Point2f(3, 3));
+
+	Poly2<double> tri = convexHull(std::span<const Point2<double>>(std::vector<Point2<double>>{
+		Point2<double>(0, 0), Point2<double>(0, 3), Point2<double>(3, 0), Point2<double>(1, 1) }));
+	ASSERT_EQ(tri.size(), 3);
+	ASSERT_EQ(tri[1], Point2<double>(3, 0));
+}
+
+TEST(HullTest, HullParallel) {
+	//whole coordinates keep every cross product exact, and the grid makes many collinear points
+	std::mt19937 gen(29);
+	std::uniform_int_distribution<int> pos(-1000, 1000);
+	std::vector<Point2f> points(S2D_HULL_PARALLEL_THRESHOLD * 2 + 17);
+	for (auto& p : points) {
+		p = Point2f((float)pos(gen), (float)pos(gen));
+	}
+
+	Poly2f serial = convexHull(std::span<const Point2f>(points), 1);
+	ASSERT_GE(serial.size(), 3);
+	for (unsigned threads : { 2u, 3u, 0u }) {
+		Poly2f chain = convexHull(std::span<const Point2f>(points), threads);
+		Poly2f quick = quickHull(std::span<const Point2f>(points), threads);
+		ASSERT_EQ(chain.size(), serial.size());
+		ASSERT_EQ(quick.size(), serial.size());
+		for (size_t i = 0; i < serial.size(); i++) {
+			ASSERT_EQ(chain[i], serial[i]);
+			ASSERT_EQ(quick[i], serial[i]);
+		}
+	}
+
+	//every point is inside or on the hull, and every corner turns left
+	const auto& corners = serial.getPoints();
+	for (size_t i = 0; i < corners.size(); i++) {
+		const Point2f& a = corners[i];
+		const Point2f& b = corners[(i + 1) % corners.size()];
+		const Point2f& c = corners[(i + 2) % corners.size()];
+		ASSERT_GT((b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x), 0);
+		for (size_t j = 0; j < points.size(); j += 97) {
+			ASSERT_GE((b.x - a.x) * (points[j].y - a.y) - (b.y - a.y) * (points[j].x - a.x), 0);
+		}
+	}
+}
+
+TEST(HullTest, HullRandomFloat) {
+	//fractional coordinates round every cross product, and ENABLE_AVX2 lets the compiler fuse
+	//them, so QuickHull has to finish without relying on a point being exactly on its own line
+	std::mt19937 gen(31);
+	std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> turn(0.0f, 6.2831853f);
+	for (int round = 0; round < 20; round++) {
+		std::vector<Point2f> points(500);
+		for (auto& p : points) {
+			p = Point2f(pos(gen), pos(gen));
+		}
+		//many corners close to collinear along a circle
+		for (int i = 0; i < 200; i++) {
+			const float a = turn(gen);
+			points.push_back(Point2f(150.0f * std::cos(a), 150.0f * std::sin(a)));
+		}
+
+		Poly2f chain = convexHull(std::span<const Point2f>(points));
+		Poly2f quick = quickHull(std::span<const Point2f>(points));
+		ASSERT_GE(quick.size(), 3);
+		ASSERT_LE(quick.size(), points.size());
+		ASSERT_NEAR(quick.area(), chain.area(), chain.area() * 1e-4f);
+		for (size_t i = 0; i < quick.size(); i++) {
+			const Point2f& a = quick[i];
+			const Point2f& b = quick[(i + 1) % quick.size()];
+			ASSERT_FALSE(a.x == b.x && a.y == b.y) << i;
+		}
+	}
+}
+
+TEST(ClipTest, ClipRect) {
+	Rect2f view(0, 0, 10, 10);
+
+	//Rect built Poly2's wind clockwise and stay that way
+	Poly2f out;
+	ASSERT_TRUE(clip(Poly2f(Rect2f(5, 5, 15, 8)), view, out));
+	ASSERT_EQ(out.area(), 15);
+	ASSERT_EQ(out.getAABB(), Rect2f(5, 5, 10, 8));
+	ASSERT_EQ(out.getFaceNormals(), Poly2f(Rect2f(5, 5, 10, 8)).getFaceNormals());
+
+	Poly2f ccw{ { 2, 2 }, { 4, 2 }, { 3, 4 } };
+	ASSERT_TRUE(clip(ccw, view, out));
+	ASSERT_EQ(out.size(), 3);
+	ASSERT_EQ(out.area(), ccw.area());
+	ASSERT_EQ(out.getAABB(), ccw.getAABB());
+
+	//the view inside a big diamond comes out as the view
+	Poly2f diamond{ { 5, -20 }, { 30, 5 }, { 5, 30 }, { -20, 5 } };
+	ASSERT_TRUE(clip(diamond, view, out));
+	ASSERT_EQ(out.size(), 4);
+	ASSERT_EQ(out.area(), 100);
+
+	//a corner cut off
+	ASSERT_TRUE(clip(Poly2f{ { 8, -1 }, { 12, 3 }, { 8, 3 } }, view, out));
+	ASSERT_EQ(out.getAABB(), Rect2f(8, 0, 10, 3));
+	ASSERT_EQ(out.size(), 5);
+	ASSERT_EQ(out.area(), 5.5f);
+
+	//outside or only touching leaves nothing
+	ASSERT_FALSE(clip(Poly2f(Rect2f(11, 0, 12, 4)), view, out));
+	ASSERT_EQ(out.size(), 0);
+	ASSERT_FALSE(clip(Poly2f(Rect2f(10, 2, 12, 4)), view, out));
+	ASSERT_FALSE(clip(Poly2f{ { 10, 10 }, { 12, 10 }, { 12, 12 } }, view, out));
+	ASSERT_EQ(clip(Poly2f(Rect2f(-5, -5, 5, 5)), view).area(), 25);
+
+	ASSERT_THROW(clip(out, view, out), std::logic_error);
+
+	//refilling reuses the point storage once it has grown
+	std::vector<Point2f> corners;
+	for (size_t i = 0; i < 24; i++) {
+		float angle = 6.2831853f * (float)i / 24.0f;
+		corners.push_back(Point2f(5.0f + 4.0f * std::cos(angle), 5.0f + 4.0f * std::sin(angle)));
+	}
+	Poly2f round(corners);
+	ASSERT_TRUE(clip(round, view, out));
+	ASSERT_EQ(out.size(), 24);
+	const Point2f* storage = out.getPoints().data();
+	ASSERT_TRUE(clip(round + Vec2f(0.5f, 0), view, out));
+	ASSERT_TRUE(clip(round, view, out));
+	ASSERT_EQ(out.getPoints().data(), storage);
+}
+
+TEST(ClipTest, ClipIntersect) {
+	auto areaOf = [](const Poly2f& p) {
+		return p.size() == 0 ? 0.0f : p.area();
+	};
+
+	//overlapping squares, sharing edges, nested, identical and touching
+	Poly2f a(Rect2f(0, 0, 4, 4));
+	ASSERT_EQ(areaOf(intersect(a, Poly2f(Rect2f(2, 2, 6, 6)))), 4);
+	ASSERT_EQ(areaOf(intersect(a, Poly2f(Rect2f(2, 0, 6, 4)))), 8);
+	ASSERT_EQ(areaOf(intersect(a, Poly2f(Rect2f(1, 1, 3, 3)))), 4);
+	ASSERT_EQ(areaOf(intersect(Poly2f(Rect2f(1, 1, 3, 3)), a)), 4);
+	ASSERT_EQ(areaOf(intersect(a, Poly2f(Rect2f(0, 0, 2, 2)))), 4);
+	ASSERT_EQ(areaOf(intersect(a, Poly2f(Rect2f(0, 0, 4, 4)))), 16);
+	ASSERT_EQ(areaOf(intersect(a, Poly2f(Rect2f(4, 0, 6, 4)))), 0);
+	ASSERT_EQ(areaOf(intersect(a, Poly2f(Rect2f(4, 4, 6, 6)))), 0);
+	ASSERT_EQ(areaOf(intersect(a, Poly2f(Rect2f(5, 5, 6, 6)))), 0);
+	ASSERT_EQ(areaOf(intersect(a, Poly2f{ { 2, 0 }, { 4, 2 }, { 2, 4 }, { 0, 2 } })), 8);
+	ASSERT_EQ(areaOf(intersect(a, Poly2f{ { 2, -2 }, { 6, 2 }, { 2, 6 }, { -2, 2 } })), 16);
+
+	//the result is wound like the first input
+	Poly2f ccw{ { 1, 1 }, { 6, 1 }, { 6, 3 }, { 1, 3 } };
+	Poly2f out;
+	ASSERT_TRUE(intersect(ccw, a, out));
+	ASSERT_EQ(out.area(), 6);
+	ASSERT_GT(detail::windingSign(out.getPoints().data(), out.size()), 0);
+	ASSERT_TRUE(intersect(a, ccw, out));
+	ASSERT_LT(detail::windingSign(out.getPoints().data(), out.size()), 0);
+	ASSERT_THROW(intersect(a, out, out), std::logic_error);
+
+	//random convex pairs against clipping one by every face of the other
+	auto halfPlaneClip = [](std::vector<Point2f> subject, const Poly2f& by) {
+		const auto& c = by.getPoints();
+		float sign = detail::windingSign(c.data(), c.size());
+		for (size_t i = 0; i < c.size() && !subject.empty(); i++) {
+			Point2f e0 = c[i];
+			Point2f e1 = c[(i + 1) % c.size()];
+			auto side = [&](const Point2f& p) {
+				return sign * ((e1.x - e0.x) * (p.y - e0.y) - (e1.y - e0.y) * (p.x - e0.x));
+			};
+			std::vector<Point2f> next;
+			for (size_t j = 0; j < subject.size(); j++) {
+				Point2f s = subject[j];
+				Point2f p = subject[(j + 1) % subject.size()];
+				float ds = side(s);
+				float dp = side(p);
+				if ((ds >= 0) != (dp >= 0)) {
+					float t = ds / (ds - dp);
+					next.push_back(Point2f(s.x + t * (p.x - s.x), s.y + t * (p.y - s.y)));
+				}
+				if (dp >= 0) next.push_back(p);
+			}
+			subject = next;
+		}
+		float area = 0;
+		for (size_t i = 2; i < subject.size(); i++) {
+			area += (subject[i - 1].x - subject[0].x) * (subject[i].y - subject[0].y) -
+				(subject[i - 1].y - subject[0].y) * (subject[i].x - subject[0].x);
+		}
+		return std::abs(area) * 0.5f;
+	};
+
+	std::mt19937 gen(37);
+	std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+	std::uniform_int_distribution<int> count(3, 20);
+	auto randomConvex = [&](float cx, float cy) {
+		std::vector<Point2f> points(count(gen));
+		for (auto& p : points) {
+			p = Point2f(cx + pos(gen), cy + pos(gen));
+		}
+		return quickHull(std::span<const Point2f>(points));
+	};
+
+	size_t overlapping = 0;
+	for (size_t i = 0; i < 500; i++) {
+		Poly2f p = randomConvex(0, 0);
+		Poly2f q = randomConvex(pos(gen), pos(gen));
+		if (p.size() < 3 || q.size() < 3) continue;
+		if (i % 2) {
+			std::vector<Point2f> reversed(q.getPoints().begin(), q.getPoints().end());
+			std::reverse(reversed.begin(), reversed.end());
+			q = Poly2f(trustedConvex, reversed);
+		}
+
+		float expected = halfPlaneClip(std::vector<Point2f>(p.getPoints().begin(), p.getPoints().end()), q);
+		bool hit = intersect(p, q, out);
+		ASSERT_NEAR(areaOf(out), expected, 1e-3f * (1.0f + expected)) << i;
+		ASSERT_EQ(hit, out.size() != 0);
+		if (hit) {
+			overlapping++;
+			ASSERT_NO_THROW(Poly2f(std::vector<Point2f>(out.getPoints().begin(), out.getPoints().end())));
+
+			Poly2f clipped;
+			Rect2f box = q.getAABB();
+			clip(p, box, clipped);
+			ASSERT_NEAR(areaOf(clipped), halfPlaneClip(std::vector<Point2f>(p.getPoints().begin(), p.getPoints().end()), Poly2f(box)), 1e-3f * (1.0f + expected));
+		}
+	}
+	ASSERT_GT(overlapping, 100);
+}
+
+TEST(MinkowskiTest, MinkowskiSum) {
+	Poly2f sum = minkowskiSum(Poly2f(Rect2f(0, 0, 1, 1)), Poly2f(Rect2f(0, 0, 2, 2)));
+	ASSERT_EQ(sum.size(), 4);
+	ASSERT_EQ(sum.getAABB(), Rect2f(0, 0, 3, 3));
+	ASSERT_EQ(sum.area(), 9);
+
+	//wound like the first input
+	Poly2f ccw{ { 0, 0 }, { 2, 0 }, { 1, 2 } };
+	Poly2f out;
+	ASSERT_TRUE(minkowskiSum(ccw, Poly2f(Rect2f(-1, -1, 1, 1)), out));
+	ASSERT_GT(detail::windingSign(out.getPoints().data(), out.size()), 0);
+	ASSERT_EQ(out.getAABB(), Rect2f(-1, -1, 3, 3));
+	ASSERT_TRUE(minkowskiSum(Poly2f(Rect2f(-1, -1, 1, 1)), ccw, out));
+	ASSERT_LT(detail::windingSign(out.getPoints().data(), out.size()), 0);
+	ASSERT_THROW(minkowskiSum(out, ccw, out), std::logic_error);
+
+	//a single point translates, a segment sweeps
+	Poly2f point(trustedConvex, { Point2f(5, 5) });
+	ASSERT_TRUE(minkowskiSum(ccw, point, out));
+	ASSERT_EQ(out.area(), ccw.area());
+	ASSERT_EQ(out.getAABB(), Rect2f(5, 5, 7, 7));
+	Poly2f segment(trustedConvex, { Point2f(0, 0), Point2f(3, 0) });
+	ASSERT_TRUE(minkowskiSum(ccw, segment, out));
+	ASSERT_EQ(out.area(), 8);
+
+	//random pairs against the hull of every pairwise sum, whole coordinates keep it exact
+	std::mt19937 gen(41);
+	std::uniform_int_distribution<int> pos(-20, 20);
+	std::uniform_int_distribution<int> count(1, 12);
+	auto randomConvex = [&]() {
+		std::vector<Point2f> points(count(gen));
+		for (auto& p : points) {
+			p = Point2f((float)pos(gen), (float)pos(gen));
+		}
+		return quickHull(std::span<const Point2f>(points));
+	};
+	auto sorted = [](const Poly2f& p) {
+		std::vector<std::pair<float, float>> corners;
+		for (const Point2f& c : p.getPoints()) {
+			corners.push_back({ c.x, c.y });
+		}
+		std::sort(corners.begin(), corners.end());
+		return corners;
+	};
+
+	for (size_t i = 0; i < 300; i++) {
+		Poly2f a = randomConvex();
+		Poly2f b = randomConvex();
+		if (i % 2 && a.size() > 2) {
+			std::vector<Point2f> reversed(a.getPoints().begin(), a.getPoints().end());
+			std::reverse(reversed.begin(), reversed.end());
+			a = Poly2f(trustedConvex, reversed);
+		}
+
+		std::vector<Point2f> sums;
+		for (const Point2f& p : a.getPoints()) {
+			for (const Point2f& q : b.getPoints()) {
+				sums.push_back(Point2f(p.x + q.x, p.y + q.y));
+			}
+		}
+		Poly2f expected = quickHull(std::span<const Point2f>(sums));
+		minkowskiSum(a, b, out);
+		if (expected.size() < 3) {
+			ASSERT_EQ(out.size(), 0);
+			continue;
+		}
+		ASSERT_EQ(sorted(out), sorted(expected)) << a << b;
+	}
+}
+
+TEST(MinkowskiTest, Inflate) {
+	//mitred corners keep a Rect2 a Rect2, and keep its winding
+	Poly2f out;
+	ASSERT_TRUE(inflate(Poly2f(Rect2f(0, 0, 2, 2)), 1.0f, out));
+	ASSERT_EQ(out.size(), 4);
+	ASSERT_EQ(out.getAABB(), Rect2f(-1, -1, 3, 3));
+	ASSERT_EQ(out.area(), 16);
+	ASSERT_LT(detail::windingSign(out.getPoints().data(), out.size()), 0);
+	ASSERT_THROW(inflate(out, 1.0f, out), std::logic_error);
+	ASSERT_THROW(inflate(Poly2f(Rect2f(0, 0, 2, 2)), -1.0f, out), std::logic_error);
+
+	//every face of the result lies at least the distance out from every corner, and touches
+	auto checkOffset = [](const Poly2f& poly, const Poly2f& inflated, const float distance) {
+		const auto& faces = inflated.getPoints();
+		float sign = detail::windingSign(faces.data(), faces.size());
+		for (size_t i = 0; i < faces.size(); i++) {
+			Vec2f face = inflated.getFaceVec(i);
+			float length = std::sqrt(face.x * face.x + face.y * face.y);
+			float nearest = std::numeric_limits<float>::max();
+			for (const Point2f& c : poly.getPoints()) {
+				float inside = sign * (face.x * (c.y - faces[i].y) - face.y * (c.x - faces[i].x)) / length;
+				nearest = std::min(nearest, inside);
+			}
+			ASSERT_GE(nearest, distance - 1e-3f);
+			ASSERT_LE(nearest, distance * 1.415f);
+		}
+	};
+
+	Poly2f tri{ { 0, 0 }, { 4, 0 }, { 0, 3 } };
+	Poly2f sharp = inflate(tri, 1.0f);
+	checkOffset(tri, sharp, 1.0f);
+	//the two corners sharper than a right angle get an extra face each
+	ASSERT_EQ(sharp.size(), 5);
+
+	Poly2f round = inflate(tri, 1.0f, 32);
+	checkOffset(tri, round, 1.0f);
+	ASSERT_GT(round.size(), 32);
+	ASSERT_GT(round.area(), tri.area() + 12.0f + 3.14159f);
+	ASSERT_LT(round.area(), sharp.area());
+
+	//a point becomes a square or a round, a segment a capsule
+	Poly2f point(trustedConvex, { Point2f(1, 1) });
+	ASSERT_EQ(inflate(point, 2.0f).getAABB(), Rect2f(-1, -1, 3, 3));
+	ASSERT_EQ(inflate(point, 2.0f, 64).size(), 64);
+	Poly2f capsule = inflate(Poly2f(trustedConvex, { Point2f(0, 0), Point2f(4, 0) }), 1.0f, 16);
+	ASSERT_EQ(capsule.size(), 16);
+	ASSERT_NEAR(capsule.area(), 8.0f + 3.14159f, 0.2f);
+}
+
+TEST(MinkowskiTest, InflateBatch) {
+	std::mt19937 gen(43);
+	std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+	std::vector<Poly2f> obstacles;
+	for (size_t i = 0; i < S2D_INFLATE_PARALLEL_THRESHOLD * 2 + 5; i++) {
+		Point2f c(pos(gen), pos(gen));
+		obstacles.push_back(Poly2f(Rect2f(c.x, c.y, c.x + 1.0f + (float)(i % 7), c.y + 2.0f)));
+	}
+
+	std::vector<Poly2f> serial(obstacles.size());
+	std::vector<Poly2f> parallel(obstacles.size());
+	inflateBatch(std::span<const Poly2f>(obstacles), 0.5f, std::span<Poly2f>(serial), 8, 1);
+	inflateBatch(std::span<const Poly2f>(obstacles), 0.5f, std::span<Poly2f>(parallel), 8, 4);
+	for (size_t i = 0; i < obstacles.size(); i++) {
+		ASSERT_EQ(serial[i], parallel[i]);
+		ASSERT_EQ(serial[i], inflate(obstacles[i], 0.5f, 8));
+	}
+	ASSERT_EQ(serial[3].size(), 8);
+
+	ASSERT_THROW(inflateBatch(std::span<const Poly2f>(obstacles), 0.5f, std::span<Poly2f>(serial.data(), 3)), std::out_of_range);
+	ASSERT_THROW(inflateBatch(std::span<const Poly2f>(obstacles.data(), 4), 0.5f, std::span<Poly2f>(obstacles.data() + 2, 4)), std::logic_error);
+}
+
+namespace {
+	//a star shaped outline with random radii, counter clockwise
+	std::vector<Point2f> starOutline(std::mt19937& gen, const size_t count) {
+		std::uniform_real_distribution<float> radius(0.3f, 1.0f);
+		std::vector<Point2f> points;
+		for (size_t i = 0; i < count; i++) {
+			float angle = 6.2831853f * (float)i / (float)count;
+			float r = 100.0f * radius(gen);
+			points.push_back(Point2f(r * std::cos(angle), r * std::sin(angle)));
+		}
+		return points;
+	}
+
+	//a base with teeth count teeth standing on it, counter clockwise, every notch a merge vertex
+	std::vector<Point2f> combOutline(const int teeth) {
+		std::vector<Point2f> points{ Point2f(0, 0), Point2f((float)(2 * teeth), 0) };
+		for (int t = teeth; t > 0; t--) {
+			points.push_back(Point2f((float)(2 * t), 3));
+			points.push_back(Point2f((float)(2 * t - 1), 3));
+			points.push_back(Point2f((float)(2 * t - 1), 1));
+			points.push_back(Point2f((float)(2 * t - 2), 1));
+		}
+		return points;
+	}
+
+	bool outlineContains(const std::vector<Point2f>& outline, const float x, const float y) {
+		bool inside = false;
+		for (size_t i = 0, j = outline.size() - 1; i < outline.size(); j = i++) {
+			const Point2f& a = outline[i];
+			const Point2f& b = outline[j];
+			if ((a.y > y) != (b.y > y) && x < (b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x) inside = !inside;
+		}
+		return inside;
+	}
+
+	//n - 2 triangles wound like the outline, inside it, adding up to its area, cannot overlap
+	void checkTriangulation(const SimplePoly2f& poly, const std::vector<SimplePoly2f::Triangle>& triangles) {
+		const auto& p = poly.getPoints();
+		ASSERT_EQ(triangles.size(), p.size() - 2);
+		double sum = 0.0;
+		for (const auto& t : triangles) {
+			const Point2f& a = p[t[0]];
+			const Point2f& b = p[t[1]];
+			const Point2f& c = p[t[2]];
+			double twice = ((double)b.x - a.x) * ((double)c.y - a.y) - ((double)b.y - a.y) * ((double)c.x - a.x);
+			if (poly.isClockwise()) twice = -twice;
+			ASSERT_GE(twice, 0.0);
+			if (twice > 1e-3) {
+				ASSERT_TRUE(outlineContains(p, (a.x + b.x + c.x) / 3.0f, (a.y + b.y + c.y) / 3.0f));
+			}
+			sum += twice * 0.5;
+		}
+		ASSERT_NEAR(sum, (double)poly.area(), 1e-4 * (double)poly.area());
+	}
+}
+
+TEST(SimplePolyTest, Triangulate) {
+	ASSERT_THROW(SimplePoly2f({ Point2f(0, 0), Point2f(1, 0) }), std::length_error);
+
+	SimplePoly2f ell{ Point2f(0, 0), Point2f(2, 0), Point2f(2, 1), Point2f(1, 1), Point2f(1, 2), Point2f(0, 2) };
+	ASSERT_EQ(ell.area(), 3);
+	ASSERT_FALSE(ell.isClockwise());
+	checkTriangulation(ell, ell.triangulate());
+
+	SimplePoly2f::Scratch scratch;
+	std::vector<SimplePoly2f::Triangle> triangles;
+	std::mt19937 gen(44);
+	for (size_t i = 0; i < 20; i++) {
+		SimplePoly2f star(starOutline(gen, 10 + i * 37));
+		star.triangulate(triangles, scratch);
+		checkTriangulation(star, triangles);
+		star.triangulateEarClipping(triangles, scratch);
+		checkTriangulation(star, triangles);
+	}
+
+	//level runs of vertices, both ways up, and clockwise outlines wound clockwise
+	std::vector<Point2f> comb = combOutline(25);
+	SimplePoly2f up(comb);
+	ASSERT_EQ(up.area(), 100);
+	up.triangulate(triangles, scratch);
+	checkTriangulation(up, triangles);
+	for (auto& p : comb) p.y = -p.y;
+	SimplePoly2f down(comb);
+	ASSERT_TRUE(down.isClockwise());
+	down.triangulate(triangles, scratch);
+	checkTriangulation(down, triangles);
+	std::reverse(comb.begin(), comb.end());
+	SimplePoly2f downCCW(comb);
+	downCCW.triangulate(triangles, scratch);
+	checkTriangulation(downCCW, triangles);
+
+	//a square spiral, every corner of the inner wall a reflex one
+	std::vector<Point2f> spiral;
+	for (int i = 0; i < 12; i++) {
+		float r = 2.0f + (float)i;
+		spiral.push_back(Point2f(i % 4 < 2 ? r : -r, (i + 1) % 4 < 2 ? r : -r));
+	}
+	for (int i = 11; i >= 0; i--) {
+		float r = 2.5f + (float)i;
+		spiral.push_back(Point2f(i % 4 < 2 ? r : -r, (i + 1) % 4 < 2 ? r : -r));
+	}
+	SimplePoly2f coil(spiral);
+	coil.triangulate(triangles, scratch);
+	checkTriangulation(coil, triangles);
+
+	//repeated and collinear points still give n - 2 triangles
+	SimplePoly2f repeats{ Point2f(0, 0), Point2f(1, 0), Point2f(2, 0), Point2f(2, 0), Point2f(2, 2), Point2f(1, 1), Point2f(0, 2) };
+	repeats.triangulate(triangles, scratch);
+	checkTriangulation(repeats, triangles);
+}
+
+TEST(SimplePolyTest, Decompose) {
+	auto checkPieces = [](const SimplePoly2f& poly, const std::vector<Poly2f>& pieces) {
+		float sum = 0.0f;
+		for (const Poly2f& piece : pieces) {
+			std::vector<Point2f> corners(piece.getPoints().begin(), piece.getPoints().end());
+			ASSERT_NO_THROW(Poly2f{ corners });
+			ASSERT_EQ(detail::windingSign(corners.data(), corners.size()) < 0, poly.isClockwise());
+			sum += piece.area();
+		}
+		ASSERT_NEAR(sum, poly.area(), 1e-4f * poly.area());
+	};
+
+	SimplePoly2f ell{ Point2f(0, 0), Point2f(2, 0), Point2f(2, 1), Point2f(1, 1), Point2f(1, 2), Point2f(0, 2) };
+	std::vector<Poly2f> pieces = ell.decompose();
+	checkPieces(ell, pieces);
+	ASSERT_EQ(pieces.size(), 2);
+
+	SimplePoly2f square{ Point2f(0, 0), Point2f(0, 1), Point2f(1, 1), Point2f(1, 0) };
+	pieces = square.decompose();
+	ASSERT_EQ(pieces.size(), 1);
+	ASSERT_EQ(pieces[0].area(), 1);
+
+	//each tooth needs its own piece, and the base at most one more per tooth
+	SimplePoly2f::Scratch scratch;
+	SimplePoly2f comb(combOutline(25));
+	comb.decompose(pieces, scratch);
+	checkPieces(comb, pieces);
+	ASSERT_GE(pieces.size(), 26);
+	ASSERT_LE(pieces.size(), 51);
+
+	std::mt19937 gen(45);
+	std::vector<SimplePoly2f::Triangle> triangles;
+	for (size_t i = 0; i < 10; i++) {
+		std::vector<Point2f> outline = starOutline(gen, 20 + i * 50);
+		if (i % 2) std::reverse(outline.begin(), outline.end());
+		SimplePoly2f star(outline);
+		star.decompose(pieces, scratch);
+		checkPieces(star, pieces);
+		star.triangulate(triangles, scratch);
+		ASSERT_LT(pieces.size(), triangles.size());
+	}
+}
+
+namespace {
+
+	//every backend within its bound of the true values, as a whole array and one angle at a time
+	template<TrigPrecision P>
+	void checkTrig(const std::vector<Radians>& angles) {
+		std::vector<float> sines(angles.size());
+		std::vector<float> cosines(angles.size());
+		sincos<P>(std::span<const Radians>(angles), sines, cosines);
+
+		const double bound = trigMaxError<P> + 6e-8;
+		for (size_t i = 0; i < angles.size(); i++) {
+			const double a = angles[i].get();
+			const SinCos sc = sincos<P>(angles[i]);
+			ASSERT_NEAR(sc.sin, std::sin(a), bound) << a;
+			ASSERT_NEAR(sc.cos, std::cos(a), bound) << a;
+			ASSERT_EQ(sc.sin, sin<P>(angles[i]));
+			ASSERT_EQ(sc.cos, cos<P>(angles[i]));
+			ASSERT_NEAR(sines[i], sc.sin, 1e-7) << a;
+			ASSERT_NEAR(cosines[i], sc.cos, 1e-7) << a;
+		}
+	}
+}
+
+TEST(TrigTest, TrigPrecision) {
+	//quarter turns, their halves, the reduction limit and past it, at an odd count for the scalar tail
+	std::vector<Radians> angles;
+	for (int i = -16; i <= 16; i++) {
+		angles.push_back(Radians(0.7853981633974483 * i));
+	}
+	angles.push_back(Radians(8192.0f));
+	angles.push_back(Radians(-8192.5f));
+	angles.push_back(Radians(100000.0f));
+	std::mt19937 gen(43);
+	std::uniform_real_distribution<float> small(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> large(-8192.0f, 8192.0f);
+	for (int i = 0; i < 2000; i++) {
+		angles.push_back(Radians(i % 2 ? small(gen) : large(gen)));
+	}
+	ASSERT_EQ(angles.size() % 8, 4);
+
+	checkTrig<TrigPrecision::exact>(angles);
+	checkTrig<TrigPrecision::polynomial>(angles);
+	checkTrig<TrigPrecision::table>(angles);
+
+	//exact is the standard library, S2D_TRIG_PRECISION picks the backend when none is asked for
+	ASSERT_EQ(sin<TrigPrecision::exact>(Radians(1.0f)), std::sin(1.0f));
+	auto [s, c] = sincos(Radians(0.5f));
+	ASSERT_EQ(s, sincos<defaultTrigPrecision>(Radians(0.5f)).sin);
+	ASSERT_EQ(c, sincos<defaultTrigPrecision>(Radians(0.5f)).cos);
+
+	//NaN stays NaN in every lane it lands in
+	std::vector<Radians> nan(9, Radians(1.0f));
+	nan[3] = Radians(std::numeric_limits<float>::quiet_NaN());
+	std::vector<float> sines(9), cosines(9);
+	sincos<TrigPrecision::polynomial>(std::span<const Radians>(nan), sines, cosines);
+	ASSERT_TRUE(std::isnan(sines[3]) && std::isnan(cosines[3]));
+	ASSERT_NEAR(sines[2], std::sin(1.0), 2e-7);
+
+	std::vector<float> tooShort(8);
+	ASSERT_THROW(sincos(std::span<const Radians>(nan), tooShort, cosines), std::out_of_range);
+}
+
+TEST(RotTest, RotConvert) {
+	Rot2f r1;
+	ASSERT_EQ(r1.cos, 1);
+	ASSERT_EQ(r1.sin, 0);
+
+	Rot2f r2(90_deg);
+	ASSERT_NEAR(r2.cos, 0, 1e-6);
+	ASSERT_NEAR(r2.sin, 1, 1e-6);
+	ASSERT_EQ(Rot2f(25_pcent), r2);
+	ASSERT_EQ(Rot2f(Radians(1.5707963267948966)), r2);
+	ASSERT_EQ(Rot2f(NormVec2f(0, 1)), r2);
+
+	//back to any angle unit, in (-pi, pi]
+	ASSERT_NEAR(r2.angle().get(), 1.5707963f, 1e-6);
+	ASSERT_NEAR(((Degrees)r2).get(), 90.0f, 1e-4);
+	ASSERT_NEAR(((Percent)r2).get(), 0.25f, 1e-6);
+	ASSERT_NEAR(((Degrees)Rot2f(270_deg)).get(), -90.0f, 1e-4);
+
+	ASSERT_EQ(r2.toNormVec2(), NormVec2f(0, 1));
+	Mat3f m;
+	m.rotate(30_deg);
+	ASSERT_EQ(Rot2f(30_deg).toMat3(), m);
+
+	ASSERT_EQ(Rot2f::between(NormVec2f(1, 0), NormVec2f(0, 1)), r2);
+	ASSERT_EQ(Rot2f::between(NormVec2f(1, 1), NormVec2f(-1, 1)), r2);
+}
+
+TEST(RotTest, RotCompose) {
+	Rot2f a(30_deg);
+	Rot2f b(45_deg);
+	ASSERT_EQ(a * b, Rot2f(75_deg));
+	ASSERT_EQ(b * a, Rot2f(75_deg));
+	ASSERT_EQ(a * a.inverse(), Rot2f());
+	a *= b;
+	ASSERT_EQ(a, Rot2f(75_deg));
+
+	//rotating points and vectors matches the matrix, around the origin and around a center
+	Rot2f r(60_deg);
+	Mat3f m;
+	m.rotate(60_deg);
+	Mat3f mc;
+	mc.rotate(60_deg, Point2f(4, -3));
+	ASSERT_EQ(r.rotate(Vec2f(2, 5)), m.transform(Vec2f(2, 5)));
+	//the round trip scales by cos^2 + sin^2, within twice the backend's error of 1 plus rounding
+	const Vec2f back = r.unrotate(r.rotate(Vec2f(2, 5)));
+	ASSERT_NEAR(back.x, 2.0f, (2.0f * trigMaxError<defaultTrigPrecision> + 1e-6f) * 2.0f);
+	ASSERT_NEAR(back.y, 5.0f, (2.0f * trigMaxError<defaultTrigPrecision> + 1e-6f) * 5.0f);
+	ASSERT_EQ(r.rotate(Point2f(2, 5)), m.transform(Point2f(2, 5)));
+	ASSERT_EQ(r.rotate(Point2f(2, 5), Point2f(4, -3)), mc.transform(Point2f(2, 5)));
+	ASSERT_EQ(r.rotate(NormVec2f(1, 0)), NormVec2f(60_deg));
+
+	Mat3f pre;
+	pre.translate(Vec2f(1, 2)).prerotate(r, Point2f(4, -3));
+	Mat3f preRad;
+	preRad.translate(Vec2f(1, 2)).prerotate(60_deg, Point2f(4, -3));
+	ASSERT_EQ(pre, preRad);
+	Affine2f af;
+	af.rotate(r, Point2f(4, -3));
+	ASSERT_EQ(af.transform(Point2f(2, 5)), mc.transform(Point2f(2, 5)));
+
+	//the unit types rotate the same way
+	Rot2p rp(60_deg);
+	ASSERT_EQ(rp.rotate(Vec2p(Pixels(2.0), Pixels(5.0))), (Vec2p)r.rotate(Vec2f(2, 5)));
+}
+
+TEST(RotTest, RotPoly) {
+	//Poly2::rotate used to discard its result
+	Poly2f p(Rect2f(0, 0, 2, 1));
+	Poly2f q = p;
+	q.rotate(90_deg);
+	ASSERT_EQ(q.getAABB(), Rect2f(-1, 0, 0, 2));
+
+	Mat3f m;
+	m.rotate(30_deg, Point2f(1, 1));
+	Poly2f expected = m.transform(p);
+
+	//the cached values turn with the points, and match those computed from scratch
+	Poly2f cached = p;
+	cached.area();
+	cached.centroid();
+	cached.getFaceNormals();
+	cached.getAABB();
+	cached.rotate(Rot2f(30_deg), Point2f(1, 1));
+	Poly2f fresh(expected.getPoints());
+	ASSERT_EQ(cached, expected);
+	ASSERT_NEAR(cached.area(), fresh.area(), 1e-5);
+	ASSERT_EQ(cached.centroid(), fresh.centroid());
+	ASSERT_EQ(cached.getAABB(), fresh.getAABB());
+	for (size_t i = 0; i < cached.size(); i++) {
+		ASSERT_EQ(cached.getFaceNormal(i), fresh.getFaceNormal(i));
+	}
+	ASSERT_EQ(Rot2f(30_deg).rotate(p, Point2f(1, 1)), expected);
+	ASSERT_EQ(p, Poly2f(Rect2f(0, 0, 2, 1)));
+}
+
+TEST(RotTest, RotInterpolate) {
+	//600 ticks of 1 / 60 s at 1 radian per second, 10 seconds and 10 radians in all, short by angle^3 / 12 each tick
+	Rot2f r;
+	const float step = 1.0f / 60.0f;
+	for (int i = 0; i < 600; i++) {
+		r.integrate(step);
+	}
+	ASSERT_NEAR(std::sqrt(r.cos * r.cos + r.sin * r.sin), 1.0f, 1e-6);
+	ASSERT_NEAR(r.angle().get(), 10.0f - 600 * step * step * step / 12.0f - 4.0f * 3.14159265f, 1e-4);
+	r.renormalize();
+	ASSERT_NEAR(r.cos * r.cos + r.sin * r.sin, 1.0f, 1e-6);
+
+	Rot2f a(10_deg);
+	Rot2f b(100_deg);
+	ASSERT_EQ(slerp(a, b, 0.0f), a);
+	ASSERT_EQ(slerp(a, b, 1.0f), b);
+	ASSERT_EQ(slerp(a, b, 0.25f), Rot2f(32.5_deg));
+	ASSERT_EQ(nlerp(a, b, 0.5f), Rot2f(55_deg));
+	//nlerp follows the chord, a quarter of the way along it is atan(1 / 3) past a
+	ASSERT_NEAR(((Degrees)nlerp(a, b, 0.25f)).get(), 10.0f + std::atan(1.0f / 3.0f) * 180.0f / 3.14159265f, 1e-3);
+
+	//the short way round, across the half turn
+	ASSERT_EQ(slerp(Rot2f(170_deg), Rot2f(-170_deg), 0.5f), Rot2f(180_deg));
+	ASSERT_EQ(nlerp(Rot2f(170_deg), Rot2f(-170_deg), 0.5f), Rot2f(180_deg));
+}